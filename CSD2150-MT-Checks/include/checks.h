@@ -0,0 +1,49 @@
+/*!*****************************************************************************
+ * @file    checks.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the console checks of the pieces of
+ *          CSD2150-MT whose results can be compared against a known answer
+ *          without a window.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef CHECKS_HELPER_HEADER
+#define CHECKS_HELPER_HEADER
+
+#include <cstdio>
+#include <string_view>
+
+using namespace std::string_view_literals;	// for literal operator sv
+
+namespace MTU
+{
+  namespace Checks
+  {
+    // returned instead of a failure count when a check can't run here
+    inline constexpr int s_Skipped{ -1 };
+
+    /// @brief prints what was expected if it didn't hold
+    /// @return 1 if the expectation failed, to be summed
+    inline int expect(bool bCondition, std::string_view const& what)
+    {
+      if (false == bCondition)printf_s("  FAILED: %.*s\n", static_cast<int>(what.size()), what.data());
+      return bCondition ? 0 : 1;
+    }
+
+    /// @brief draws an occluder quad into an occlusionBuffer and tests boxes
+    ///        behind, across the edge of and in front of it
+    /// @return the number of failed expectations
+    int checkOcclusionBuffer();
+
+    /// @brief dispatches shaderCull.comp over a synthetic crowd on its own
+    ///        device and compares the draws with MTU::cullObjects, in both
+    ///        the one slot per object and the compact modes
+    /// @return the number of failed expectations, s_Skipped if there is no
+    ///         device
+    int checkGPUCuller();
+  }
+}
+
+#endif//CHECKS_HELPER_HEADER
@@ -0,0 +1,548 @@
+/*!*****************************************************************************
+ * @file    cullCheck.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the check of shaderCull.comp against
+ *          MTU::cullObjects. It makes its own headless device, so it runs
+ *          without a window on any driver with a compute queue.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <vector>
+#include <random>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <checks.h>
+#include <vulkan/vulkan.h>
+#include <vulkanHelpers/vulkanGPUCuller.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace MTU
+{
+  namespace Helper
+  {
+    static constexpr uint32_t s_CheckObjects { 4096 };
+    static constexpr uint32_t s_CommandWords { sizeof(VkDrawIndexedIndirectCommand) / sizeof(uint32_t) };
+    static constexpr float    s_CheckSlack   { 1.0e-3f };// the same bracket vulkanGPUCuller::verify uses
+
+    // the layouts vulkanGPUCuller fills shaderCull.comp's push constants and View block with
+    using cullConstants = vulkanGPUCuller::cullConstants;
+    using cullView      = vulkanGPUCuller::cullView;
+
+    struct checkBuffer
+    {
+      VkBuffer        m_Buffer{ VK_NULL_HANDLE };
+      VkDeviceMemory  m_Memory{ VK_NULL_HANDLE };
+      void*           m_pMapped{ nullptr };
+    };
+
+    // everything one run of the check owns, destroyed in reverse
+    struct cullContext
+    {
+      VkInstance            m_Instance      { VK_NULL_HANDLE };
+      VkPhysicalDevice      m_PhysicalDevice{ VK_NULL_HANDLE };
+      VkDevice              m_Device        { VK_NULL_HANDLE };
+      VkQueue               m_Queue         { VK_NULL_HANDLE };
+      uint32_t              m_QueueFamily   { 0 };
+      checkBuffer           m_Objects       {};
+      checkBuffer           m_Indirect      {};
+      checkBuffer           m_View          {};
+      VkImage               m_HiZ           { VK_NULL_HANDLE };// 1x1, occlusion stays off
+      VkDeviceMemory        m_HiZMemory     { VK_NULL_HANDLE };
+      VkImageView           m_HiZView       { VK_NULL_HANDLE };
+      VkSampler             m_Sampler       { VK_NULL_HANDLE };
+      VkShaderModule        m_Shader        { VK_NULL_HANDLE };
+      VkDescriptorSetLayout m_SetLayout     { VK_NULL_HANDLE };
+      VkPipelineLayout      m_PipelineLayout{ VK_NULL_HANDLE };
+      VkPipeline            m_Pipeline      { VK_NULL_HANDLE };
+      VkDescriptorPool      m_DescriptorPool{ VK_NULL_HANDLE };
+      VkDescriptorSet       m_Set           { VK_NULL_HANDLE };
+      VkCommandPool         m_CommandPool   { VK_NULL_HANDLE };
+      VkFence               m_Fence         { VK_NULL_HANDLE };
+
+      ~cullContext()
+      {
+        if (m_Device != VK_NULL_HANDLE)
+        {
+          vkDeviceWaitIdle(m_Device);
+          vkDestroyFence(m_Device, m_Fence, nullptr);
+          vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+          vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
+          vkDestroyPipeline(m_Device, m_Pipeline, nullptr);
+          vkDestroyPipelineLayout(m_Device, m_PipelineLayout, nullptr);
+          vkDestroyDescriptorSetLayout(m_Device, m_SetLayout, nullptr);
+          vkDestroyShaderModule(m_Device, m_Shader, nullptr);
+          vkDestroySampler(m_Device, m_Sampler, nullptr);
+          vkDestroyImageView(m_Device, m_HiZView, nullptr);
+          vkDestroyImage(m_Device, m_HiZ, nullptr);
+          vkFreeMemory(m_Device, m_HiZMemory, nullptr);
+          for (checkBuffer* x : { &m_Objects, &m_Indirect, &m_View })
+          {
+            vkDestroyBuffer(m_Device, x->m_Buffer, nullptr);
+            vkFreeMemory(m_Device, x->m_Memory, nullptr);// unmaps
+          }
+          vkDestroyDevice(m_Device, nullptr);
+        }
+        if (m_Instance != VK_NULL_HANDLE)vkDestroyInstance(m_Instance, nullptr);
+      }
+    };
+
+    static uint32_t findMemoryType(cullContext const& Context, uint32_t typeBits, VkMemoryPropertyFlags flags) noexcept
+    {
+      VkPhysicalDeviceMemoryProperties properties;
+      vkGetPhysicalDeviceMemoryProperties(Context.m_PhysicalDevice, &properties);
+      for (uint32_t i{ 0 }; i < properties.memoryTypeCount; ++i)
+      {
+        if ((typeBits & (1u << i)) && (properties.memoryTypes[i].propertyFlags & flags) == flags)return i;
+      }
+      return UINT32_MAX;
+    }
+
+    /// @brief picks the first device with a compute queue
+    /// @return false if there is no Vulkan 1.2 device to run on
+    static bool createDevice(cullContext& Context)
+    {
+      VkApplicationInfo appInfo
+      {
+        .sType            { VK_STRUCTURE_TYPE_APPLICATION_INFO },
+        .pApplicationName { "CSD2150-MT-Checks" },
+        .apiVersion       { VK_API_VERSION_1_2 }
+      };
+      VkInstanceCreateInfo instanceInfo
+      {
+        .sType            { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO },
+        .pApplicationInfo { &appInfo }
+      };
+      if (VK_SUCCESS != vkCreateInstance(&instanceInfo, nullptr, &Context.m_Instance))return false;
+
+      uint32_t deviceCount{ 0 };
+      vkEnumeratePhysicalDevices(Context.m_Instance, &deviceCount, nullptr);
+      std::vector<VkPhysicalDevice> devices(deviceCount);
+      vkEnumeratePhysicalDevices(Context.m_Instance, &deviceCount, devices.data());
+      for (VkPhysicalDevice x : devices)
+      {
+        uint32_t familyCount{ 0 };
+        vkGetPhysicalDeviceQueueFamilyProperties(x, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(x, &familyCount, families.data());
+        for (uint32_t i{ 0 }; i < familyCount; ++i)
+        {
+          if (families[i].queueFlags & VK_QUEUE_COMPUTE_BIT)
+          {
+            Context.m_PhysicalDevice = x;
+            Context.m_QueueFamily = i;
+            break;
+          }
+        }
+        if (Context.m_PhysicalDevice != VK_NULL_HANDLE)break;
+      }
+      if (Context.m_PhysicalDevice == VK_NULL_HANDLE)return false;
+
+      float priority{ 1.0f };
+      VkDeviceQueueCreateInfo queueInfo
+      {
+        .sType            { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO },
+        .queueFamilyIndex { Context.m_QueueFamily },
+        .queueCount       { 1 },
+        .pQueuePriorities { &priority }
+      };
+      VkDeviceCreateInfo deviceInfo
+      {
+        .sType                { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO },
+        .queueCreateInfoCount { 1 },
+        .pQueueCreateInfos    { &queueInfo }
+      };
+      if (VK_SUCCESS != vkCreateDevice(Context.m_PhysicalDevice, &deviceInfo, nullptr, &Context.m_Device))return false;
+      vkGetDeviceQueue(Context.m_Device, Context.m_QueueFamily, 0, &Context.m_Queue);
+      return true;
+    }
+
+    static bool createBuffer(cullContext const& Context, checkBuffer& outBuffer, VkDeviceSize size, VkBufferUsageFlags usage)
+    {
+      VkBufferCreateInfo bufferInfo
+      {
+        .sType      { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO },
+        .size       { size },
+        .usage      { usage },
+        .sharingMode{ VK_SHARING_MODE_EXCLUSIVE }
+      };
+      if (VK_SUCCESS != vkCreateBuffer(Context.m_Device, &bufferInfo, nullptr, &outBuffer.m_Buffer))return false;
+
+      VkMemoryRequirements requirements;
+      vkGetBufferMemoryRequirements(Context.m_Device, outBuffer.m_Buffer, &requirements);
+      VkMemoryAllocateInfo allocInfo
+      {
+        .sType          { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO },
+        .allocationSize { requirements.size },
+        .memoryTypeIndex{ findMemoryType(Context, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) }
+      };
+      return allocInfo.memoryTypeIndex != UINT32_MAX
+        && VK_SUCCESS == vkAllocateMemory(Context.m_Device, &allocInfo, nullptr, &outBuffer.m_Memory)
+        && VK_SUCCESS == vkBindBufferMemory(Context.m_Device, outBuffer.m_Buffer, outBuffer.m_Memory, 0)
+        && VK_SUCCESS == vkMapMemory(Context.m_Device, outBuffer.m_Memory, 0, VK_WHOLE_SIZE, 0, &outBuffer.m_pMapped);
+    }
+
+    // the shader always binds a pyramid, u_HiZInfo.w = 0 keeps it unread
+    static bool createDummyHiZ(cullContext& Context)
+    {
+      VkImageCreateInfo imageInfo
+      {
+        .sType        { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO },
+        .imageType    { VK_IMAGE_TYPE_2D },
+        .format       { VK_FORMAT_R32_SFLOAT },
+        .extent       { 1, 1, 1 },
+        .mipLevels    { 1 },
+        .arrayLayers  { 1 },
+        .samples      { VK_SAMPLE_COUNT_1_BIT },
+        .tiling       { VK_IMAGE_TILING_OPTIMAL },
+        .usage        { VK_IMAGE_USAGE_SAMPLED_BIT },
+        .sharingMode  { VK_SHARING_MODE_EXCLUSIVE },
+        .initialLayout{ VK_IMAGE_LAYOUT_UNDEFINED }
+      };
+      if (VK_SUCCESS != vkCreateImage(Context.m_Device, &imageInfo, nullptr, &Context.m_HiZ))return false;
+
+      VkMemoryRequirements requirements;
+      vkGetImageMemoryRequirements(Context.m_Device, Context.m_HiZ, &requirements);
+      VkMemoryAllocateInfo allocInfo
+      {
+        .sType          { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO },
+        .allocationSize { requirements.size },
+        .memoryTypeIndex{ findMemoryType(Context, requirements.memoryTypeBits, 0) }
+      };
+      if (allocInfo.memoryTypeIndex == UINT32_MAX
+        || VK_SUCCESS != vkAllocateMemory(Context.m_Device, &allocInfo, nullptr, &Context.m_HiZMemory)
+        || VK_SUCCESS != vkBindImageMemory(Context.m_Device, Context.m_HiZ, Context.m_HiZMemory, 0))return false;
+
+      VkImageViewCreateInfo viewInfo
+      {
+        .sType            { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO },
+        .image            { Context.m_HiZ },
+        .viewType         { VK_IMAGE_VIEW_TYPE_2D },
+        .format           { VK_FORMAT_R32_SFLOAT },
+        .subresourceRange { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
+      };
+      VkSamplerCreateInfo samplerInfo
+      {
+        .sType        { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO },
+        .magFilter    { VK_FILTER_NEAREST },
+        .minFilter    { VK_FILTER_NEAREST },
+        .mipmapMode   { VK_SAMPLER_MIPMAP_MODE_NEAREST },
+        .addressModeU { VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE },
+        .addressModeV { VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE },
+        .addressModeW { VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE }
+      };
+      return VK_SUCCESS == vkCreateImageView(Context.m_Device, &viewInfo, nullptr, &Context.m_HiZView)
+        && VK_SUCCESS == vkCreateSampler(Context.m_Device, &samplerInfo, nullptr, &Context.m_Sampler);
+    }
+
+    static bool createPipeline(cullContext& Context, std::string_view const& shaderPath)
+    {
+      std::ifstream file{ std::string{ shaderPath }, std::ios::binary | std::ios::ate };
+      if (false == file.is_open())return false;
+      std::vector<uint32_t> code(static_cast<size_t>(file.tellg()) / sizeof(uint32_t));
+      file.seekg(0);
+      file.read(reinterpret_cast<char*>(code.data()), code.size() * sizeof(uint32_t));
+
+      VkShaderModuleCreateInfo shaderInfo
+      {
+        .sType    { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO },
+        .codeSize { code.size() * sizeof(uint32_t) },
+        .pCode    { code.data() }
+      };
+      if (code.empty() || VK_SUCCESS != vkCreateShaderModule(Context.m_Device, &shaderInfo, nullptr, &Context.m_Shader))return false;
+
+      VkDescriptorSetLayoutBinding bindings[]
+      {
+        { 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        { 2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        { 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+      };
+      VkDescriptorSetLayoutCreateInfo setLayoutInfo
+      {
+        .sType        { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO },
+        .bindingCount { static_cast<uint32_t>(std::size(bindings)) },
+        .pBindings    { bindings }
+      };
+      VkPushConstantRange pushRange{ VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(cullConstants) };
+      VkPipelineLayoutCreateInfo layoutInfo
+      {
+        .sType                  { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO },
+        .setLayoutCount         { 1 },
+        .pSetLayouts            { &Context.m_SetLayout },
+        .pushConstantRangeCount { 1 },
+        .pPushConstantRanges    { &pushRange }
+      };
+      if (VK_SUCCESS != vkCreateDescriptorSetLayout(Context.m_Device, &setLayoutInfo, nullptr, &Context.m_SetLayout)
+        || VK_SUCCESS != vkCreatePipelineLayout(Context.m_Device, &layoutInfo, nullptr, &Context.m_PipelineLayout))return false;
+
+      VkComputePipelineCreateInfo pipelineInfo
+      {
+        .sType  { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO },
+        .stage
+        {
+          .sType  { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO },
+          .stage  { VK_SHADER_STAGE_COMPUTE_BIT },
+          .module { Context.m_Shader },
+          .pName  { "main" }
+        },
+        .layout { Context.m_PipelineLayout }
+      };
+      if (VK_SUCCESS != vkCreateComputePipelines(Context.m_Device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &Context.m_Pipeline))return false;
+
+      VkDescriptorPoolSize poolSizes[]
+      {
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 }
+      };
+      VkDescriptorPoolCreateInfo poolInfo
+      {
+        .sType        { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO },
+        .maxSets      { 1 },
+        .poolSizeCount{ static_cast<uint32_t>(std::size(poolSizes)) },
+        .pPoolSizes   { poolSizes }
+      };
+      VkDescriptorSetAllocateInfo setInfo
+      {
+        .sType              { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO },
+        .descriptorSetCount { 1 },
+        .pSetLayouts        { &Context.m_SetLayout }
+      };
+      if (VK_SUCCESS != vkCreateDescriptorPool(Context.m_Device, &poolInfo, nullptr, &Context.m_DescriptorPool))return false;
+      setInfo.descriptorPool = Context.m_DescriptorPool;
+      if (VK_SUCCESS != vkAllocateDescriptorSets(Context.m_Device, &setInfo, &Context.m_Set))return false;
+
+      VkDescriptorBufferInfo bufferInfos[]
+      {
+        { Context.m_Objects.m_Buffer, 0, VK_WHOLE_SIZE },
+        { Context.m_Indirect.m_Buffer, 0, VK_WHOLE_SIZE },
+        { Context.m_View.m_Buffer, 0, VK_WHOLE_SIZE }
+      };
+      VkDescriptorImageInfo imageInfo{ Context.m_Sampler, Context.m_HiZView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+      VkWriteDescriptorSet writes[4];
+      for (uint32_t i{ 0 }; i < 4; ++i)
+      {
+        writes[i] = VkWriteDescriptorSet
+        {
+          .sType          { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET },
+          .dstSet         { Context.m_Set },
+          .dstBinding     { i },
+          .descriptorCount{ 1 },
+          .descriptorType { bindings[i].descriptorType },
+          .pImageInfo     { i == 3 ? &imageInfo : nullptr },
+          .pBufferInfo    { i == 3 ? nullptr : &bufferInfos[i] }
+        };
+      }
+      vkUpdateDescriptorSets(Context.m_Device, 4, writes, 0, nullptr);
+      return true;
+    }
+
+    /// @brief records and waits on one cull dispatch, after moving the dummy
+    ///        pyramid to the layout its descriptor names
+    static bool dispatchCull(cullContext& Context, cullConstants const& Constants)
+    {
+      if (Context.m_CommandPool == VK_NULL_HANDLE)
+      {
+        VkCommandPoolCreateInfo poolInfo
+        {
+          .sType            { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO },
+          .flags            { VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT },
+          .queueFamilyIndex { Context.m_QueueFamily }
+        };
+        VkFenceCreateInfo fenceInfo{ .sType{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO } };
+        if (VK_SUCCESS != vkCreateCommandPool(Context.m_Device, &poolInfo, nullptr, &Context.m_CommandPool)
+          || VK_SUCCESS != vkCreateFence(Context.m_Device, &fenceInfo, nullptr, &Context.m_Fence))return false;
+      }
+
+      VkCommandBufferAllocateInfo allocInfo
+      {
+        .sType              { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO },
+        .commandPool        { Context.m_CommandPool },
+        .level              { VK_COMMAND_BUFFER_LEVEL_PRIMARY },
+        .commandBufferCount { 1 }
+      };
+      VkCommandBuffer CB{ VK_NULL_HANDLE };
+      if (VK_SUCCESS != vkAllocateCommandBuffers(Context.m_Device, &allocInfo, &CB))return false;
+
+      VkCommandBufferBeginInfo beginInfo
+      {
+        .sType{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO },
+        .flags{ VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT }
+      };
+      vkBeginCommandBuffer(CB, &beginInfo);
+      VkImageMemoryBarrier toRead
+      {
+        .sType              { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER },
+        .dstAccessMask      { VK_ACCESS_SHADER_READ_BIT },
+        .oldLayout          { VK_IMAGE_LAYOUT_UNDEFINED },
+        .newLayout          { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL },
+        .srcQueueFamilyIndex{ VK_QUEUE_FAMILY_IGNORED },
+        .dstQueueFamilyIndex{ VK_QUEUE_FAMILY_IGNORED },
+        .image              { Context.m_HiZ },
+        .subresourceRange   { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
+      };
+      vkCmdPipelineBarrier(CB, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toRead);
+      vkCmdBindPipeline(CB, VK_PIPELINE_BIND_POINT_COMPUTE, Context.m_Pipeline);
+      vkCmdBindDescriptorSets(CB, VK_PIPELINE_BIND_POINT_COMPUTE, Context.m_PipelineLayout, 0, 1, &Context.m_Set, 0, nullptr);
+      vkCmdPushConstants(CB, Context.m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(cullConstants), &Constants);
+      vkCmdDispatch(CB, (Constants.m_ObjectCount + 63) / 64, 1, 1);
+      VkMemoryBarrier toHost
+      {
+        .sType        { VK_STRUCTURE_TYPE_MEMORY_BARRIER },
+        .srcAccessMask{ VK_ACCESS_SHADER_WRITE_BIT },
+        .dstAccessMask{ VK_ACCESS_HOST_READ_BIT }
+      };
+      vkCmdPipelineBarrier(CB, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &toHost, 0, nullptr, 0, nullptr);
+      vkEndCommandBuffer(CB);
+
+      VkSubmitInfo submitInfo
+      {
+        .sType              { VK_STRUCTURE_TYPE_SUBMIT_INFO },
+        .commandBufferCount { 1 },
+        .pCommandBuffers    { &CB }
+      };
+      bool bOK
+      {
+        VK_SUCCESS == vkResetFences(Context.m_Device, 1, &Context.m_Fence)
+        && VK_SUCCESS == vkQueueSubmit(Context.m_Queue, 1, &submitInfo, Context.m_Fence)
+        && VK_SUCCESS == vkWaitForFences(Context.m_Device, 1, &Context.m_Fence, VK_TRUE, UINT64_MAX)
+      };
+      vkFreeCommandBuffers(Context.m_Device, Context.m_CommandPool, 1, &CB);
+      return bOK;
+    }
+
+    /// @brief the checks vulkanGPUCuller::verify does, plus that every
+    ///        written command is its object's draw
+    static int compareCull(cullContext const& Context, frustum const& worldFrustum, std::span<const cullObject> objects, cullConstants const& Constants)
+    {
+      int failures{ 0 };
+      uint32_t const* pWords{ static_cast<uint32_t const*>(Context.m_Indirect.m_pMapped) };
+      uint32_t commandCount{ Constants.m_Compact ? pWords[Constants.m_CountWord] : Constants.m_ObjectCount };
+      failures += Checks::expect(commandCount <= Constants.m_ObjectCount, "no more draws than objects"sv);
+      if (failures)return failures;
+
+      // what the GPU drew, and that each draw is its object's
+      std::vector<uint32_t> gpuVisible;
+      bool bDrawsMatch{ true };
+      for (uint32_t i{ 0 }; i < commandCount; ++i)
+      {
+        VkDrawIndexedIndirectCommand const& refCommand{ reinterpret_cast<VkDrawIndexedIndirectCommand const*>(pWords + Constants.m_FirstWord)[i] };
+        uint32_t objectIndex{ Constants.m_Compact ? refCommand.firstInstance - objects[0].m_InstanceID : i };
+        bDrawsMatch = bDrawsMatch && objectIndex < objects.size()
+          && refCommand.indexCount == objects[objectIndex].m_IndexCount
+          && refCommand.firstIndex == objects[objectIndex].m_FirstIndex
+          && refCommand.vertexOffset == objects[objectIndex].m_VertexOffset
+          && refCommand.firstInstance == objects[objectIndex].m_InstanceID
+          && refCommand.instanceCount <= 1
+          && (refCommand.instanceCount == 1 || false == Constants.m_Compact);
+        if (refCommand.instanceCount)gpuVisible.emplace_back(refCommand.firstInstance);
+      }
+      failures += Checks::expect(bDrawsMatch, "every command is its object's draw"sv);
+
+      // the CPU sets with borderline objects kept (loose) and dropped (tight)
+      std::vector<uint32_t> loose, tight;
+      cullObjects(worldFrustum, objects, loose, s_CheckSlack);
+      cullObjects(worldFrustum, objects, tight, -s_CheckSlack);
+      for (std::vector<uint32_t>* x : { &loose, &tight })
+      {
+        for (uint32_t& i : *x)i = objects[i].m_InstanceID;
+      }
+      std::sort(gpuVisible.begin(), gpuVisible.end());
+
+      printf_s("  %s: GPU %zu, CPU %zu to %zu visible of %u\n", Constants.m_Compact ? "compact" : "one slot per object", gpuVisible.size(), tight.size(), loose.size(), Constants.m_ObjectCount);
+      failures += Checks::expect(std::adjacent_find(gpuVisible.begin(), gpuVisible.end()) == gpuVisible.end(), "no object is drawn twice"sv);
+      failures += Checks::expect(std::includes(loose.begin(), loose.end(), gpuVisible.begin(), gpuVisible.end()), "the GPU draws nothing the CPU culls"sv);
+      failures += Checks::expect(std::includes(gpuVisible.begin(), gpuVisible.end(), tight.begin(), tight.end()), "the GPU draws everything the CPU keeps"sv);
+      return failures;
+    }
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+int MTU::Checks::checkGPUCuller()
+{
+  using namespace MTU::Helper;
+  int failures{ 0 };
+  cullContext context;
+  if (false == createDevice(context))
+  {
+    printf_s("  skipped, no Vulkan 1.2 device with a compute queue\n");
+    return Checks::s_Skipped;
+  }
+
+  // room for the one slot per object batch, an offset compact batch and their counts
+  constexpr uint32_t maxCommands{ s_CheckObjects * 2 };
+  bool bCreated
+  {
+    createBuffer(context, context.m_Objects, sizeof(cullObject) * s_CheckObjects, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+    && createBuffer(context, context.m_Indirect, sizeof(VkDrawIndexedIndirectCommand) * maxCommands + sizeof(uint32_t) * 2, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+    && createBuffer(context, context.m_View, sizeof(cullView), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+    && createDummyHiZ(context)
+  };
+  if (false == bCreated)return Checks::expect(bCreated, "the check's buffers and images are created"sv);
+  if (false == createPipeline(context, "../Assets/Shaders/Cull.spv"sv))return Checks::expect(false, "../Assets/Shaders/Cull.spv makes a compute pipeline"sv);
+
+  // a crowd around a camera looking down -z, rotated and unevenly scaled so
+  // the radius is grown by the largest axis, a bit over half inside
+  glm::mat4 W2V{ glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) * glm::lookAt(glm::vec3{ 0.0f, 2.0f, 10.0f }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }) };
+  frustum worldFrustum{ extractFrustum(W2V) };
+  std::mt19937 rng{ 2150 };
+  std::uniform_real_distribution<float> position{ -60.0f, 60.0f }, unit{ 0.0f, 1.0f };
+  std::span<cullObject> objects{ static_cast<cullObject*>(context.m_Objects.m_pMapped), s_CheckObjects };
+  for (uint32_t i{ 0 }; i < s_CheckObjects; ++i)
+  {
+    glm::mat4 M2W{ glm::translate(glm::mat4{ 1.0f }, glm::vec3{ position(rng), position(rng) * 0.25f, position(rng) - 40.0f }) };
+    M2W = glm::rotate(M2W, unit(rng) * 6.28f, glm::normalize(glm::vec3{ unit(rng), unit(rng), unit(rng) } + glm::vec3{ 0.01f }));
+    M2W = glm::scale(M2W, glm::vec3{ 0.25f + unit(rng) * 2.0f, 0.25f + unit(rng) * 2.0f, 0.25f + unit(rng) * 2.0f });
+    objects[i] = cullObject
+    {
+      .m_M2W            { M2W },
+      .m_BoundingSphere { unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f, 0.1f + unit(rng) * 3.0f },
+      .m_FirstIndex     { i * 36 },
+      .m_IndexCount     { 3 + i % 97 },
+      .m_VertexOffset   { static_cast<int32_t>(i) - 2000 },
+      .m_InstanceID     { i + 100 }
+    };
+  }
+
+  cullView& refView{ *static_cast<cullView*>(context.m_View.m_pMapped) };
+  std::copy(std::begin(worldFrustum.m_Planes), std::end(worldFrustum.m_Planes), refView.m_Planes);
+  refView.m_HiZW2V = W2V;
+  refView.m_HiZInfo = glm::ivec4{ 1, 1, 1, 0 };
+
+  // one slot per object over everything (culled objects draw 0 instances),
+  // then compact over a range that starts mid buffer into a later batch
+  constexpr uint32_t firstObject{ 100 };
+  cullConstants const runs[]
+  {
+    {
+      .m_FirstObject  { 0 },
+      .m_ObjectCount  { s_CheckObjects },
+      .m_FirstWord    { 0 },
+      .m_CountWord    { maxCommands * s_CommandWords },
+      .m_Compact      { 0 }
+    },
+    {
+      .m_FirstObject  { firstObject },
+      .m_ObjectCount  { s_CheckObjects - firstObject - 7 },
+      .m_FirstWord    { s_CheckObjects * s_CommandWords },
+      .m_CountWord    { maxCommands * s_CommandWords + 1 },
+      .m_Compact      { 1 }
+    }
+  };
+  std::memset(context.m_Indirect.m_pMapped, 0xFF, sizeof(VkDrawIndexedIndirectCommand) * maxCommands + sizeof(uint32_t) * 2);
+  for (cullConstants const& x : runs)
+  {
+    static_cast<uint32_t*>(context.m_Indirect.m_pMapped)[x.m_CountWord] = 0;
+    if (false == dispatchCull(context, x))return failures + Checks::expect(false, "the cull dispatch runs"sv);
+    failures += compareCull(context, worldFrustum, std::span<const cullObject>{ objects }.subspan(x.m_FirstObject, x.m_ObjectCount), x);
+  }
+  return failures;
+}
+
+// *****************************************************************************
@@ -0,0 +1,39 @@
+/*!*****************************************************************************
+ * @file    main.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   Runs every check and exits with a non zero code if any failed,
+ *          or with s_SkippedExitCode if none failed but some couldn't run.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <cstdlib>
+#include <checks.h>
+
+static constexpr int s_SkippedExitCode{ 77 };// what automake and ctest's SKIP_RETURN_CODE usually take
+
+int main()
+{
+  int failures{ 0 };
+  int skipped{ 0 };
+  auto runCheck
+  {
+    [&](int result)
+    {
+      if (result == MTU::Checks::s_Skipped)++skipped;
+      else failures += result;
+    }
+  };
+
+  printf_s("occlusionBuffer\n");
+  runCheck(MTU::Checks::checkOcclusionBuffer());
+
+  printf_s("vulkanGPUCuller\n");
+  runCheck(MTU::Checks::checkGPUCuller());
+
+  if (failures)printf_s("%d check(s) FAILED\n", failures);
+  else if (skipped)printf_s("the checks that ran passed, %d SKIPPED\n", skipped);
+  else printf_s("all checks passed\n");
+  return failures ? EXIT_FAILURE : (skipped ? s_SkippedExitCode : EXIT_SUCCESS);
+}
@@ -0,0 +1,79 @@
+/*!*****************************************************************************
+ * @file    occlusionCheck.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the CPU only check of MTU::occlusionBuffer
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <limits>
+#include <checks.h>
+#include <utility/occlusionBuffer.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace MTU
+{
+  namespace Helper
+  {
+    // boxes are given in view space, the camera looks down -z
+    static aabb makeBox(glm::vec3 const& center, glm::vec3 const& halfExtent) noexcept
+    {
+      return aabb{ .m_Min{ center - halfExtent }, .m_Max{ center + halfExtent } };
+    }
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+int MTU::Checks::checkOcclusionBuffer()
+{
+  int failures{ 0 };
+  glm::mat4 V2Clip{ glm::perspective(glm::radians(90.0f), 2.0f, 0.125f, 100.0f) };
+
+  // a 4 x 4 quad 5 in front of the camera, covering the middle of the screen
+  occluderMesh quad
+  {
+    .m_Positions{ { -2.0f, -2.0f, -5.0f }, { 2.0f, -2.0f, -5.0f }, { 2.0f, 2.0f, -5.0f }, { -2.0f, 2.0f, -5.0f } },
+    .m_Indices  { 0, 1, 2, 0, 2, 3 }
+  };
+  occlusionBuffer buffer;
+  buffer.resize(256, 128);
+  buffer.addOccluder(quad, V2Clip);
+  buffer.rasterize();
+
+  failures += expect(buffer.getTriangleCount() == 2, "both quad triangles are binned"sv);
+  failures += expect(buffer.getDepth(128, 64) < 1.0f, "the quad covers the center pixel"sv);
+  failures += expect(buffer.getDepth(2, 2) == 1.0f, "the corner pixel stays clear"sv);
+
+  // behind the quad's middle, inside its outline at every pixel
+  failures += expect(false == buffer.isVisible(Helper::makeBox({ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.5f }), V2Clip), "a box fully behind the quad is hidden"sv);
+
+  // behind, but reaching past the quad's right edge (x = 0.4 of depth)
+  failures += expect(buffer.isVisible(Helper::makeBox({ 4.0f, 0.0f, -10.0f }, glm::vec3{ 1.0f }), V2Clip), "a box across the quad's edge is visible"sv);
+
+  // between the camera and the quad
+  failures += expect(buffer.isVisible(Helper::makeBox({ 0.0f, 0.0f, -3.0f }, glm::vec3{ 0.5f }), V2Clip), "a box in front of the quad is visible"sv);
+
+  // behind, but nowhere near the quad on screen
+  failures += expect(buffer.isVisible(Helper::makeBox({ 12.0f, 0.0f, -10.0f }, glm::vec3{ 0.5f }), V2Clip), "a box beside the quad is visible"sv);
+
+  // projects billions of pixels wide, the clamp keeps the casts in range
+  failures += expect(buffer.isVisible(Helper::makeBox({ 0.0f, 0.0f, -10.0f }, glm::vec3{ 1.0e30f, 1.0e30f, 0.5f }), V2Clip), "a huge box is visible"sv);
+
+  // nan or inf never reach the casts
+  glm::mat4 badClip{ V2Clip };
+  badClip[0][0] = std::numeric_limits<float>::quiet_NaN();
+  failures += expect(buffer.isVisible(Helper::makeBox({ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.5f }), badClip), "a box with a nan projection is visible"sv);
+  badClip[0][0] = std::numeric_limits<float>::infinity();
+  failures += expect(buffer.isVisible(Helper::makeBox({ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.5f }), badClip), "a box with an infinite projection is visible"sv);
+
+  // an occluder with a nan corner is dropped instead of rasterized
+  buffer.clear();
+  buffer.addOccluder(quad, badClip);
+  failures += expect(buffer.getTriangleCount() == 0, "occluders with non finite corners are skipped"sv);
+  return failures;
+}
+
+// *****************************************************************************
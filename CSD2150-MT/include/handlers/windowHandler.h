@@ -19,7 +19,9 @@
 #include <vulkanHelpers/vulkanPipeline.h>
 #include <vulkanHelpers/vulkanBuffer.h>
 #include <vulkanHelpers/vulkanTexture.h>
+#include <vulkanHelpers/vulkanComputePipeline.h>
 #include <vector>
+#include <span>
 
 class windowHandler : public Singleton<windowHandler>
 {
@@ -31,6 +33,15 @@ public:
 
     bool OK() const noexcept;
 
+    /// @brief true if uint8 index buffers can be bound (VK_EXT_index_type_uint8)
+    bool isIndexTypeUint8Supported() const noexcept;
+
+    /// @brief draws one indirect call may issue, 1 without multiDrawIndirect
+    uint32_t getMaxDrawIndirectCount() const noexcept;
+
+    /// @brief true if the draw count of an indirect call can come from a buffer
+    bool isDrawIndirectCountSupported() const noexcept;
+
     ~windowHandler();
 
     /// @brief process windows messages, you will need to update individual 
@@ -65,11 +76,21 @@ public:
 
     void destroyTexture(vulkanTexture& inTexture);
 
+    // COMPUTE (implementation in vulkanComputePipeline.cpp)
+
+    bool createComputePipeline(vulkanComputePipeline& outPipeline, vulkanComputePipeline::setup const& inSetup);
+
+    /// @brief points every binding of set setIndex at infos[binding]
+    bool updateComputeDescriptors(vulkanComputePipeline& inPipeline, uint32_t setIndex, std::span<const vulkanComputePipeline::descriptorInfo> infos);
+
+    void destroyComputePipeline(vulkanComputePipeline& inPipeline);
+
     // one time submit command buffer
 
     VkCommandBuffer beginOneTimeSubmitCommand(bool useMainCommandPool = false);
 
-    void endOneTimeSubmitCommand(VkCommandBuffer toEnd, bool useMainCommandPool = false);
+    /// @return true once the commands were submitted and finished
+    bool endOneTimeSubmitCommand(VkCommandBuffer toEnd, bool useMainCommandPool = false);
 
     // Buffers
 
@@ -82,20 +103,48 @@ public:
     bool createBuffer(vulkanBuffer& outBuffer, vulkanBuffer::Setup const& inSetup);
     void destroyBuffer(vulkanBuffer& inBuffer);
 
-private:
-    friend class Singleton;
-    windowHandler& operator=(windowHandler const&) = delete;
-    windowHandler(windowHandler const&) = delete;
-private:
+    /// @brief create a staging buffer to be filled through mapBuffer, uses
+    ///        host cached memory if the device has it (cheap CPU reads)
+    /// @param outBuffer staging buffer
+    /// @param byteSize size in bytes, may round up past 4GB
+    /// @return true if the buffer was created
+    bool createStagingBuffer(vulkanBuffer& outBuffer, VkDeviceSize byteSize);
 
-    windowHandler(size_t flagOptions);
+    /// @brief map a host visible buffer's whole memory
+    /// @return pointer to the mapped memory, nullptr if it failed
+    void* mapBuffer(vulkanBuffer& inBuffer);
+    void unmapBuffer(vulkanBuffer& inBuffer);
 
     /// @brief copy from a staging buffer to another buffer
     /// @param dstBuffer destination buffer (must have destination bit set)
     /// @param srcBuffer source buffer (must have source bit set)
     /// @param cpySize size of data to be copied
+    /// @param srcOffset byte offset into srcBuffer
+    /// @param dstOffset byte offset into dstBuffer
+    /// @return true if the copy was submitted and finished, false otherwise
+    bool copyBuffer(vulkanBuffer& dstBuffer, vulkanBuffer& srcBuffer, VkDeviceSize cpySize, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0);
+
+    struct bufferCopy
+    {
+      vulkanBuffer* m_pDstBuffer{ nullptr };
+      VkDeviceSize  m_Size      { 0 };
+      VkDeviceSize  m_SrcOffset { 0 };
+      VkDeviceSize  m_DstOffset { 0 };
+    };
+
+    /// @brief copy from one staging buffer to many buffers in one submit
+    /// @param srcBuffer source buffer (must have source bit set)
+    /// @param copies regions to copy, destinations must have destination bit set
     /// @return true if copy successful, false otherwise
-    bool copyBuffer(vulkanBuffer& dstBuffer, vulkanBuffer& srcBuffer, VkDeviceSize cpySize);
+    bool copyBuffers(vulkanBuffer& srcBuffer, std::span<const bufferCopy> copies);
+
+private:
+    friend class Singleton;
+    windowHandler& operator=(windowHandler const&) = delete;
+    windowHandler(windowHandler const&) = delete;
+private:
+
+    windowHandler(size_t flagOptions);
 
     std::shared_ptr<vulkanInstance> m_pVKInst;  // shared so stuff can depend on it
     std::shared_ptr<vulkanDevice> m_pVKDevice;  // has a copy of m_pVKInst
@@ -10,8 +10,15 @@
 #ifndef UTILITY_OBJ_LOADER_HELPER_HEADER
 #define UTILITY_OBJ_LOADER_HELPER_HEADER
 
-#include <vector>   // for outputs
-#include <fstream>  // for file source
+#include <span>       // for in memory source
+#include <string>     // for names
+#include <vector>     // for outputs
+#include <fstream>    // for file source
+#include <filesystem> // for mapped file source
+#include <functional> // for streamed output targets
+#include <glm/glm.hpp>
+#include <utility/vertices.h>
+#include <utility/indexTypes.hpp>
 
 namespace MTU
 {
@@ -20,18 +27,53 @@ namespace MTU
     std::string             m_Name;
     std::string             m_Material;
     std::vector<glm::vec3>  m_Positions;
-    std::vector<uint16_t>   m_Triangles;
+    indexVector             m_Triangles;  // narrowest type that fits
     std::vector<glm::vec3>  m_Normals;
     std::vector<glm::vec2>  m_TexCoords;
   };
 
   struct OBJLoadSettings
   {
-    bool m_bLoadNormals   { false };
-    bool m_bLoadTexCoords { true };
+    // buffers smaller than this per thread are not worth splitting up
+    static constexpr size_t s_MinChunkSize{ 1u << 20 };
+
+    bool     m_bLoadNormals       { false };
+    bool     m_bLoadTexCoords     { true };
+    bool     m_bAllowUint8Indices { false };// only if VK_EXT_index_type_uint8
+    unsigned m_NumThreads         { 1 };    // path/buffer sources, 0 for all cores
+  };
+
+  /// @brief where streamOBJ writes to, memory only needs to stay valid until
+  ///        streamOBJ returns (e.g. a mapped staging buffer)
+  struct OBJStreamTarget
+  {
+    // called once after counting, room for at least maxIndices indices
+    std::function<uint32_t*(size_t maxIndices)>             m_fnGetIndexMemory;
+    // called once after deduplication, room for exactly vertexCount vertices
+    std::function<VTX_3D_UV_NML_TAN*(size_t vertexCount)>  m_fnGetVertexMemory;
+  };
+
+  struct OBJStreamCounts
+  {
+    size_t m_IndexCount { 0 };  // indices actually written
+    size_t m_VertexCount{ 0 };
   };
 
   bool loadOBJ(std::ifstream& ifs, OBJOutputs& outputs, OBJLoadSettings = {});
+
+  /// @brief memory maps the file and parses it in place, no per line copies
+  bool loadOBJ(std::filesystem::path const& fPath, OBJOutputs& outputs, OBJLoadSettings = {});
+
+  /// @brief parses an OBJ already in memory. Separate name so string literals
+  ///        don't become ambiguous between the path and span versions.
+  bool loadOBJBuffer(std::span<const char> srcBuffer, OBJOutputs& outputs, OBJLoadSettings = {});
+
+  /// @brief two pass import that skips OBJOutputs entirely. The first pass
+  ///        counts records, the second writes uint32 indices and interleaved
+  ///        vertices straight into the target's memory. V is flipped to match
+  ///        the assimp path, missing normals and all tangents are generated.
+  /// @return false if the file could not be read or has bad references
+  bool streamOBJ(std::filesystem::path const& fPath, OBJStreamTarget const& target, OBJStreamCounts& outCounts, OBJLoadSettings = {});
 }
 
 #endif//UTILITY_OBJ_LOADER_HELPER_HEADER
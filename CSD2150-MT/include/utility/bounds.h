@@ -0,0 +1,75 @@
+/*!*****************************************************************************
+ * @file    bounds.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for model bounds computed over
+ *          vertex positions and a structure of arrays set of world spheres
+ *          frustum tested 4 or 8 at a time.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_BOUNDS_HELPER_HEADER
+#define UTILITY_BOUNDS_HELPER_HEADER
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <utility/frustum.h>
+
+namespace MTU
+{
+  struct aabb
+  {
+    glm::vec3 m_Min{ 0.0f };
+    glm::vec3 m_Max{ 0.0f };
+  };
+
+  struct bounds
+  {
+    aabb      m_Box   {};
+    glm::vec4 m_Sphere{ 0.0f };// around the box center, radius in w
+  };
+
+  /// @brief box and sphere of every position, 4 vertices per step
+  /// @param pPositions 3 floats each, positionStride bytes apart
+  bounds computeBounds(const float* pPositions, size_t positionStride, size_t vertexCount) noexcept;
+
+  /// @brief the sphere moved by M2W, radius grown by the largest axis scale
+  glm::vec4 transformSphere(glm::vec4 const& sphere, glm::mat4 const& M2W) noexcept;
+
+  /// @brief world spheres laid out for batch frustum tests, objects that
+  ///        don't move can be added once and tested every frame
+  class sphereSet
+  {
+  public:
+
+    void clear() noexcept;
+    void reserve(size_t count);
+    /// @return the sphere's index, what cull reports it as
+    uint32_t add(glm::vec4 const& sphere);
+    uint32_t size() const noexcept { return m_Count; }
+
+    /// @brief same test as isSphereInFrustum, 8 spheres per step with AVX
+    ///        and 4 with SSE
+    /// @param outVisible indices of the visible spheres, ascending
+    void cull(frustum const& worldFrustum, std::vector<uint32_t>& outVisible) const;
+
+  private:
+
+    enum componentID
+    {
+      E_CENTER_X = 0,
+      E_CENTER_Y,
+      E_CENTER_Z,
+      E_RADIUS,
+      E_NUM_COMPONENTS
+    };
+
+    std::vector<float>  m_Components[E_NUM_COMPONENTS]{};// padded to a multiple of 8
+    uint32_t            m_Count{ 0 };
+  };
+}
+
+#endif//UTILITY_BOUNDS_HELPER_HEADER
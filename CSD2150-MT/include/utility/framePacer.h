@@ -0,0 +1,52 @@
+/*!*****************************************************************************
+ * @file    framePacer.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for a frame rate cap, most of
+ *          the wait is a high resolution sleep and only the last bit spins.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_FRAME_PACER_HELPER_HEADER
+#define UTILITY_FRAME_PACER_HELPER_HEADER
+
+#include <chrono>
+
+namespace MTU
+{
+  class framePacer
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    // sleeps can wake late by about a scheduler tick, spun instead
+    static constexpr clock::duration s_SpinMargin{ std::chrono::microseconds{ 1500 } };
+
+    framePacer();
+    ~framePacer();
+
+    framePacer(framePacer const&) = delete;
+    framePacer& operator=(framePacer const&) = delete;
+
+    /// @param framesPerSecond 0 (or less) for uncapped
+    void setFrameRateCap(double framesPerSecond) noexcept;
+    double getFrameRateCap() const noexcept;
+
+    /// @brief blocks until a frame period after the last pace, at once if
+    ///        uncapped. A frame later than a whole period starts over
+    ///        instead of rushing the next ones to catch up.
+    /// @return how long it blocked
+    clock::duration pace();
+
+  private:
+
+    void sleepFor(clock::duration duration);
+
+    clock::duration   m_Period    { 0 };
+    clock::time_point m_NextFrame {};
+    void*             m_hTimer    { nullptr };// waitable timer, sleep_for without one
+  };
+}
+
+#endif//UTILITY_FRAME_PACER_HELPER_HEADER
@@ -0,0 +1,42 @@
+/*!*****************************************************************************
+ * @file    frustum.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for view frustum planes pulled
+ *          out of a transform to clip space, for CPU side culling.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_FRUSTUM_HELPER_HEADER
+#define UTILITY_FRUSTUM_HELPER_HEADER
+
+#include <glm/glm.hpp>
+
+namespace MTU
+{
+  /// @brief inward facing, normalized planes, dot(xyz, p) + w >= 0 is inside
+  struct frustum
+  {
+    enum planeID
+    {
+      E_LEFT = 0,
+      E_RIGHT,
+      E_BOTTOM,
+      E_TOP,
+      E_NEAR,
+      E_FAR,
+      E_NUM_PLANES
+    };
+
+    glm::vec4 m_Planes[E_NUM_PLANES];
+  };
+
+  /// @brief Gribb/Hartmann plane extraction for 0..1 clip depth. The planes
+  ///        are in whatever space toClip takes in, model space for an MVP.
+  frustum extractFrustum(glm::mat4 const& toClip) noexcept;
+
+  bool isSphereInFrustum(frustum const& inFrustum, glm::vec3 const& center, float radius) noexcept;
+}
+
+#endif//UTILITY_FRUSTUM_HELPER_HEADER
@@ -0,0 +1,118 @@
+/*!*****************************************************************************
+ * @file    indexTypes.hpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the helpers for choosing the narrowest index
+ *          type that can address a mesh's vertices.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_INDEX_TYPES_HEADER
+#define UTILITY_INDEX_TYPES_HEADER
+
+#include <span>
+#include <limits>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstring>
+
+namespace MTU
+{
+  /// @brief index storage, alternative order matches the width (8, 16, 32)
+  using indexVector = std::variant<std::vector<uint8_t>, std::vector<uint16_t>, std::vector<uint32_t>>;
+
+  /// @brief empty index vector of the narrowest type that fits vertexCount.
+  ///        The all-ones value of each type is kept free for primitive restart.
+  inline indexVector makeIndexVector(size_t vertexCount, bool bAllowUint8 = false)
+  {
+    if (bAllowUint8 && vertexCount <= std::numeric_limits<uint8_t>::max())return indexVector{ std::in_place_index<0> };
+    if (vertexCount <= std::numeric_limits<uint16_t>::max())return indexVector{ std::in_place_index<1> };
+    return indexVector{ std::in_place_index<2> };
+  }
+
+  /// @brief copies src into the narrowest index type that fits vertexCount
+  template <typename T>
+  inline indexVector narrowIndices(std::span<const T> src, size_t vertexCount, bool bAllowUint8 = false)
+  {
+    indexVector retval{ makeIndexVector(vertexCount, bAllowUint8) };
+    std::visit
+    (
+      [&src](auto& dst)
+      {
+        using dstType = typename std::remove_reference_t<decltype(dst)>::value_type;
+        dst.reserve(src.size());
+        for (T x : src)dst.emplace_back(static_cast<dstType>(x));
+      },
+      retval
+    );
+    return retval;
+  }
+
+  /// @brief narrows uint32 indices inside raw memory (e.g. a mapped staging
+  ///        buffer) front to back, so no unread index is overwritten.
+  /// @return the alternative index of the chosen type, same order as indexVector
+  inline size_t narrowIndicesInPlace(void* pIndices, size_t count, size_t vertexCount, bool bAllowUint8 = false) noexcept
+  {
+    size_t retval{ makeIndexVector(vertexCount, bAllowUint8).index() };
+    auto narrowTo
+    {
+      [pIndices, count]<typename T>(T)
+      {
+        char* pBytes{ static_cast<char*>(pIndices) };
+        for (size_t i{ 0 }; i < count; ++i)
+        {
+          uint32_t src;
+          std::memcpy(&src, pBytes + i * sizeof(uint32_t), sizeof(uint32_t));// raw memory,
+          T dst{ static_cast<T>(src) };                                       // no aliasing
+          std::memcpy(pBytes + i * sizeof(T), &dst, sizeof(T));
+        }
+      }
+    };
+    if (retval == 0)narrowTo(uint8_t{});
+    if (retval == 1)narrowTo(uint16_t{});
+    return retval;
+  }
+
+  inline size_t indexSize(indexVector const& src) noexcept
+  {
+    return std::visit([](auto const& x) { return sizeof(typename std::remove_reference_t<decltype(x)>::value_type); }, src);
+  }
+
+  inline size_t indexCount(indexVector const& src) noexcept
+  {
+    return std::visit([](auto const& x) { return x.size(); }, src);
+  }
+
+  inline const void* indexData(indexVector const& src) noexcept
+  {
+    return std::visit([](auto const& x) { return static_cast<const void*>(x.data()); }, src);
+  }
+
+  inline void* indexData(indexVector& src) noexcept
+  {
+    return std::visit([](auto& x) { return static_cast<void*>(x.data()); }, src);
+  }
+
+  /// @brief copies count indices between raw memory of any two index sizes
+  ///        (1, 2 or 4 bytes), the values must fit the destination size
+  inline void copyIndices(void* pDst, size_t dstSize, const void* pSrc, size_t srcSize, size_t count) noexcept
+  {
+    if (dstSize == srcSize)
+    {
+      std::memcpy(pDst, pSrc, count * srcSize);
+      return;
+    }
+    const char* pSrcBytes{ static_cast<const char*>(pSrc) };
+    char* pDstBytes{ static_cast<char*>(pDst) };
+    for (size_t i{ 0 }; i < count; ++i)
+    {
+      uint32_t x{ 0 };// little endian, the low bytes are the value
+      std::memcpy(&x, pSrcBytes + i * srcSize, srcSize);
+      std::memcpy(pDstBytes + i * dstSize, &x, dstSize);
+    }
+  }
+}
+
+#endif//UTILITY_INDEX_TYPES_HEADER
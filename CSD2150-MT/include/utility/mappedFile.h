@@ -0,0 +1,56 @@
+/*!*****************************************************************************
+ * @file    mappedFile.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for a read only memory mapped file
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_MAPPED_FILE_HELPER_HEADER
+#define UTILITY_MAPPED_FILE_HELPER_HEADER
+
+#include <filesystem> // for file path
+#include <span>       // for mapped view
+
+namespace MTU
+{
+  /// @brief read only view of a whole file through the OS file mapping.
+  ///        The view stays valid until close() or destruction.
+  class mappedFile
+  {
+  public:
+
+    mappedFile() = default;
+    mappedFile(std::filesystem::path const& fPath);
+    ~mappedFile();
+
+    mappedFile(mappedFile&& other) noexcept;
+    mappedFile& operator=(mappedFile&& other) noexcept;
+    mappedFile(mappedFile const&) = delete;
+    mappedFile& operator=(mappedFile const&) = delete;
+
+    /// @brief maps the whole file, closing any previously mapped file
+    /// @param fPath path to the file to map
+    /// @return true if the file was mapped (empty files are OK)
+    bool open(std::filesystem::path const& fPath);
+
+    void close() noexcept;
+
+    bool OK() const noexcept;
+
+    std::span<const char> data() const noexcept;
+
+    size_t size() const noexcept;
+
+  private:
+
+    void*       m_hFile   { nullptr };  // HANDLE, kept as void* to keep
+    void*       m_hMapping{ nullptr };  // windows.h out of this header
+    const char* m_pView   { nullptr };
+    size_t      m_Size    { 0 };
+    bool        m_bOpen   { false };
+  };
+}
+
+#endif//UTILITY_MAPPED_FILE_HELPER_HEADER
@@ -0,0 +1,102 @@
+/*!*****************************************************************************
+ * @file    meshCache.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for the cooked mesh cache, the
+ *          final vertex and index bytes of an import stored next to the
+ *          source so later loads skip the importer entirely.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_MESH_CACHE_HELPER_HEADER
+#define UTILITY_MESH_CACHE_HELPER_HEADER
+
+#include <utility/mappedFile.h>
+#include <utility/vertices.h>
+#include <filesystem>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace MTU
+{
+  /// @brief everything that makes a cooked mesh stale if it changes
+  struct meshCacheKey
+  {
+    std::filesystem::path m_SourcePath  {};
+    uint64_t              m_ImportFlags { 0 };// importer post process flags
+    uint64_t              m_CookFlags   { 0 };// anything else done after import
+    uint32_t              m_VertexStride{ 0 };// bytes per cooked vertex
+  };
+
+  struct meshCacheHeader
+  {
+    static constexpr uint32_t s_Magic   { 0x4D55544D };// "MTUM" in a hex editor
+    static constexpr uint32_t s_Version { 4 };         // bump on any layout/cook change
+
+    uint32_t  m_Magic         { s_Magic };
+    uint32_t  m_Version       { s_Version };
+    uint64_t  m_PathHash      { 0 };
+    uint64_t  m_ImportFlags   { 0 };
+    uint64_t  m_CookFlags     { 0 };
+    int64_t   m_SourceMTime   { 0 };
+    uint64_t  m_SourceSize    { 0 };
+    uint32_t  m_VertexCount   { 0 };
+    uint32_t  m_VertexStride  { 0 };
+    uint32_t  m_IndexCount    { 0 };
+    uint32_t  m_IndexSize     { 0 };
+    uint32_t  m_MeshletCount  { 0 };
+    uint32_t  m_MeshletStride { 0 };
+    uint32_t  m_LODCount      { 0 };
+    uint32_t  m_LODStride     { 0 };
+    VTX_DEQUANT m_Dequant     {};// identity unless the vertices are quantized
+    // vertex bytes follow, then index bytes, then meshlets, then LODs
+  };
+
+  /// @brief a validated, memory mapped cooked mesh
+  class cookedMesh
+  {
+  public:
+
+    /// @brief maps the cache file of inKey and checks it against the source
+    /// @return true if the cache exists and is up to date
+    bool open(meshCacheKey const& inKey);
+
+    meshCacheHeader const& getHeader() const noexcept;
+
+    std::span<const std::byte> getVertexBytes() const noexcept;
+
+    std::span<const std::byte> getIndexBytes() const noexcept;
+
+    std::span<const std::byte> getMeshletBytes() const noexcept;
+
+    std::span<const std::byte> getLODBytes() const noexcept;
+
+  private:
+
+    mappedFile      m_File  {};
+    meshCacheHeader m_Header{};
+  };
+
+  /// @brief where the cooked copy of a source mesh lives, next to the source
+  ///        and named after a hash of everything else in inKey, so loads of
+  ///        one source with different settings don't evict each other
+  std::filesystem::path getMeshCachePath(meshCacheKey const& inKey);
+
+  /// @brief writes a cooked mesh for inKey, replacing any existing one
+  /// @param inHeader counts, strides and dequant of the bytes, the rest is
+  ///        filled in from inKey and the source file
+  /// @return true if written, a failure only means the next load cooks again
+  bool writeMeshCache
+  (
+    meshCacheKey const& inKey,
+    meshCacheHeader const& inHeader,
+    std::span<const std::byte> vertexBytes,
+    std::span<const std::byte> indexBytes,
+    std::span<const std::byte> meshletBytes,
+    std::span<const std::byte> lodBytes
+  );
+}
+
+#endif//UTILITY_MESH_CACHE_HELPER_HEADER
@@ -0,0 +1,57 @@
+/*!*****************************************************************************
+ * @file    meshOptimizer.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for the post import mesh
+ *          optimization passes: vertex cache order (Forsyth), overdraw aware
+ *          cluster order (Tipsify-style) and vertex fetch order.
+ *          All passes work on triangle lists of uint32 indices.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_MESH_OPTIMIZER_HELPER_HEADER
+#define UTILITY_MESH_OPTIMIZER_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace MTU
+{
+  struct vertexCacheStats
+  {
+    float m_ACMR{ 0.0f };// average cache miss ratio, misses per triangle (0.5 - 3)
+    float m_ATVR{ 0.0f };// average transform to vertex ratio, misses per vertex (1+)
+  };
+
+  /// @brief simulates a FIFO post transform cache over the index list
+  vertexCacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize = 16);
+
+  /// @brief reorders triangles for post transform cache hits (Forsyth)
+  void optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+  /// @brief splits the (cache optimized) triangles into clusters at cache
+  ///        flushes and orders the clusters outward facing first, so the
+  ///        outer shell tends to be drawn before what it hides.
+  /// @param pPositions first vertex position (3 floats)
+  /// @param positionStride bytes between vertex positions
+  void optimizeOverdraw(std::span<uint32_t> indices, const float* pPositions, size_t positionStride, size_t vertexCount);
+
+  /// @brief renumbers vertices in first use order and rewrites the indices.
+  ///        Vertices that are never referenced are kept at the end.
+  /// @return old vertex index -> new vertex index
+  std::vector<uint32_t> optimizeVertexFetch(std::span<uint32_t> indices, size_t vertexCount);
+
+  /// @brief moves every vertex to where optimizeVertexFetch says it should be
+  template <typename T>
+  void remapVertices(std::vector<T>& vertices, std::span<const uint32_t> remap)
+  {
+    std::vector<T> remapped(vertices.size());
+    for (size_t i{ 0 }, t{ vertices.size() }; i < t; ++i)remapped[remap[i]] = vertices[i];
+    vertices.swap(remapped);
+  }
+}
+
+#endif//UTILITY_MESH_OPTIMIZER_HELPER_HEADER
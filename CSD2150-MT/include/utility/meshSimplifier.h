@@ -0,0 +1,56 @@
+/*!*****************************************************************************
+ * @file    meshSimplifier.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for the quadric error metric
+ *          (Garland/Heckbert) edge collapse simplifier used to build LODs
+ *          that share the original vertex buffer.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_MESH_SIMPLIFIER_HELPER_HEADER
+#define UTILITY_MESH_SIMPLIFIER_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace MTU
+{
+  /// @brief one level of detail inside a shared index/meshlet buffer
+  struct meshLOD
+  {
+    uint32_t  m_FirstIndex  { 0 };
+    uint32_t  m_IndexCount  { 0 };
+    uint32_t  m_FirstMeshlet{ 0 };
+    uint32_t  m_MeshletCount{ 0 };
+    float     m_Error       { 0.0f };// model units away from LOD 0 (roughly)
+  };
+
+  struct simplifyVertexData
+  {
+    const float*  m_pPositions    { nullptr };// 3 floats
+    size_t        m_PositionStride{ 0 };
+    const float*  m_pTexCoords    { nullptr };// 2 floats, picks the seam side
+    size_t        m_TexCoordStride{ 0 };
+    size_t        m_VertexCount   { 0 };
+  };
+
+  /// @brief collapses edges onto one of their vertices until targetIndexCount
+  ///        or maxError is reached, no new vertices are made. Vertices that
+  ///        share a position (UV/normal seams) collapse together.
+  /// @param outError the largest collapse error used, in model units
+  /// @return the simplified triangle list
+  std::vector<uint32_t> simplifyMesh
+  (
+    std::span<const uint32_t> indices,
+    simplifyVertexData const& vertexData,
+    size_t targetIndexCount,
+    float maxError,
+    float& outError
+  );
+}
+
+#endif//UTILITY_MESH_SIMPLIFIER_HELPER_HEADER
@@ -0,0 +1,93 @@
+/*!*****************************************************************************
+ * @file    meshlets.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for splitting a triangle list
+ *          into meshlets (contiguous index ranges with bounds) and culling
+ *          them against a frustum and their backface cones.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_MESHLETS_HELPER_HEADER
+#define UTILITY_MESHLETS_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <utility/frustum.h>
+
+namespace MTU
+{
+  struct meshlet
+  {
+    static constexpr uint32_t s_MaxVertices { 64 };
+    static constexpr uint32_t s_MaxTriangles{ 124 };
+
+    glm::vec3 m_Center;     // bounding sphere
+    float     m_Radius;
+    glm::vec3 m_ConeAxis;   // average facing of the triangles
+    float     m_ConeCutoff; // 1 means the cone can't cull anything
+    uint32_t  m_FirstIndex;
+    uint32_t  m_IndexCount;
+  };
+
+  struct indexRange
+  {
+    uint32_t m_FirstIndex;
+    uint32_t m_IndexCount;
+  };
+
+  /// @brief cuts the triangles into meshlets in their current order, so the
+  ///        index buffer is untouched. Run after optimizeVertexCache for
+  ///        tighter meshlets.
+  /// @param pPositions first vertex position (3 floats)
+  /// @param positionStride bytes between vertex positions
+  std::vector<meshlet> buildMeshlets(std::span<const uint32_t> indices, const float* pPositions, size_t positionStride);
+
+  /// @brief meshlet bounds stored 4 wide for SSE, ranges kept as is
+  class meshletCuller
+  {
+  public:
+
+    void setMeshlets(std::span<const meshlet> meshlets);
+    bool empty() const noexcept;
+
+    /// @brief appends the index ranges of every visible meshlet, neighbours
+    ///        in the index buffer are merged into one range.
+    /// @param inFrustum planes in model space
+    /// @param localCamPos camera position in model space
+    /// @param firstMeshlet, meshletCount only test these (one LOD's meshlets)
+    /// @return number of indices in outRanges
+    uint32_t cull
+    (
+      frustum const& inFrustum,
+      glm::vec3 const& localCamPos,
+      std::vector<indexRange>& outRanges,
+      uint32_t firstMeshlet = 0,
+      uint32_t meshletCount = UINT32_MAX
+    ) const;
+
+  private:
+
+    enum boundsID
+    {
+      E_CENTER_X = 0,
+      E_CENTER_Y,
+      E_CENTER_Z,
+      E_RADIUS,
+      E_AXIS_X,
+      E_AXIS_Y,
+      E_AXIS_Z,
+      E_CUTOFF,
+      E_NUM_BOUNDS
+    };
+
+    std::vector<float>      m_Bounds[E_NUM_BOUNDS]{};// padded to a multiple of 4
+    std::vector<indexRange> m_Ranges{};
+  };
+}
+
+#endif//UTILITY_MESHLETS_HELPER_HEADER
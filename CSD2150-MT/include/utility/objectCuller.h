@@ -0,0 +1,47 @@
+/*!*****************************************************************************
+ * @file    objectCuller.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the per object cull record shared with the
+ *          GPU culling shader (shaderCull.comp) and the CPU reference that
+ *          GPU results are checked against.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_OBJECT_CULLER_HELPER_HEADER
+#define UTILITY_OBJECT_CULLER_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <utility/frustum.h>
+
+namespace MTU
+{
+  /// @brief std430 layout, must match cullObject in shaderCull.comp
+  struct cullObject
+  {
+    glm::mat4 m_M2W;
+    glm::vec4 m_BoundingSphere;// model space center, radius in w
+    uint32_t  m_FirstIndex;    // the draw it becomes if visible
+    uint32_t  m_IndexCount;
+    int32_t   m_VertexOffset;
+    uint32_t  m_InstanceID;    // firstInstance of the draw, unique per object
+  };
+  static_assert(sizeof(cullObject) == 96);
+
+  /// @brief the bounding sphere moved to world space, radius grown by the
+  ///        largest axis scale
+  glm::vec4 getWorldSphere(cullObject const& inObject) noexcept;
+
+  /// @brief same test as the shader, object i is visible if its world
+  ///        sphere is not fully behind any plane
+  /// @param slack added to every radius, + keeps borderline objects and
+  ///        - drops them, to bracket float differences with the GPU
+  /// @param outVisible indices of the visible objects, ascending
+  void cullObjects(frustum const& worldFrustum, std::span<const cullObject> objects, std::vector<uint32_t>& outVisible, float slack = 0.0f);
+}
+
+#endif//UTILITY_OBJECT_CULLER_HELPER_HEADER
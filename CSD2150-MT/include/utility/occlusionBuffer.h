@@ -0,0 +1,90 @@
+/*!*****************************************************************************
+ * @file    occlusionBuffer.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for a coarse depth-only software
+ *          rasterizer. Low poly occluders are binned into screen tiles and
+ *          drawn 4 pixels per step, then object boxes are tested against the
+ *          nearest occluder depth before anything is recorded.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_OCCLUSION_BUFFER_HELPER_HEADER
+#define UTILITY_OCCLUSION_BUFFER_HELPER_HEADER
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <utility/bounds.h>
+#include <utility/threadPool.h>
+
+namespace MTU
+{
+  /// @brief positions and a triangle list, only what depth needs
+  struct occluderMesh
+  {
+    std::vector<glm::vec3>  m_Positions{};
+    std::vector<uint32_t>   m_Indices  {};
+  };
+
+  class occlusionBuffer
+  {
+  public:
+
+    static constexpr uint32_t s_TileWidth { 32 };// pixels, a multiple of 4
+    static constexpr uint32_t s_TileHeight{ 16 };
+
+    /// @brief any size, does nothing if it already is. Pixels map to clip
+    ///        space like the flipped vulkan viewport (ndc +y is row 0).
+    void resize(uint32_t width, uint32_t height);
+
+    /// @brief drops the occluders added since the last rasterize
+    void clear() noexcept;
+
+    /// @brief transforms and bins one occluder's triangles, both faces are
+    ///        drawn. Triangles crossing the near plane are left out.
+    void addOccluder(occluderMesh const& Mesh, glm::mat4 const& M2Clip);
+
+    /// @brief clears every tile and draws the triangles binned to it, one
+    ///        job per row of tiles on pPool if given
+    void rasterize(threadPool* pPool = nullptr);
+
+    /// @brief false only if the box is behind an occluder at every pixel it
+    ///        touches, at this buffer's resolution. Boxes crossing the near
+    ///        plane or outside the buffer are visible.
+    bool isVisible(aabb const& box, glm::mat4 const& M2Clip) const noexcept;
+
+    /// @return the nearest occluder depth (0..1), 1 where there is none
+    float getDepth(uint32_t x, uint32_t y) const noexcept;
+
+    uint32_t getWidth() const noexcept { return m_Width; }
+    uint32_t getHeight() const noexcept { return m_Height; }
+    uint32_t getTriangleCount() const noexcept { return static_cast<uint32_t>(m_Triangles.size()); }
+
+  private:
+
+    // inside where every a * x + b * y + c > 0, or = 0 on an owned edge,
+    // depth is the same form
+    struct screenTriangle
+    {
+      glm::vec3 m_Edges[3];
+      bool      m_bOwned[3];// of the two triangles on an edge exactly one owns it
+      glm::vec3 m_Depth;
+      int32_t   m_MinX, m_MinY, m_MaxX, m_MaxY;// pixels, inclusive
+    };
+
+    void rasterizeTile(uint32_t tileX, uint32_t tileY);
+    size_t getPixelOffset(uint32_t x, uint32_t y) const noexcept;
+
+    uint32_t                            m_Width    { 0 };
+    uint32_t                            m_Height   { 0 };
+    uint32_t                            m_TilesX   { 0 };
+    uint32_t                            m_TilesY   { 0 };
+    std::vector<screenTriangle>         m_Triangles{};
+    std::vector<std::vector<uint32_t>>  m_Bins     {};// triangles touching each tile
+    std::vector<float>                  m_Depth    {};// tile after tile, rows inside
+  };
+}
+
+#endif//UTILITY_OCCLUSION_BUFFER_HELPER_HEADER
@@ -0,0 +1,32 @@
+/*!*****************************************************************************
+ * @file    radixSort.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for a least significant digit
+ *          radix sort of 64 bit keys, used to order draws by state.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_RADIX_SORT_HELPER_HEADER
+#define UTILITY_RADIX_SORT_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace MTU
+{
+  struct sortKey
+  {
+    uint64_t m_Key;
+    uint32_t m_Index;// what the key was made for, carried along
+  };
+
+  /// @brief ascending by m_Key, equal keys keep their order. 8 passes of a
+  ///        byte each, a byte every key shares is skipped.
+  /// @param scratch resized to the key count, kept to reuse its memory
+  void radixSort(std::span<sortKey> keys, std::vector<sortKey>& scratch);
+}
+
+#endif//UTILITY_RADIX_SORT_HELPER_HEADER
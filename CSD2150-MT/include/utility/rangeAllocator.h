@@ -0,0 +1,47 @@
+/*!*****************************************************************************
+ * @file    rangeAllocator.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for a first fit offset allocator,
+ *          hands out element ranges of a fixed capacity (e.g. a GPU buffer)
+ *          and merges freed ranges back with their neighbours.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_RANGE_ALLOCATOR_HELPER_HEADER
+#define UTILITY_RANGE_ALLOCATOR_HELPER_HEADER
+
+#include <cstdint>
+#include <map>
+
+namespace MTU
+{
+  class rangeAllocator
+  {
+  public:
+
+    explicit rangeAllocator(uint32_t capacity = 0);
+
+    /// @brief forgets every allocation, the whole capacity is free again
+    void reset(uint32_t capacity);
+
+    /// @brief first free range that fits, so long lived meshes pack low
+    /// @return false if no free range is big enough
+    bool allocate(uint32_t count, uint32_t& outOffset);
+
+    /// @brief offset and count must be exactly what allocate handed out
+    void free(uint32_t offset, uint32_t count);
+
+    uint32_t getCapacity() const noexcept;
+    uint32_t getUsed() const noexcept;
+
+  private:
+
+    std::map<uint32_t, uint32_t>  m_FreeRanges{};// offset -> count
+    uint32_t                      m_Capacity  { 0 };
+    uint32_t                      m_Used      { 0 };
+  };
+}
+
+#endif//UTILITY_RANGE_ALLOCATOR_HELPER_HEADER
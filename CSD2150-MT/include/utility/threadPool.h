@@ -0,0 +1,65 @@
+/*!*****************************************************************************
+ * @file    threadPool.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for a small fixed size thread
+ *          pool, for CPU side jobs that should overlap (model imports etc.)
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_THREAD_POOL_HELPER_HEADER
+#define UTILITY_THREAD_POOL_HELPER_HEADER
+
+#include <condition_variable>
+#include <type_traits>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace MTU
+{
+  class threadPool
+  {
+  public:
+
+    /// @param numThreads worker count, 0 for one per hardware thread
+    explicit threadPool(size_t numThreads = 0);
+    ~threadPool();// finishes every queued job before joining
+
+    threadPool(threadPool const&) = delete;
+    threadPool& operator=(threadPool const&) = delete;
+
+    /// @brief queue a job, exceptions end up in the future
+    template <typename Fn>
+    [[nodiscard]] std::future<std::invoke_result_t<Fn>> submit(Fn&& fn);
+
+    size_t getNumThreads() const noexcept;
+
+  private:
+
+    void push(std::function<void()>&& job);
+    void workerLoop(std::stop_token stopToken);
+
+    std::mutex                        m_Mutex     {};
+    std::condition_variable_any       m_CV        {};
+    std::deque<std::function<void()>> m_Jobs      {};
+    std::vector<std::jthread>         m_Workers   {};// last, stops first
+  };
+
+  template <typename Fn>
+  std::future<std::invoke_result_t<Fn>> threadPool::submit(Fn&& fn)
+  {
+    // std::function needs copyable, the task itself is move only
+    auto pTask{ std::make_shared<std::packaged_task<std::invoke_result_t<Fn>()>>(std::forward<Fn>(fn)) };
+    std::future<std::invoke_result_t<Fn>> retval{ pTask->get_future() };
+    push([pTask]() { (*pTask)(); });
+    return retval;
+  }
+}
+
+#endif//UTILITY_THREAD_POOL_HELPER_HEADER
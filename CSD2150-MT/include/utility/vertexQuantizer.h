@@ -0,0 +1,43 @@
+/*!*****************************************************************************
+ * @file    vertexQuantizer.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the interface for packing VTX_3D_UV_NML_TAN into
+ *          VTX_3D_UV_NML_TAN_Q16 and measuring what the packing cost.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef UTILITY_VERTEX_QUANTIZER_HELPER_HEADER
+#define UTILITY_VERTEX_QUANTIZER_HELPER_HEADER
+
+#include <span>
+#include <utility/vertices.h>
+
+namespace MTU
+{
+  /// @brief largest round trip error of any vertex, per attribute
+  struct vertexQuantizeError
+  {
+    float m_MaxPos    { 0.0f };// model units
+    float m_MaxPosRel { 0.0f };// fraction of the largest bounds axis
+    float m_MaxTex    { 0.0f };// UV units
+    float m_MaxNmlDeg { 0.0f };
+    float m_MaxTanDeg { 0.0f };
+  };
+
+  /// @brief packs src into dst (same size) and fills in how to unpack it
+  /// @param tangentSigns bitangent sign per vertex, +1 for all when empty
+  vertexQuantizeError quantizeVertices
+  (
+    std::span<const VTX_3D_UV_NML_TAN> src,
+    std::span<const float> tangentSigns,
+    std::span<VTX_3D_UV_NML_TAN_Q16> dst,
+    VTX_DEQUANT& outDequant
+  );
+
+  /// @brief the shader side of quantizeVertices, for checks and CPU readback
+  VTX_3D_UV_NML_TAN dequantizeVertex(VTX_3D_UV_NML_TAN_Q16 const& src, VTX_DEQUANT const& dequant) noexcept;
+}
+
+#endif//UTILITY_VERTEX_QUANTIZER_HELPER_HEADER
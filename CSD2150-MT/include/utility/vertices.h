@@ -11,6 +11,7 @@
 #define UTILITY_VERTICES_HELPER_HEADER
 
 #include <glm/glm.hpp>
+#include <cstdint>
 
 struct VTX_2D_UV    { glm::vec2 m_Pos; glm::vec2 m_Tex; };
 struct VTX_2D_RGB   { glm::vec2 m_Pos; glm::vec3 m_Col; };
@@ -23,8 +24,29 @@ struct VTX_3D_UV_NML_TAN
   glm::vec3 m_Nml;
   glm::vec3 m_Tan;
 };
+// 20 byte VTX_3D_UV_NML_TAN, decoded with the mesh's VTX_DEQUANT
+struct VTX_3D_UV_NML_TAN_Q16
+{
+  int16_t   m_Pos[4];// snorm16 xyz over the mesh bounds, w = bitangent sign
+  uint16_t  m_Tex[2];// unorm16 over the mesh's UV bounds
+  int16_t   m_Nml[2];// snorm16 octahedral
+  int16_t   m_Tan[2];// snorm16 octahedral
+};
+// std140 friendly, pos = offset + snorm * scale, uv = offset + unorm * scale
+struct VTX_DEQUANT
+{
+  glm::vec4 m_PosOffset     { 0.0f, 0.0f, 0.0f, 0.0f };
+  glm::vec4 m_PosScale      { 1.0f, 1.0f, 1.0f, 1.0f };
+  glm::vec4 m_TexOffsetScale{ 0.0f, 0.0f, 1.0f, 1.0f };// xy offset, zw scale
+};
 struct VTX_3D_RGB   { glm::vec3 m_Pos; glm::vec3 m_Col; };
 struct VTX_3D_RGBA  { glm::vec3 m_Pos; glm::vec4 m_Col; };
+// per instance, read from the instance rate binding (see vulkanInstanceBuffer)
+struct VTX_INSTANCE
+{
+  glm::mat4 m_M2W;
+  uint32_t  m_MaterialID;
+};
 // todo: add VTX_XD_UV_XXXX
 
 #endif//UTILITY_VERTICES_HELPER_HEADER
@@ -17,6 +17,8 @@ struct vulkanBuffer
 
   static constexpr VkFlags s_BufferUsage_Staging{ VK_BUFFER_USAGE_TRANSFER_SRC_BIT };
   static constexpr VkFlags s_MemPropFlag_Staging{ VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+  // for staging the CPU also reads back while filling (e.g. accumulating)
+  static constexpr VkFlags s_MemPropFlag_StagingCached{ s_MemPropFlag_Staging | VK_MEMORY_PROPERTY_HOST_CACHED_BIT };
 
   static constexpr VkFlags s_BufferUsage_Vertex{ VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT };
   static constexpr VkFlags s_MemPropFlag_Vertex{ VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
@@ -24,6 +26,18 @@ struct vulkanBuffer
   static constexpr VkFlags s_BufferUsage_Index{ VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT };
   static constexpr VkFlags s_MemPropFlag_Index{ VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
 
+  // rewritten by the CPU every frame, read once by the GPU
+  static constexpr VkFlags s_BufferUsage_Instance{ VK_BUFFER_USAGE_VERTEX_BUFFER_BIT };
+  static constexpr VkFlags s_MemPropFlag_Instance{ VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+
+  // draw commands + counts, written by the CPU or a compute pass
+  static constexpr VkFlags s_BufferUsage_Indirect{ VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT };
+  static constexpr VkFlags s_MemPropFlag_Indirect{ VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+
+  // compute shader input the CPU rewrites (cull objects)
+  static constexpr VkFlags s_BufferUsage_Storage{ VK_BUFFER_USAGE_STORAGE_BUFFER_BIT };
+  static constexpr VkFlags s_MemPropFlag_Storage{ VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+
   static constexpr VkFlags s_BufferUsage_Uniform{ VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT };
   static constexpr VkFlags s_MemPropFlag_Uniform{ VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
 
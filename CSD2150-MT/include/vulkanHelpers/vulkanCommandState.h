@@ -0,0 +1,90 @@
+/*!*****************************************************************************
+ * @file    vulkanCommandState.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanCommandState struct, what a
+ *          command buffer has bound so far. Binds and dynamic state that
+ *          match it are not recorded again.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_COMMAND_STATE_HELPER_HEADER
+#define VULKAN_COMMAND_STATE_HELPER_HEADER
+
+#include <array>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+struct vulkanCommandState
+{
+  enum E_COMMAND
+  {
+    E_BIND_PIPELINE = 0,
+    E_BIND_DESCRIPTOR_SETS,
+    E_BIND_VERTEX_BUFFER,
+    E_BIND_INDEX_BUFFER,
+    E_SET_VIEWPORT,
+    E_SET_SCISSOR,
+    E_NUM_COMMANDS
+  };
+
+  struct stats
+  {
+    std::array<uint32_t, E_NUM_COMMANDS> m_Issued {};
+    std::array<uint32_t, E_NUM_COMMANDS> m_Skipped{};
+
+    uint32_t getIssued() const noexcept;
+    uint32_t getSkipped() const noexcept;
+  };
+
+  static constexpr uint32_t s_NumBindPoints     { 2 };// graphics, compute
+  static constexpr uint32_t s_MaxSets           { 4 };// maxBoundDescriptorSets minimum
+  static constexpr uint32_t s_MaxVertexBindings { 4 };
+
+  struct bindPointState
+  {
+    VkPipeline                                  m_Pipeline{ VK_NULL_HANDLE };
+    VkPipelineLayout                            m_Layout  { VK_NULL_HANDLE };// of the sets
+    std::array<VkDescriptorSet, s_MaxSets>      m_Sets    {};
+  };
+
+  VkCommandBuffer                               m_CommandBuffer { VK_NULL_HANDLE };
+  std::array<bindPointState, s_NumBindPoints>   m_BindPoints    {};
+  std::array<VkBuffer, s_MaxVertexBindings>     m_VertexBuffers {};
+  std::array<VkDeviceSize, s_MaxVertexBindings> m_VertexOffsets {};
+  VkBuffer                                      m_IndexBuffer   { VK_NULL_HANDLE };
+  VkDeviceSize                                  m_IndexOffset   { 0 };
+  VkIndexType                                   m_IndexType     { VK_INDEX_TYPE_MAX_ENUM };
+  VkViewport                                    m_Viewport      {};
+  VkRect2D                                      m_Scissor       {};
+  bool                                          m_bViewport     { false };
+  bool                                          m_bScissor      { false };
+  stats                                         m_Stats         {};
+
+  /// @brief forgets everything bound, after vkBeginCommandBuffer or
+  ///        anything else that leaves the state undefined (vkCmdExecuteCommands)
+  void reset() noexcept;
+
+  /// @brief FCB's binds go through State until unregistered. Only call
+  ///        while nothing is being recorded, lookups aren't locked.
+  static void registerState(VkCommandBuffer FCB, vulkanCommandState& State);
+  static void unregisterState(VkCommandBuffer FCB) noexcept;
+
+  /// @return FCB's state, nullptr if it has none (one time submits)
+  static vulkanCommandState* find(VkCommandBuffer FCB) noexcept;
+
+  // recorded only if they differ from FCB's state, always for untracked ones
+
+  static void bindPipeline(VkCommandBuffer FCB, VkPipelineBindPoint bindPoint, VkPipeline pipeline);
+  static void bindDescriptorSets(VkCommandBuffer FCB, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* pSets);
+  static void bindVertexBuffer(VkCommandBuffer FCB, uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0);
+  static void bindIndexBuffer(VkCommandBuffer FCB, VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+  static void setViewport(VkCommandBuffer FCB, VkViewport const& viewport);
+  static void setScissor(VkCommandBuffer FCB, VkRect2D const& scissor);
+
+  /// @brief vkCmdExecuteCommands, FCB's state is undefined after so it's reset
+  static void executeCommands(VkCommandBuffer FCB, uint32_t commandBufferCount, const VkCommandBuffer* pCommandBuffers);
+};
+
+#endif//VULKAN_COMMAND_STATE_HELPER_HEADER
@@ -0,0 +1,45 @@
+/*!*****************************************************************************
+ * @file    vulkanComputePipeline.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanComputePipeline struct, one
+ *          compute shader with a single descriptor set layout (one descriptor
+ *          per binding) and a push constant block.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_COMPUTE_PIPELINE_HELPER_HEADER
+#define VULKAN_COMPUTE_PIPELINE_HELPER_HEADER
+
+#include <vulkan/vulkan.h>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+struct vulkanComputePipeline
+{
+  struct setup
+  {
+    std::string_view              m_PathShaderComp  {};
+    std::vector<VkDescriptorType> m_Bindings        {};// binding i is m_Bindings[i]
+    uint32_t                      m_SetCount        { 1 };// usually one per frame resource
+    uint32_t                      m_PushConstantSize{ 0 };
+  };
+
+  // what binding i of a set points at, must match the setup's type
+  using descriptorInfo = std::variant<VkDescriptorBufferInfo, VkDescriptorImageInfo>;
+
+  VkDescriptorSetLayout         m_DescriptorSetLayout { VK_NULL_HANDLE };
+  VkPipelineLayout              m_PipelineLayout      { VK_NULL_HANDLE };
+  VkPipeline                    m_Pipeline            { VK_NULL_HANDLE };
+  std::vector<VkDescriptorSet>  m_DescriptorSets      {};
+  std::vector<VkDescriptorType> m_Bindings            {};
+  uint32_t                      m_PushConstantSize    { 0 };
+
+  /// @brief binds the pipeline and set setIndex for dispatches
+  void bind(VkCommandBuffer FCB, uint32_t setIndex) const;
+  void pushConstant(VkCommandBuffer FCB, void const* pData) const;// m_PushConstantSize bytes
+};
+
+#endif//VULKAN_COMPUTE_PIPELINE_HELPER_HEADER
@@ -59,6 +59,9 @@ public: // just realease it... I don't know why everything must touch each other
     using bitfield = intptr_t;  // bitfield size match ptr size
 
     bitfield isCreated : 1; // has this already been created?
+    bitfield hasIndexTypeUint8 : 1; // VK_EXT_index_type_uint8 enabled
+    bitfield hasMultiDrawIndirect : 1; // drawCount > 1 in vkCmdDraw*Indirect
+    bitfield hasDrawIndirectCount : 1; // vkCmdDraw*IndirectCount (1.2 feature)
 
 };
 
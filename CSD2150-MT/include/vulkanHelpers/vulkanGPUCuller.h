@@ -0,0 +1,115 @@
+/*!*****************************************************************************
+ * @file    vulkanGPUCuller.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanGPUCuller struct, a compute
+ *          pass (shaderCull.comp) that frustum culls, and optionally
+ *          occlusion culls against a vulkanHiZ, an array of MTU::cullObject
+ *          and writes the survivors into a reserved vulkanIndirectBuffer
+ *          batch, recorded before the render pass.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_GPU_CULLER_HELPER_HEADER
+#define VULKAN_GPU_CULLER_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <vulkan/vulkan.h>
+#include <utility/objectCuller.h>
+#include <vulkanHelpers/vulkanBuffer.h>
+#include <vulkanHelpers/vulkanComputePipeline.h>
+#include <vulkanHelpers/vulkanIndirectBuffer.h>
+#include <vulkanHelpers/vulkanHiZ.h>
+
+struct vulkanGPUCuller
+{
+  static constexpr uint32_t s_GroupSize{ 64 };// local_size_x of shaderCull.comp
+
+  // shaderCull.comp's View uniform block (std140)
+  struct cullView
+  {
+    glm::vec4   m_Planes[MTU::frustum::E_NUM_PLANES];
+    glm::mat4   m_HiZW2V;
+    glm::ivec4  m_HiZInfo;// depth width, depth height, levels, occlusion on
+  };
+  static_assert(sizeof(cullView) == 176);
+
+  // shaderCull.comp's push constants
+  struct cullConstants
+  {
+    uint32_t  m_FirstObject;
+    uint32_t  m_ObjectCount;
+    uint32_t  m_FirstWord;
+    uint32_t  m_CountWord;
+    uint32_t  m_Compact;
+  };
+
+  // what a cull wrote, for verify
+  struct cullRecord
+  {
+    uint32_t      m_FirstObject { 0 };
+    uint32_t      m_ObjectCount { 0 };
+    uint32_t      m_FirstCommand{ 0 };
+    uint32_t      m_CountWord   { 0 };// uint index of the batch's count
+    bool          m_bCompact    { false };
+  };
+
+  // everything a frame's culls share
+  struct frameState
+  {
+    MTU::frustum            m_Frustum       {};
+    bool                    m_bOcclusion    { false };
+    uint32_t                m_HiZGeneration { UINT32_MAX };// vulkanHiZ::m_Generation its set points at
+    std::vector<cullRecord> m_Culls         {};
+  };
+
+  vulkanComputePipeline           m_Pipeline    {};
+  vulkanHiZ const*                m_pHiZ        { nullptr };
+  vulkanIndirectBuffer const*     m_pIndirect   { nullptr };
+  std::vector<vulkanBuffer>       m_Buffers     {};// objects, one per frame
+  std::vector<MTU::cullObject*>   m_pMapped     {};// mapped for the buffer's whole life
+  std::vector<vulkanBuffer>       m_ViewBuffers {};// cullView, one per frame
+  std::vector<cullView*>          m_pViews      {};
+  std::vector<frameState>         m_Frames      {};
+  uint32_t                        m_MaxObjects  { 0 };
+
+  /// @param Indirect the buffer culls will write to, one set per its frames
+  /// @param HiZ the pyramid occlusion tests read, must outlive the culler
+  bool createGPUCuller(std::string_view const& shaderPath, uint32_t maxObjects, vulkanIndirectBuffer const& Indirect, vulkanHiZ const& HiZ);
+  void destroyGPUCuller();
+
+  /// @brief sets what every cull of frameIndex tests against, after verify
+  ///        and vulkanHiZ::update, before the frame's first cull
+  /// @param bOcclusion also test against the Hi-Z, only used once it is built
+  bool beginFrame(uint32_t frameIndex, MTU::frustum const& worldFrustum, bool bOcclusion);
+
+  /// @brief this frame's objects, only write after FrameBegin has waited
+  ///        on the frame's fence (and after verify)
+  std::span<MTU::cullObject> getObjects(uint32_t frameIndex);
+
+  /// @brief reserves a batch in Indirect and records the cull dispatch of
+  ///        objects [firstObject, firstObject + objectCount) and its
+  ///        barriers, must be outside a render pass
+  /// @return the batch to vulkanIndirectBuffer::draw, UINT32_MAX if full
+  uint32_t cull(VkCommandBuffer FCB, vulkanIndirectBuffer& Indirect, uint32_t firstObject, uint32_t objectCount);
+
+  /// @brief checks the draws frameIndex's culls produced against
+  ///        MTU::cullObjects, after its fence and before Indirect.begin or
+  ///        getObjects reuse the frame. Borderline objects are let through,
+  ///        with occlusion on only drawing a culled object is an error.
+  ///        The frame's records are consumed, so a frame that stops culling
+  ///        is never checked against draws it no longer writes.
+  /// @param outVisible objects the GPU let through
+  /// @return false if any object was culled differently
+  bool verify(vulkanIndirectBuffer const& Indirect, uint32_t frameIndex, uint32_t& outVisible);
+
+private:
+
+  bool writeDescriptors(uint32_t frameIndex);
+};
+
+#endif//VULKAN_GPU_CULLER_HELPER_HEADER
@@ -0,0 +1,46 @@
+/*!*****************************************************************************
+ * @file    vulkanGeometryArena.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanGeometryArena struct, one
+ *          vertex buffer and one index buffer that models sub-allocate
+ *          ranges from, so every model in it draws off a single binding.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_GEOMETRY_ARENA_HELPER_HEADER
+#define VULKAN_GEOMETRY_ARENA_HELPER_HEADER
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+#include <utility/rangeAllocator.h>
+#include <vulkanHelpers/vulkanBuffer.h>
+
+struct vulkanGeometryArena
+{
+  vulkanBuffer        m_Buffer_Vertex {};
+  vulkanBuffer        m_Buffer_Index  {};
+  VkIndexType         m_IndexType     { VK_INDEX_TYPE_UINT32 };
+  uint32_t            m_VertexStride  { 0 };
+  MTU::rangeAllocator m_VertexRanges  {};// in vertices
+  MTU::rangeAllocator m_IndexRanges   {};// in indices
+
+  /// @param vertexStride every model in the arena has this vertex layout
+  /// @param indexType VK_INDEX_TYPE_UINT16 or VK_INDEX_TYPE_UINT32, models
+  ///        with narrower indices are widened on upload
+  bool createArena(uint32_t vertexCapacity, uint32_t vertexStride, uint32_t indexCapacity, VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+  void destroyArena();
+
+  /// @return false if either buffer is out of space, nothing is taken then
+  bool allocate(uint32_t vertexCount, uint32_t indexCount, uint32_t& outVertexOffset, uint32_t& outFirstIndex);
+  void free(uint32_t vertexOffset, uint32_t vertexCount, uint32_t firstIndex, uint32_t indexCount);
+
+  uint32_t getIndexSize() const noexcept;
+
+  /// @brief binds both buffers, once per command buffer is enough for every
+  ///        model in the arena (pipeline changes keep vertex/index bindings)
+  void bind(VkCommandBuffer FCB) const;
+};
+
+#endif//VULKAN_GEOMETRY_ARENA_HELPER_HEADER
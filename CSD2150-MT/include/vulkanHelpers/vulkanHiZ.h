@@ -0,0 +1,65 @@
+/*!*****************************************************************************
+ * @file    vulkanHiZ.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanHiZ struct, a max depth mip
+ *          chain built by compute (shaderHiZ.comp) from a vulkanWindow's
+ *          depth after its render pass, read by the next frame's culling.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_HI_Z_HELPER_HEADER
+#define VULKAN_HI_Z_HELPER_HEADER
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <vulkanHelpers/vulkanComputePipeline.h>
+
+class vulkanWindow;
+
+struct vulkanHiZ
+{
+  static constexpr uint32_t s_MaxLevels { 16 };// half of a 65536 wide depth buffer down to 1
+  static constexpr uint32_t s_GroupSize { 8 }; // local_size_x/y of shaderHiZ.comp
+  static constexpr VkFormat s_Format    { VK_FORMAT_R32_SFLOAT };
+
+  vulkanComputePipeline     m_Pipeline        {};// set i writes level i
+  vulkanWindow*             m_pWindow         { nullptr };// needs m_bDepthReadable
+  VkImage                   m_Image           { VK_NULL_HANDLE };
+  VkDeviceMemory            m_Memory          { VK_NULL_HANDLE };
+  VkImageView               m_View            { VK_NULL_HANDLE };// every level, for culling
+  std::vector<VkImageView>  m_LevelViews      {};
+  VkSampler                 m_Sampler         { VK_NULL_HANDLE };// nearest, only texelFetch is used
+  VkExtent2D                m_Extent          {};// level 0, half the depth buffer rounded up
+  uint32_t                  m_LevelCount      { 0 };
+  uint32_t                  m_DepthGeneration { 0 };// vulkanWindow::m_DepthGeneration it was made for
+  uint32_t                  m_Generation      { 0 };// bumped when remade, re-point descriptors then
+  glm::mat4                 m_W2V             { 1.0f };// world to clip of the depth it holds
+  bool                      m_bValid          { false };// built at least once since made
+
+  bool createHiZ(vulkanWindow& Window, std::string_view const& shaderPath);
+  void destroyHiZ();
+
+  /// @brief remakes the pyramid if the window's depth buffer was, call
+  ///        right after FrameBegin before anything records a read of it
+  bool update();
+
+  /// @brief records the downsample of this frame's depth, after
+  ///        vulkanWindow::RenderPassEnd
+  /// @param W2V the world to clip transform the depth was drawn with
+  void build(VkCommandBuffer FCB, glm::mat4 const& W2V);
+
+  /// @brief all levels, as a combined image sampler in GENERAL layout
+  VkDescriptorImageInfo getDescriptorInfo() const noexcept;
+
+private:
+
+  bool createPyramid();
+  void destroyPyramid();
+};
+
+#endif//VULKAN_HI_Z_HELPER_HEADER
@@ -0,0 +1,76 @@
+/*!*****************************************************************************
+ * @file    vulkanIndirectBuffer.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanIndirectBuffer struct, per
+ *          frame VkDrawIndexedIndirectCommand lists grouped into batches so
+ *          every draw sharing a pipeline goes out in one indirect call.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_INDIRECT_BUFFER_HELPER_HEADER
+#define VULKAN_INDIRECT_BUFFER_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+#include <vulkanHelpers/vulkanBuffer.h>
+
+struct vulkanIndirectBuffer
+{
+  struct batch
+  {
+    uint32_t m_FirstCommand { 0 };
+    uint32_t m_CommandCount { 0 };// appended by the CPU
+    uint32_t m_MaxCommands  { 0 };// reserved, a GPU writer may fill up to this
+  };
+
+  // layout per frame: m_MaxCommands commands, then m_MaxBatches uint32 counts
+  std::vector<vulkanBuffer>                   m_Buffers       {};// one per frame, the GPU may still read the others
+  std::vector<VkDrawIndexedIndirectCommand*>  m_pMapped       {};// mapped for the buffer's whole life
+  std::vector<batch>                          m_Batches       {};// this frame's
+  uint32_t                                    m_MaxCommands   { 0 };
+  uint32_t                                    m_MaxBatches    { 0 };
+  uint32_t                                    m_UsedCommands  { 0 };
+  uint32_t                                    m_FrameIndex    { 0 };
+  uint32_t                                    m_MaxDrawCount  { 1 };// per vkCmd call, see windowHandler::getMaxDrawIndirectCount
+  bool                                        m_bDrawCount    { false };// count read from the buffer
+
+  /// @param frameCount one buffer per frame resource (vulkanWindow::m_FramesInFlight)
+  bool createIndirectBuffer(uint32_t maxCommands, uint32_t maxBatches, uint32_t frameCount);
+  void destroyIndirectBuffer();
+
+  /// @brief drops last use of frameIndex's list, only call after FrameBegin
+  ///        has waited on the frame's fence
+  void begin(uint32_t frameIndex);
+
+  /// @brief starts a new batch, appends go to it until the next beginBatch
+  /// @param reserveCommands slots kept for a GPU writer, or so the batch
+  ///        records the same draw however many the CPU appends. 0 for CPU
+  ///        only.
+  /// @return the batch index or UINT32_MAX when out of room
+  uint32_t beginBatch(uint32_t reserveCommands = 0);
+
+  /// @return false when the buffer is full, the command is dropped
+  bool append(VkDrawIndexedIndirectCommand const& command);
+
+  /// @brief the commands of a batch, reserved slots included
+  std::span<VkDrawIndexedIndirectCommand> getCommands(uint32_t batchIndex);
+
+  /// @brief byte offsets of a batch's first command and its count
+  VkDeviceSize getCommandOffset(uint32_t batchIndex) const;
+  VkDeviceSize getCountOffset(uint32_t batchIndex) const;
+
+  /// @brief true if draw takes a batch of maxCommands' count from the
+  ///        buffer, else every slot is drawn and unused ones need 0 instances
+  bool readsDrawCount(uint32_t maxCommands) const noexcept;
+
+  /// @brief issues every command of the batch, bind the pipeline and mesh
+  ///        buffers first. One vkCmd call unless the device lacks
+  ///        multiDrawIndirect (then one per command).
+  void draw(VkCommandBuffer FCB, uint32_t batchIndex) const;
+};
+
+#endif//VULKAN_INDIRECT_BUFFER_HELPER_HEADER
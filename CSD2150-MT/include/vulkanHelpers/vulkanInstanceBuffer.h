@@ -0,0 +1,40 @@
+/*!*****************************************************************************
+ * @file    vulkanInstanceBuffer.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanInstanceBuffer struct, per
+ *          frame VTX_INSTANCE arrays the app writes straight into, bound at
+ *          the instance rate binding of instanced pipelines.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_INSTANCE_BUFFER_HELPER_HEADER
+#define VULKAN_INSTANCE_BUFFER_HELPER_HEADER
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+#include <utility/vertices.h>
+#include <vulkanHelpers/vulkanBuffer.h>
+
+struct vulkanInstanceBuffer
+{
+  std::vector<vulkanBuffer>   m_Buffers     {};// one per frame, the GPU may still read the others
+  std::vector<VTX_INSTANCE*>  m_pMapped     {};// mapped for the buffer's whole life
+  uint32_t                    m_MaxInstances{ 0 };
+
+  /// @param frameCount one buffer per frame resource (vulkanWindow::m_FramesInFlight)
+  bool createInstanceBuffer(uint32_t maxInstances, uint32_t frameCount);
+  void destroyInstanceBuffer();
+
+  /// @brief this frame's instances, only write after FrameBegin has waited
+  ///        on the frame's fence
+  std::span<VTX_INSTANCE> getInstances(uint32_t frameIndex);
+
+  /// @brief binds frameIndex's buffer to vulkanPipeline::s_InstanceBinding
+  void bind(VkCommandBuffer FCB, uint32_t frameIndex) const;
+};
+
+#endif//VULKAN_INSTANCE_BUFFER_HELPER_HEADER
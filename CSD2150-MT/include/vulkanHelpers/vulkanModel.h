@@ -11,27 +11,129 @@
 #define VULKAN_MODEL_HELPER_HEADER
 
 #include <string_view>
+#include <cstddef>
+#include <span>
 #include <vulkan/vulkan.h>
 #include <utility/vertices.h>
+#include <utility/meshlets.h>
+#include <utility/meshSimplifier.h>
+#include <utility/objectCuller.h>
+#include <utility/bounds.h>
+#include <utility/occlusionBuffer.h>
 #include <vulkanHelpers/vulkanBuffer.h>
+#include <vulkanHelpers/vulkanGeometryArena.h>
+#include <vulkanHelpers/vulkanIndirectBuffer.h>
 
 struct vulkanModel
 {
+  struct loadSettings
+  {
+    bool m_bOptimizeMesh{ false };// cache/overdraw/fetch reorder after import
+    bool m_bQuantize    { false };// VTX_3D_UV_NML_TAN_Q16, see m_Dequant
+    bool m_bGenerateLODs{ false };// simplified index ranges, see selectLOD
+    bool m_bOccluder    { false };// keep a low poly copy on the CPU, see m_Occluder
+
+    vulkanGeometryArena* m_pArena{ nullptr };// sub-allocate instead of owning buffers, not cooked
+  };
+
   vulkanBuffer  m_Buffer_Vertex;
   vulkanBuffer  m_Buffer_Index;
+  vulkanGeometryArena* m_pArena{ nullptr };// buffers above stay empty if set
+  uint32_t      m_VertexOffset{ 0 };       // first vertex inside the arena
+  uint32_t      m_FirstIndex{ 0 };         // first index inside the arena
   VkIndexType   m_IndexType { VK_INDEX_TYPE_NONE_KHR };
   uint32_t      m_VertexCount{ 0 };
   uint32_t      m_IndexCount{ 0 };
+  VTX_DEQUANT   m_Dequant{};// set as a vertex uniform when drawing Q16 vertices
+
+  MTU::meshletCuller            m_MeshletCuller{};
+  std::vector<MTU::indexRange>  m_VisibleRanges{};      // last drawCulled/appendCulled's ranges
+  uint32_t                      m_LastDrawnIndexCount{ 0 };
+
+  std::vector<MTU::meshLOD>     m_LODs{};             // 0 is full detail, all share the buffers
+  uint32_t                      m_CurrentLOD{ 0 };    // drawn by draw/drawCulled
+  glm::vec4                     m_BoundingSphere{ 0 };// model space center, radius in w
+  MTU::aabb                     m_AABB{};             // model space, every vertex
+  MTU::occluderMesh             m_Occluder{};         // model space, empty unless loaded as one
 
+  // arena models expect vulkanGeometryArena::bind to have been called,
+  // the others bind their own buffers every draw
   void drawVerts(VkCommandBuffer FCB);  // draw by vertex buffer only
   void drawIndexed(VkCommandBuffer FCB);// draw by indexed vertices
   void drawInit(VkCommandBuffer FCB);   // initialize which draw fn to use
   void draw(VkCommandBuffer FCB);       // the draw interface
+  /// @brief draws the current LOD instanceCount times in one call, the
+  ///        pipeline reads each instance from its instance rate binding
+  ///        (see vulkanInstanceBuffer, bound by the app)
+  void drawInstanced(VkCommandBuffer FCB, uint32_t instanceCount, uint32_t firstInstance = 0);
+  /// @brief draws only the meshlets inside the frustum and facing the camera,
+  ///        one vkCmdDrawIndexed per run of neighbouring visible meshlets.
+  ///        Falls back to draw for models without meshlets.
+  /// @param M2Clip model to clip space (the vertex push constant)
+  /// @param localCamPos camera position in model space
+  void drawCulled(VkCommandBuffer FCB, glm::mat4 const& M2Clip, glm::vec3 const& localCamPos);
   void (vulkanModel::* m_pFnDraw)(VkCommandBuffer) { &vulkanModel::drawInit };
 
-  bool load3DUVModel(std::string_view const&);
+  // indirect path, the commands of one vulkanIndirectBuffer batch all read
+  // the same bound buffers, so only models of one arena can share a batch.
+  // Indexed models only.
+
+  /// @brief drawCulled into the open batch of Indirect, one command per run
+  ///        of neighbouring visible meshlets (the whole LOD without meshlets)
+  /// @param firstInstance the model's slot of the bound instance buffer
+  /// @return false if the batch ran out of room
+  bool appendCulled(vulkanIndirectBuffer& Indirect, glm::mat4 const& M2Clip, glm::vec3 const& localCamPos, uint32_t firstInstance = 0);
+  /// @brief the most commands appendCulled appends at any LOD, reserve this
+  ///        many so the batch records the same draw every frame
+  uint32_t getMaxCulledCommands() const noexcept;
+  /// @brief drawInstanced into the open batch of Indirect
+  bool appendInstanced(vulkanIndirectBuffer& Indirect, uint32_t instanceCount, uint32_t firstInstance = 0);
+  /// @brief the whole of LOD (index into m_LODs) as one object for
+  ///        vulkanGPUCuller, indexed models only
+  MTU::cullObject getCullObject(glm::mat4 const& M2W, uint32_t LOD, uint32_t instanceID = 0) const;
+
+  /// @brief picks the coarsest LOD whose simplification error projects to
+  ///        at most pixelError pixels at the nearest point of the model
+  /// @param M2Clip model to clip space
+  /// @param viewportHeight in pixels
+  /// @return the LOD that draw/drawCulled will use
+  uint32_t selectLOD(glm::mat4 const& M2Clip, float viewportHeight, float pixelError = 1.0f);
+
+  /// @brief imports through assimp, or the cooked mesh cache beside the file
+  ///        if the source and import flags haven't changed since. .obj files
+  ///        go to loadStreamedOBJ instead, unless Settings asks for more.
+  bool load3DUVModel(std::string_view const&, loadSettings const& Settings = {});
+
+  struct loadRequest
+  {
+    vulkanModel*      m_pModel  { nullptr };
+    std::string_view  m_Path    {};
+    loadSettings      m_Settings{};
+  };
+
+  /// @brief load3DUVModel for many models at once, the imports run on a
+  ///        thread pool and all the uploads share one staging buffer and
+  ///        one submit. .obj files take the cooked path here.
+  /// @param numThreads 0 for one per hardware thread, never more than models
+  /// @return false if any model failed, none of them are loaded then
+  static bool loadModels(std::span<const loadRequest> Requests, size_t numThreads = 0);
+
+  /// @brief OBJ only, parsed straight into staging buffers without any
+  ///        intermediate vertex/index copies (see MTU::streamOBJ)
+  bool loadStreamedOBJ(std::string_view const&);
+  /// @brief creates the device buffers from final vertex and index bytes
+  /// @param indexSize bytes per index (1, 2 or 4)
+  bool uploadMesh(std::span<const std::byte> vertexBytes, uint32_t vertexCount, std::span<const std::byte> indexBytes, uint32_t indexCount, uint32_t indexSize);
+  /// @brief sets the counts and index type, creates the empty device buffers
+  ///        or takes ranges out of pArena (indices use the arena's type then)
+  bool createMeshBuffers(uint32_t vertexCount, uint32_t vertexStride, uint32_t indexCount, uint32_t indexSize, vulkanGeometryArena* pArena = nullptr);
+
   void destroyModel();
 
+private:
+
+  void bindMeshBuffers(VkCommandBuffer FCB);// no-op for arena models
+
 };
 
 #endif//VULKAN_MODEL_HELPER_HEADER
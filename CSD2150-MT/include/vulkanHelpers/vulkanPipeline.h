@@ -67,6 +67,7 @@ struct vulkanPipeline
     AOS_XY_RGBA_F32,
     AOS_XYZ_UV_F32,
     AOS_XYZ_UV_NML_TAN_F32,
+    AOS_XYZ_UV_NML_TAN_Q16,// VTX_3D_UV_NML_TAN_Q16, needs VTX_DEQUANT at set 0
     AOS_XYZ_RGB_F32,
     AOS_XYZ_RGBA_F32,
     
@@ -77,10 +78,21 @@ struct vulkanPipeline
     //SOA_XYZ_RGBA_F32
   };
 
+  // second vertex binding, advanced once per instance instead of per vertex
+  enum class E_INSTANCE_BINDING_MODE
+  {
+    NONE,
+
+    M2W_MATERIAL,// VTX_INSTANCE, mat4 at s_InstanceLocation..+3, uint after
+  };
+  static constexpr uint32_t s_InstanceBinding { 1 };
+  static constexpr uint32_t s_InstanceLocation{ 8 };// past every vertex layout
+
   struct setup
   {
     // vertex input data
     E_VERTEX_BINDING_MODE m_VertexBindingMode{ E_VERTEX_BINDING_MODE::UNDEFINED };
+    E_INSTANCE_BINDING_MODE m_InstanceBindingMode{ E_INSTANCE_BINDING_MODE::NONE };
 
     // shader paths
     std::string_view m_PathShaderVert{  };
@@ -120,7 +132,7 @@ struct vulkanPipeline
   // vector of descriptorsets arrays, each element of the vector is per frame 
 
   std::array<VkPipelineShaderStageCreateInfo, 2>    m_ShaderStages        {};
-  std::array<VkVertexInputBindingDescription, 1>    m_BindingDescription  {};
+  std::vector<VkVertexInputBindingDescription>      m_BindingDescription  {};
   std::vector<VkVertexInputAttributeDescription>    m_AttributeDescription{};
   VkPipelineVertexInputStateCreateInfo              m_VertexInputInfo     {};
   VkPipelineInputAssemblyStateCreateInfo            m_InputAssembly       {};
@@ -0,0 +1,140 @@
+/*!*****************************************************************************
+ * @file    vulkanRenderQueue.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanRenderQueue struct, draws
+ *          submitted in any order are radix sorted by a 64 bit state key
+ *          and recorded binding only the state that changes between them.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_RENDER_QUEUE_HELPER_HEADER
+#define VULKAN_RENDER_QUEUE_HELPER_HEADER
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+#include <utility/radixSort.h>
+#include <utility/threadPool.h>
+#include <vulkanHelpers/vulkanPipeline.h>
+#include <vulkanHelpers/vulkanIndirectBuffer.h>
+#include <vulkanHelpers/vulkanInstanceBuffer.h>
+#include <vulkanHelpers/vulkanGeometryArena.h>
+#include <vulkanHelpers/vulkanSecondaryCommands.h>
+
+class vulkanWindow;
+
+struct vulkanRenderQueue
+{
+  using descriptorSets = std::array<VkDescriptorSet, 2>;// vertex, fragment like vulkanPipeline
+
+  struct drawItem
+  {
+    vulkanPipeline*             m_pPipeline   { nullptr };
+    descriptorSets              m_Material    { VK_NULL_HANDLE, VK_NULL_HANDLE };// null for the pipeline's own
+    vulkanInstanceBuffer const* m_pInstances  { nullptr };// bound at vulkanPipeline::s_InstanceBinding
+    vulkanGeometryArena const*  m_pArena      { nullptr };// null for the one given to record, must hold m_Batch's meshes
+    uint32_t                    m_Batch       { UINT32_MAX };// the mesh, a vulkanIndirectBuffer batch
+    float                       m_Depth       { 0.0f };// distance from the camera, any unit
+    bool                        m_bTranslucent{ false };// drawn after opaques, back to front
+  };
+
+  // key bits, opaque:      0 | pipeline 15 | material 16 | depth 32
+  //           translucent: 1 | ~depth 32   | pipeline 15 | material 16
+  static constexpr uint32_t s_MaxPipelines{ 1u << 15 };
+  static constexpr uint32_t s_MaxMaterials{ 1u << 16 };
+  static constexpr uint32_t s_MinChunkItems{ 64 };// per secondary in recordParallel
+
+  struct materialHash
+  {
+    size_t operator()(descriptorSets const& Sets) const noexcept;
+  };
+
+  // a run of sorted items with the same pipeline, recorded on its own
+  struct replayGroup
+  {
+    vulkanSecondaryCommands m_Commands  {};
+    std::vector<std::byte>  m_Signature {};// what m_Commands was recorded from
+  };
+
+  // ids handed out on first record and kept, so keys stay the same over frames
+  std::unordered_map<vulkanPipeline*, uint32_t>               m_PipelineIDs   {};
+  std::unordered_map<descriptorSets, uint32_t, materialHash>  m_MaterialIDs   {};
+  std::vector<drawItem>                                       m_Items         {};// this frame's
+  std::vector<uint32_t>                                       m_ItemPushes    {};// first push of each item, one past the end last
+  std::vector<VkPushConstantRange>                            m_Pushes        {};// stage, offset into the layout, size
+  std::vector<uint32_t>                                       m_PushOffsets   {};// into m_PushData
+  std::vector<std::byte>                                      m_PushData      {};
+  std::vector<MTU::sortKey>                                   m_Keys          {};
+  std::vector<MTU::sortKey>                                   m_SortScratch   {};
+  std::vector<VkPipeline>                                     m_KeyPipelines  {};// of each sorted key
+  std::vector<std::unordered_map<uint64_t, replayGroup>>      m_Replays       {};// per frame resource, pipeline id << 32 | nth run of it
+  std::vector<uint32_t>                                       m_ReplayRuns    {};// runs seen this frame, per pipeline id
+  std::vector<std::byte>                                      m_SignatureScratch{};
+  uint32_t                                                    m_ReplaysRecorded{ 0 };
+  uint32_t                                                    m_ReplaysReused { 0 };
+  std::vector<vulkanSecondaryCommands>                        m_Workers       {};// m_WorkerCount per frame resource
+  std::vector<VkCommandBuffer>                                m_ExecuteBuffers{};// this frame's secondaries, in execution order
+  uint32_t                                                    m_WorkerCount   { 0 };
+  uint32_t                                                    m_ParallelItems { 0 };// the last recordParallel's
+  uint32_t                                                    m_ParallelChunks{ 0 };// secondaries those were split over
+
+  /// @brief drops the last frame's items, ids are kept
+  void clear() noexcept;
+
+  /// @brief queues a draw of Item.m_Batch, nothing is recorded until record.
+  ///        An item without a batch (beginBatch ran out) is skipped there.
+  void submit(drawItem const& Item);
+
+  /// @brief copies push constants for the last submitted item, pushed right
+  ///        before its draw like vulkanPipeline::pushConstant
+  void pushConstant(VkShaderStageFlags stageFlags, uint32_t offsetInto, uint32_t srcSize, const void* srcData);
+
+  /// @brief sorts the items and records them in the open render pass, a
+  ///        pipeline, material, instance buffer or arena is bound only when
+  ///        it differs from the item before (see vulkanCommandState)
+  /// @return how many items were drawn, items past the id limits are dropped
+  uint32_t record(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena);
+
+  /// @brief replay groups per frame resource, each group's secondary command
+  ///        buffer is created the first frame its run shows up
+  bool createReplay(vulkanWindow& Window);
+  void destroyReplay();
+
+  /// @brief like record, but each run of a pipeline goes into its own
+  ///        secondary command buffer of the frame, only re-recorded when what
+  ///        it would record changed (materials, buffers, push constants,
+  ///        batch slots). Data read at execution (indirect commands,
+  ///        instances, uniforms) may change without a re-record, so keep
+  ///        per draw matrices there instead of in push constants. The render
+  ///        pass must have begun with
+  ///        VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, the arenas are
+  ///        bound inside the replay.
+  /// @return true if every run's last recording was executed again
+  bool replay(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena);
+
+  /// @brief threadCount secondary command buffers, each with its own pool,
+  ///        per frame resource for recordParallel
+  bool createParallel(vulkanWindow& Window, uint32_t threadCount);
+  void destroyParallel();
+
+  /// @brief like record, but the sorted items are split into contiguous
+  ///        chunks recorded into secondaries on Pool and the calling thread,
+  ///        then executed in order. The render pass must have begun with
+  ///        VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, the arenas are
+  ///        bound inside each chunk.
+  /// @return how many items were drawn
+  uint32_t recordParallel(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena, MTU::threadPool& Pool);
+
+private:
+  void sortItems(vulkanWindow& Window);
+  uint32_t recordItems(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena, uint32_t firstKey, uint32_t lastKey) const;
+  void buildSignature(vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena, uint32_t firstKey, uint32_t lastKey);
+  uint32_t getPushEnd(uint32_t itemIndex) const noexcept;
+};
+
+#endif//VULKAN_RENDER_QUEUE_HELPER_HEADER
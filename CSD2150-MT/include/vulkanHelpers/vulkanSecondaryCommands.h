@@ -0,0 +1,43 @@
+/*!*****************************************************************************
+ * @file    vulkanSecondaryCommands.h
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the interface for the vulkanSecondaryCommands struct, a
+ *          secondary command buffer with its own pool that continues the
+ *          window's render pass, to be recorded once and executed often.
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#ifndef VULKAN_SECONDARY_COMMANDS_HELPER_HEADER
+#define VULKAN_SECONDARY_COMMANDS_HELPER_HEADER
+
+#include <memory>
+#include <vulkan/vulkan.h>
+#include <vulkanHelpers/vulkanDevice.h>
+#include <vulkanHelpers/vulkanCommandState.h>
+
+class vulkanWindow;
+
+// registered with vulkanCommandState by address, don't move once created
+struct vulkanSecondaryCommands
+{
+  std::shared_ptr<vulkanDevice> m_Device          {};
+  VkCommandPool                 m_VKCommandPool   { VK_NULL_HANDLE };
+  VkCommandBuffer               m_VKCommandBuffer { VK_NULL_HANDLE };
+  vulkanCommandState            m_CommandState    {};
+
+  bool createSecondaryCommands(vulkanWindow& Window);
+  void destroySecondaryCommands();
+
+  /// @brief resets the pool and starts recording draws for subpass 0 of the
+  ///        window's render pass, with its default viewport and scissor
+  ///        set (secondaries inherit no state). Only while the GPU is done
+  ///        with the last recording.
+  /// @return the command buffer, VK_NULL_HANDLE if it failed
+  VkCommandBuffer begin(vulkanWindow& Window);
+
+  bool end();
+};
+
+#endif//VULKAN_SECONDARY_COMMANDS_HELPER_HEADER
@@ -13,25 +13,43 @@
 #include <windowsHelpers/windowsWindow.h>
 #include <vulkanHelpers/vulkanDevice.h>
 #include <vulkanHelpers/vulkanPipeline.h>
+#include <vulkanHelpers/vulkanCommandState.h>
+#include <utility/framePacer.h>
 #include <vulkan/vulkan.h>
 #include <unordered_map>
 #include <memory>
 #include <array>
 
+// one per frame in flight, what the CPU records while the GPU has others
 struct vulkanFrame
 {
     VkCommandPool   m_VKCommandPool     {};
     VkCommandBuffer m_VKCommandBuffer   {};
     VkFence         m_VKFence           {};
+    vulkanCommandState m_CommandState   {};// what m_VKCommandBuffer has bound
+};
+
+// one per swapchain image
+struct vulkanBackBuffer
+{
     VkImage         m_VKBackBuffer      {};
     VkImageView     m_VKBackBufferView  {};
     VkFramebuffer   m_VKFramebuffer     {};
+    VkSemaphore     m_VKRenderCompleteSemaphore {};// present waits on it, so it's tied to the image
 };
 
+// one per frame in flight
 struct vulkanFrameSem
 {
     VkSemaphore     m_VKImageAcquiredSemaphore  {};
-    VkSemaphore     m_VKRenderCompleteSemaphore {};
+};
+
+// CPU time blocked in FrameBegin, milliseconds
+struct vulkanFrameWaits
+{
+    float           m_Pace                      { 0.0f };// frame rate cap
+    float           m_Fence                     { 0.0f };// GPU still on an older frame
+    float           m_Acquire                   { 0.0f };// no swapchain image free
 };
 
 struct vulkanPipelineData
@@ -43,6 +61,9 @@ class vulkanWindow
 {
 public:
 
+    static constexpr uint32_t s_MaxFramesInFlight{ 3 };
+    static constexpr uint64_t s_FenceTimeout{ 1'000'000'000 };// ns, warns and keeps waiting after
+
     vulkanWindow() = default;
     vulkanWindow(std::shared_ptr<vulkanDevice>& Device,
                  windowSetup const& Setup);
@@ -60,11 +81,28 @@ public:
 
     void toggleFullscreen() noexcept;
 
+    /// @brief FrameBegin waits until the GPU is at most this many submitted
+    ///        frames behind, clamped to 1..m_FramesInFlight. Fewer is less
+    ///        input latency, more keeps the GPU busy.
+    void setMaxQueuedFrames(uint32_t maxQueuedFrames) noexcept;
+
     /// @brief begin a frame, made similar to the way imgui does their calls,
     ///        must be called in order FrameBegin, FrameEnd, PageFlip
     ///        if FrameBegin returns false, don't end or pageFlip.
+    /// @param bBeginRenderPass false to record work that must happen outside
+    ///        the pass first (compute), then call RenderPassBegin
     /// @return command buffer if frame begin success, to send commands
-    VkCommandBuffer FrameBegin();
+    VkCommandBuffer FrameBegin(bool bBeginRenderPass = true);
+
+    /// @brief opens the frame's render pass and sets the default viewport,
+    ///        only after FrameBegin(false)
+    /// @param contents VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS if the
+    ///        pass will only execute secondaries (vulkanSecondaryCommands)
+    void RenderPassBegin(VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+
+    /// @brief closes the render pass early to record work after it (Hi-Z),
+    ///        FrameEnd closes it otherwise
+    void RenderPassEnd();
 
     /// @brief submits queues
     void FrameEnd();
@@ -80,6 +118,11 @@ public:
     // any created will be stored to be auto destroyed
     bool createAndSetPipeline(vulkanPipeline& pipelineCustomCreateInfo);
 
+    /// @brief the pipeline made from the info, created on first use like
+    ///        createAndSetPipeline but nothing is bound
+    /// @return VK_NULL_HANDLE if creation failed
+    VkPipeline getPipeline(vulkanPipeline& pipelineCustomCreateInfo);
+
     void setUniform(vulkanPipeline& inPipeline, uint32_t shaderTarget, uint32_t uniformTarget, void* pData, size_t dataLen);
 
 private:
@@ -110,19 +153,27 @@ public: // all public, let whoever touch it /shrug
     std::array<VkClearValue, 2>         m_VKClearValue          { VkClearValue{.color{.float32{ 0.0f, 0.0f, 0.0f, 1.0f } } }, VkClearValue{ .depthStencil{ 1.0f, 0 } } };
     VkSwapchainKHR                      m_VKSwapchain           {};
     uint32_t                            m_ImageCount            { 2 };// default double buffer
-    std::unique_ptr<vulkanFrame[]>      m_Frames                {};
-    std::unique_ptr<vulkanFrameSem[]>   m_FrameSemaphores       {};
+    uint32_t                            m_FramesInFlight        { 2 };// recorded ahead of the GPU, per frame resources
+    std::unique_ptr<vulkanBackBuffer[]> m_BackBuffers           {};// m_ImageCount
+    std::unique_ptr<vulkanFrame[]>      m_Frames                {};// m_FramesInFlight
+    std::unique_ptr<vulkanFrameSem[]>   m_FrameSemaphores       {};// m_FramesInFlight
     VkImage                             m_VKDepthbuffer         {};
     VkImageView                         m_VKDepthbufferView     {};
     VkDeviceMemory                      m_VKDepthbufferMemory   {};
+    VkExtent2D                          m_DepthExtent           {};
+    uint32_t                            m_DepthGeneration       { 0 };// bumped when the depth buffer is remade
     VkRenderPass                        m_VKRenderPass          {};
     //VkPipeline                          m_VKPipeline            {};
     std::unordered_map<vulkanPipeline*, vulkanPipelineData> m_VKPipelines{};
     VkSurfaceFormatKHR                  m_VKSurfaceFormat       {};
     VkFormat                            m_VKDepthFormat         {};
     VkPresentModeKHR                    m_VKPresentMode         {};
-    uint32_t                            m_SemaphoreIndex        { 0 };
-    uint32_t                            m_FrameIndex            { 0 };
+    uint32_t                            m_FrameIndex            { 0 };// into m_Frames and every per frame resource
+    uint32_t                            m_ImageIndex            { 0 };// the acquired swapchain image
+    vulkanCommandState::stats           m_CommandStats          {};// binds issued/skipped by the last ended frame
+    uint32_t                            m_MaxQueuedFrames       { 2 };
+    MTU::framePacer                     m_FramePacer            {};// frame rate cap, in FrameBegin
+    vulkanFrameWaits                    m_FrameWaits            {};// of the last FrameBegin
     //int                                 m_BeginState            { 0 };
     //int                                 m_nCmds                 { 0 };
     VkViewport                          m_DefaultViewport       {};
@@ -136,6 +187,9 @@ public: // all public, let whoever touch it /shrug
     bitfield                            m_bfRebuildSwapChain : 1{ 0 };
     bitfield                            m_bfInitializeOK : 1    { 0 };
     bitfield                            m_bfFrameBeginState : 2 { 0 };// unused in release
+    bitfield                            m_bfDepthReadable : 1   { 0 };// depth stored, DEPTH_STENCIL_READ_ONLY_OPTIMAL after the pass
+    bitfield                            m_bfRenderPassOpen : 1  { 0 };
+    bitfield                            m_bfRenderPassSecondary : 1{ 0 };// only secondaries may be executed in it
 
 };
 
@@ -13,6 +13,7 @@
 #include <windowsHelpers/windowsInput.h>
 #include <vulkanHelpers/printWarnings.h>
 #include <utility/windowsInclude.h>
+#include <cstdint>
 #include <tuple>
 
 struct windowSetup;  // put here to prevent include loops
@@ -90,6 +91,10 @@ struct windowSetup  // put here to prevent include loops
     bool m_bFullscreen{ false };
     bool m_bClearOnRender{ true };
     bool m_bSyncOn{ false };
+    bool m_bDepthReadable{ false };// keep depth after the pass for compute (Hi-Z)
+    uint32_t m_FramesInFlight{ 2 };// 2 or 3, more for throughput, less for latency
+    uint32_t m_MaxQueuedFrames{ 0 };// submitted frames the GPU may be behind by, 0 for m_FramesInFlight
+    float m_FrameRateCap{ 0.0f };// 0 for uncapped
     float m_ClearColorR{ 0.45f };
     float m_ClearColorG{ 0.45f };
     float m_ClearColorB{ 0.45f };
@@ -57,6 +57,22 @@ bool windowHandler::OK() const noexcept
   };
 }
 
+bool windowHandler::isIndexTypeUint8Supported() const noexcept
+{
+  return m_pVKDevice.get() != nullptr && m_pVKDevice->hasIndexTypeUint8;
+}
+
+uint32_t windowHandler::getMaxDrawIndirectCount() const noexcept
+{
+  if (m_pVKDevice.get() == nullptr || 0 == m_pVKDevice->hasMultiDrawIndirect)return 1;
+  return m_pVKDevice->m_VKPhysicalDeviceProperties.limits.maxDrawIndirectCount;
+}
+
+bool windowHandler::isDrawIndirectCountSupported() const noexcept
+{
+  return m_pVKDevice.get() != nullptr && m_pVKDevice->hasDrawIndirectCount;
+}
+
 bool windowHandler::processInputEvents()
 {
   for (MSG msg; PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE); DispatchMessage(&msg))
@@ -162,7 +178,7 @@ VkCommandBuffer windowHandler::beginOneTimeSubmitCommand(bool useMainCommandPool
   return retval;
 }
 
-void windowHandler::endOneTimeSubmitCommand(VkCommandBuffer toEnd, bool useMainCommandPool)
+bool windowHandler::endOneTimeSubmitCommand(VkCommandBuffer toEnd, bool useMainCommandPool)
 {
   VkCommandPool cmdPool{ useMainCommandPool ? m_pVKDevice->m_TransferCommandSpecialPool : m_pVKDevice->m_TransferCommandPool };
   auto& lockableQueue{ useMainCommandPool ? m_pVKDevice->m_VKMainQueue : m_pVKDevice->m_VKTransferQueue };
@@ -170,7 +186,7 @@ void windowHandler::endOneTimeSubmitCommand(VkCommandBuffer toEnd, bool useMainC
   {
     vkFreeCommandBuffers(m_pVKDevice->m_VKDevice, cmdPool, 1, &toEnd);
     printVKWarning(tmpRes, "failed to end transfer command buffer"sv, true);
-    return;
+    return false;
   }
   VkSubmitInfo SubmitInfo
   {
@@ -183,15 +199,16 @@ void windowHandler::endOneTimeSubmitCommand(VkCommandBuffer toEnd, bool useMainC
   {
     vkFreeCommandBuffers(m_pVKDevice->m_VKDevice, cmdPool, 1, &toEnd);
     printVKWarning(tmpRes, "failed to submit transfer queue"sv, true);
-    return;
+    return false;
   }
   if (VkResult tmpRes{ vkQueueWaitIdle(lockableQueue.get()) }; tmpRes != VK_SUCCESS)
   {
     vkFreeCommandBuffers(m_pVKDevice->m_VKDevice, cmdPool, 1, &toEnd);
     printVKWarning(tmpRes, "failed to wait for transfer queue"sv, true);
-    return;
+    return false;
   }
   vkFreeCommandBuffers(m_pVKDevice->m_VKDevice, cmdPool, 1, &toEnd);
+  return true;
 }
 
 bool windowHandler::writeToBuffer(vulkanBuffer& dstBuffer, std::vector<void*> const& srcs, std::vector<VkDeviceSize> const& srcLens)
@@ -238,27 +255,100 @@ bool windowHandler::writeToBuffer(vulkanBuffer& dstBuffer, std::vector<void*> co
   return retval;
 }
 
-bool windowHandler::copyBuffer(vulkanBuffer& dstBuffer, vulkanBuffer& srcBuffer, VkDeviceSize cpySize)
+bool windowHandler::copyBuffer(vulkanBuffer& dstBuffer, vulkanBuffer& srcBuffer, VkDeviceSize cpySize, VkDeviceSize srcOffset, VkDeviceSize dstOffset)
 {
   if (VkCommandBuffer transferCmdBuffer{ beginOneTimeSubmitCommand() }; transferCmdBuffer != VK_NULL_HANDLE)
   {
     VkBufferCopy copyRegion
     {
-      .srcOffset{ 0 },
-      .dstOffset{ 0 },
+      .srcOffset{ srcOffset },
+      .dstOffset{ dstOffset },
       .size{ cpySize }
     };
     vkCmdCopyBuffer(transferCmdBuffer, srcBuffer.m_Buffer, dstBuffer.m_Buffer, 1, &copyRegion);
-    endOneTimeSubmitCommand(transferCmdBuffer);
+    return endOneTimeSubmitCommand(transferCmdBuffer);
   }
-  return true;
+  return false;
+}
+
+bool windowHandler::copyBuffers(vulkanBuffer& srcBuffer, std::span<const bufferCopy> copies)
+{
+  if (copies.empty())return true;
+  if (VkCommandBuffer transferCmdBuffer{ beginOneTimeSubmitCommand() }; transferCmdBuffer != VK_NULL_HANDLE)
+  {
+    for (bufferCopy const& x : copies)
+    {
+      VkBufferCopy copyRegion
+      {
+        .srcOffset{ x.m_SrcOffset },
+        .dstOffset{ x.m_DstOffset },
+        .size{ x.m_Size }
+      };
+      vkCmdCopyBuffer(transferCmdBuffer, srcBuffer.m_Buffer, x.m_pDstBuffer->m_Buffer, 1, &copyRegion);
+    }
+    return endOneTimeSubmitCommand(transferCmdBuffer);
+  }
+  return false;
+}
+
+bool windowHandler::createStagingBuffer(vulkanBuffer& outBuffer, VkDeviceSize byteSize)
+{
+  // buffers are sized count * element, past 4GB count whole pages instead of bytes
+  static constexpr uint32_t s_StagingPage{ 65536 };
+  bool bPaged{ byteSize > UINT32_MAX };
+  if (bPaged && (byteSize + s_StagingPage - 1) / s_StagingPage > UINT32_MAX)
+  {
+    printWarning("staging buffer too large"sv, true);
+    return false;
+  }
+
+  vulkanBuffer::Setup stagingSetup
+  {
+    .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Staging },
+    .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Staging },
+    .m_Count{ static_cast<uint32_t>(bPaged ? (byteSize + s_StagingPage - 1) / s_StagingPage : byteSize) },
+    .m_ElemSize{ bPaged ? s_StagingPage : 1 }
+  };
+
+  // checked here instead of getMemoryType, not having cached memory is not an error
+  VkPhysicalDeviceMemoryProperties const& memProps{ m_pVKDevice->m_VKDeviceMemoryProperties };
+  for (uint32_t i{ 0 }; i < memProps.memoryTypeCount; ++i)
+  {
+    if ((memProps.memoryTypes[i].propertyFlags & vulkanBuffer::s_MemPropFlag_StagingCached) == vulkanBuffer::s_MemPropFlag_StagingCached)
+    {
+      // the cached type may not take staging buffers or may be out of room,
+      // plain host visible memory is still fine then
+      stagingSetup.m_MemPropFlag = vulkanBuffer::s_MemPropFlag_StagingCached;
+      if (createBuffer(outBuffer, stagingSetup))return true;
+      stagingSetup.m_MemPropFlag = vulkanBuffer::s_MemPropFlag_Staging;
+      break;
+    }
+  }
+
+  return createBuffer(outBuffer, stagingSetup);
+}
+
+void* windowHandler::mapBuffer(vulkanBuffer& inBuffer)
+{
+  void* retval{ nullptr };
+  if (VkResult tmpRes{ vkMapMemory(m_pVKDevice->m_VKDevice, inBuffer.m_BufferMemory, 0, VK_WHOLE_SIZE, 0, &retval) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Failed to map buffer"sv, true);
+    return nullptr;
+  }
+  return retval;
+}
+
+void windowHandler::unmapBuffer(vulkanBuffer& inBuffer)
+{
+  vkUnmapMemory(m_pVKDevice->m_VKDevice, inBuffer.m_BufferMemory);
 }
 
 bool windowHandler::createBuffer(vulkanBuffer& outBuffer, vulkanBuffer::Setup const& inSetup)
 {
   destroyBuffer(outBuffer);
 
-  if (uint32_t tmpSize{ inSetup.m_Count * inSetup.m_ElemSize }; tmpSize == 0)
+  if (VkDeviceSize tmpSize{ static_cast<VkDeviceSize>(inSetup.m_Count) * inSetup.m_ElemSize }; tmpSize == 0)
   {
     printWarning("Trying to make buffer of size 0"sv, true);
     return false;
@@ -333,12 +423,12 @@ void windowHandler::destroyBuffer(vulkanBuffer& inBuffer)
 
 bool windowHandler::setupVertexInputInfo(vulkanPipeline& outPipeline, vulkanPipeline::setup const& inSetup)
 {
-  outPipeline.m_BindingDescription[0] = VkVertexInputBindingDescription
+  outPipeline.m_BindingDescription.assign(1, VkVertexInputBindingDescription
   {
     .binding  { 0 },
     // stride dependant on mode
-    .inputRate{ VK_VERTEX_INPUT_RATE_VERTEX }// no instancing yet of course
-  };
+    .inputRate{ VK_VERTEX_INPUT_RATE_VERTEX }// instances get binding 1 below
+  });
   
   switch (inSetup.m_VertexBindingMode)
   {
@@ -434,6 +524,34 @@ bool windowHandler::setupVertexInputInfo(vulkanPipeline& outPipeline, vulkanPipe
       .offset   { offsetof(VTX_3D_UV_NML_TAN, m_Tan) }
     });
     break;
+  case vulkanPipeline::E_VERTEX_BINDING_MODE::AOS_XYZ_UV_NML_TAN_Q16:
+    outPipeline.m_BindingDescription[0].stride = static_cast<uint32_t>(sizeof(VTX_3D_UV_NML_TAN_Q16));
+    outPipeline.m_AttributeDescription.reserve(4);
+    outPipeline.m_AttributeDescription.emplace_back(VkVertexInputAttributeDescription{
+      .location { 0 },  // layout location 0, w is the bitangent sign
+      .binding  { 0 },  // bound buffer 0 (SOA)
+      .format   { VK_FORMAT_R16G16B16A16_SNORM },
+      .offset   { 0 }
+    });
+    outPipeline.m_AttributeDescription.emplace_back(VkVertexInputAttributeDescription{
+      .location { 1 },  // layout location 1
+      .binding  { 0 },  // bound buffer 0 (SOA)
+      .format   { VK_FORMAT_R16G16_UNORM },
+      .offset   { offsetof(VTX_3D_UV_NML_TAN_Q16, m_Tex) }
+    });
+    outPipeline.m_AttributeDescription.emplace_back(VkVertexInputAttributeDescription{
+      .location { 2 },  // layout location 2, octahedral
+      .binding  { 0 },  // bound buffer 0 (SOA)
+      .format   { VK_FORMAT_R16G16_SNORM },
+      .offset   { offsetof(VTX_3D_UV_NML_TAN_Q16, m_Nml) }
+    });
+    outPipeline.m_AttributeDescription.emplace_back(VkVertexInputAttributeDescription{
+      .location { 3 },  // layout location 3, octahedral
+      .binding  { 0 },  // bound buffer 0 (SOA)
+      .format   { VK_FORMAT_R16G16_SNORM },
+      .offset   { offsetof(VTX_3D_UV_NML_TAN_Q16, m_Tan) }
+    });
+    break;
   case vulkanPipeline::E_VERTEX_BINDING_MODE::AOS_XYZ_RGB_F32:
     outPipeline.m_BindingDescription[0].stride = static_cast<uint32_t>(sizeof(VTX_3D_RGB));
     outPipeline.m_AttributeDescription.reserve(2);
@@ -470,6 +588,37 @@ bool windowHandler::setupVertexInputInfo(vulkanPipeline& outPipeline, vulkanPipe
     printWarning("UNKNOWN VERTEX BINDING MODE PROVIDED"sv);
     return false;
   }
+
+  switch (inSetup.m_InstanceBindingMode)
+  {
+  case vulkanPipeline::E_INSTANCE_BINDING_MODE::NONE:
+    break;
+  case vulkanPipeline::E_INSTANCE_BINDING_MODE::M2W_MATERIAL:
+    outPipeline.m_BindingDescription.emplace_back(VkVertexInputBindingDescription{
+      .binding  { vulkanPipeline::s_InstanceBinding },
+      .stride   { static_cast<uint32_t>(sizeof(VTX_INSTANCE)) },
+      .inputRate{ VK_VERTEX_INPUT_RATE_INSTANCE }
+    });
+    for (uint32_t i{ 0 }; i < 4; ++i)
+    {
+      outPipeline.m_AttributeDescription.emplace_back(VkVertexInputAttributeDescription{
+        .location { vulkanPipeline::s_InstanceLocation + i },// one per matrix column
+        .binding  { vulkanPipeline::s_InstanceBinding },
+        .format   { VK_FORMAT_R32G32B32A32_SFLOAT },
+        .offset   { static_cast<uint32_t>(offsetof(VTX_INSTANCE, m_M2W) + sizeof(glm::vec4) * i) }
+      });
+    }
+    outPipeline.m_AttributeDescription.emplace_back(VkVertexInputAttributeDescription{
+      .location { vulkanPipeline::s_InstanceLocation + 4 },
+      .binding  { vulkanPipeline::s_InstanceBinding },
+      .format   { VK_FORMAT_R32_UINT },
+      .offset   { offsetof(VTX_INSTANCE, m_MaterialID) }
+    });
+    break;
+  default:
+    printWarning("UNKNOWN INSTANCE BINDING MODE PROVIDED"sv);
+    return false;
+  }
   outPipeline.m_VertexInputInfo = VkPipelineVertexInputStateCreateInfo
   {
     .sType{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO },
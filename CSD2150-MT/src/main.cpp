@@ -13,9 +13,17 @@
 #include <memory>
 #include <handlers/windowHandler.h>
 #include <vulkanHelpers/vulkanModel.h>
+#include <vulkanHelpers/vulkanInstanceBuffer.h>
+#include <vulkanHelpers/vulkanIndirectBuffer.h>
+#include <vulkanHelpers/vulkanGPUCuller.h>
+#include <vulkanHelpers/vulkanHiZ.h>
+#include <vulkanHelpers/vulkanRenderQueue.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <utility/matrixTransforms.h>
+#include <utility/bounds.h>
+#include <utility/occlusionBuffer.h>
 #include <utility/Timer.h>
+#include <filesystem>
 
 #define MTD_USE_VULKAN_VALIDATION_LAYER false
 #define MTD_USE_RENDERDOC_DEBUG_LAYER false
@@ -267,7 +275,14 @@ int main()
     "3 Different view modes exist, switched using the number row keys.\n"
     "1: SKULL ONLY\n"
     "2: CAR ONLY\n"
-    "3: BOTH (Skull will be in the seat :D)\n\n"
+    "3: BOTH (Skull will be in the seat :D)\n"
+    "4: Toggle a crowd of 10000 instanced skulls below\n"
+    "5: Toggle culling the crowd on the GPU, checked against the CPU (needs Cull.spv)\n"
+    "6: Toggle Hi-Z occlusion culling of the skull, car and GPU culled crowd (needs HiZ.spv)\n"
+    "7: Toggle CPU occlusion culling of the skull and CPU culled crowd behind the car\n"
+    "8: Print the last frame's issued and skipped (redundant) binds\n"
+    "9: Toggle replaying pre-recorded draws while they're unchanged\n"
+    "0: Toggle recording draws on every core (when not replaying)\n\n"
     "CAMERA CONTROLS:\n"
     "LMB/RMB (Hold): Adjust camera orbit\n"
     "Scroll wheel up: Zoom in\n"
@@ -282,22 +297,49 @@ int main()
     "-: Decrease Gamma (hold shift for quick change)\n\n"
     "OTHER CONTROLS:\n"
     "F11: Enter fullscreen mode\n"
+    "F2: Print the last frame's CPU wait times\n"
+    "F3: Cycle the frame rate cap (off/30/60/144)\n"
+    "F4: Cycle the most frames the GPU may be behind by (latency vs throughput)\n"
+    "F5: Toggle drawing the skull from 16 bit quantized vertices\n"
+    "F6: Toggle queueing the CPU culled crowd as 1 draw per skull (render queue stress test)\n"
   );
 
-  if (std::unique_ptr<vulkanWindow> upVKWin{ pWH->createWindow(windowSetup{.m_ClearColorR{ 0.0f }, .m_ClearColorG{ 0.0f }, .m_ClearColorB{ 0.0f }, .m_Title{ L"CSD2150 Final Project | Owen Huang Wensong"sv } }) }; upVKWin && upVKWin->OK())
+  if (std::unique_ptr<vulkanWindow> upVKWin{ pWH->createWindow(windowSetup{.m_ClearColorR{ 0.0f }, .m_ClearColorG{ 0.0f }, .m_ClearColorB{ 0.0f }, .m_Title{ L"CSD2150 Final Project | Owen Huang Wensong"sv }, .m_bDepthReadable{ true } }) }; upVKWin && upVKWin->OK())
   {
     windowsInput& win0Input{ upVKWin->m_windowsWindow.m_windowInputs };
 
-    vulkanModel skullModel;
-    if (false == skullModel.load3DUVModel("../Assets/Meshes/Skull_textured.fbx"))
+    // every model shares these two buffers, bound once per frame
+    vulkanGeometryArena geometryArena;
+    if (false == geometryArena.createArena(1u << 19, sizeof(VTX_3D_UV_NML_TAN), 1u << 21, VK_INDEX_TYPE_UINT32))
     {
-      printWarning("Failed to load skull model"sv, true);
+      printWarning("Failed to create geometry arena"sv, true);
       return -5;
     }
-    vulkanModel carModel;
-    if (false == carModel.load3DUVModel("../Assets/Meshes/_2_Vintage_Car_01_low.fbx"))
+
+    vulkanModel skullModel, carModel;
+    if (false == vulkanModel::loadModels
+    (
+      std::array
+      {
+        vulkanModel::loadRequest{ &skullModel, "../Assets/Meshes/Skull_textured.fbx"sv, { .m_bOptimizeMesh{ true }, .m_bGenerateLODs{ true }, .m_pArena{ &geometryArena } } },
+        vulkanModel::loadRequest{ &carModel, "../Assets/Meshes/_2_Vintage_Car_01_low.fbx"sv, { .m_bOptimizeMesh{ true }, .m_bGenerateLODs{ true }, .m_bOccluder{ true }, .m_pArena{ &geometryArena } } }
+      }
+    ))
     {
-      printWarning("Failed to load car model"sv, true);
+      geometryArena.destroyArena();
+      printWarning("Failed to load skull/car model"sv, true);
+      return -5;
+    }
+
+    // every draw of a pipeline goes out as one indirect call, the crowd's
+    // stress mode (F6) takes a batch per skull
+    vulkanIndirectBuffer drawCommands;
+    if (false == drawCommands.createIndirectBuffer(1u << 16, 1u << 14, upVKWin->m_FramesInFlight))
+    {
+      carModel.destroyModel();
+      skullModel.destroyModel();
+      geometryArena.destroyArena();
+      printWarning("Failed to create indirect draw buffer"sv, true);
       return -5;
     }
 
@@ -306,19 +348,162 @@ int main()
     FinalInfos::switchMode(carInfo, FinalInfos::E_CAR, FinalInfos::E_SKULL_ONLY);
 
     
+    // every draw reads its model to world from a per frame instance buffer
+    // and the camera from a per frame uniform, so a moving camera or object
+    // doesn't change what a replay recorded. The skull and car are a slot
+    // each, the crowd has its own buffer.
+    static constexpr uint32_t s_SkullInstance{ 0 };
+    static constexpr uint32_t s_CarInstance{ 1 };
+    vulkanInstanceBuffer sceneInstances;
+    if (false == sceneInstances.createInstanceBuffer(2, upVKWin->m_FramesInFlight))
+    {
+      drawCommands.destroyIndirectBuffer();
+      carModel.destroyModel();
+      skullModel.destroyModel();
+      geometryArena.destroyArena();
+      printWarning("Failed to create instance buffer"sv, true);
+      return -5;
+    }
+
+    // skull crowd, 1 instanced draw per LOD through the skull's pipeline
+    static constexpr uint32_t s_CrowdSide{ 100 };
+    vulkanInstanceBuffer crowdInstances;
+    std::vector<glm::mat4> crowdM2W;
+    bool bCrowdReady{ crowdInstances.createInstanceBuffer(s_CrowdSide * s_CrowdSide, upVKWin->m_FramesInFlight) };
+    if (false == bCrowdReady)printWarning("skull crowd prep failed"sv);
+
+    // a flat grid under the scene, spaced by the skull's bounds
+    if (bCrowdReady)
+    {
+      static constexpr float s_CrowdScale{ 0.0078125f };
+      float spacing{ 2.5f * skullModel.m_BoundingSphere.w * s_CrowdScale };
+      crowdM2W.reserve(static_cast<size_t>(s_CrowdSide) * s_CrowdSide);
+      for (uint32_t i{ 0 }; i < s_CrowdSide; ++i)
+      {
+        for (uint32_t j{ 0 }; j < s_CrowdSide; ++j)
+        {
+          glm::vec3 pos{ (i - 0.5f * s_CrowdSide) * spacing, -6.0f, (j - 0.5f * s_CrowdSide) * spacing };
+          crowdM2W.emplace_back(glm::scale(glm::translate(glm::identity<glm::mat4>(), pos), glm::vec3{ s_CrowdScale }));
+        }
+      }
+    }
+
+    // the skull again from 16 bit vertices (F5), only once its shader is compiled
+    static constexpr std::string_view s_QuantizedShaderVert{ "../Assets/Shaders/VertQuantized.spv"sv };
+    vulkanGeometryArena quantizedArena;
+    vulkanModel skullQModel;
+    vulkanPipeline skullQPipeline;
+    bool bQuantizedReady{ false };
+    if (std::filesystem::exists(s_QuantizedShaderVert) && quantizedArena.createArena(1u << 19, sizeof(VTX_3D_UV_NML_TAN_Q16), 1u << 21, VK_INDEX_TYPE_UINT32))
+    {
+      bQuantizedReady = skullQModel.load3DUVModel("../Assets/Meshes/Skull_textured.fbx"sv, { .m_bOptimizeMesh{ true }, .m_bQuantize{ true }, .m_bGenerateLODs{ true }, .m_pArena{ &quantizedArena } });
+      if (bQuantizedReady)
+      {
+        bQuantizedReady = upVKWin->createPipelineInfo(skullQPipeline,
+        vulkanPipeline::setup // ******************* QUANTIZED SKULL PIPELINE ****
+        {
+          .m_VertexBindingMode{ vulkanPipeline::E_VERTEX_BINDING_MODE::AOS_XYZ_UV_NML_TAN_Q16 },
+          .m_InstanceBindingMode{ vulkanPipeline::E_INSTANCE_BINDING_MODE::M2W_MATERIAL },
+
+          .m_PathShaderVert{ s_QuantizedShaderVert },
+          .m_PathShaderFrag{ "../Assets/Shaders/fragBottomUpNormalsBC5.spv"sv },
+
+          .m_UniformsVert
+          {
+            vulkanPipeline::createUniformInfo
+            <
+              VTX_DEQUANT,  // u_PosOffset, u_PosScale & u_UVOffsetScale
+              glm::mat4     // u_W2V
+            >()
+          },
+          .m_UniformsFrag
+          {
+            vulkanPipeline::createUniformInfo
+            <
+              float,        // u_AmbientStrength
+              glm::vec3,    // u_LocalCamPos (world space for instances)
+              pointLight,   // u_LocalLightPos & u_LocalLightCol (world space)
+              vulkanTexture,// u_sColor
+              vulkanTexture,// u_sAmbient
+              vulkanTexture,// u_sNormal
+              vulkanTexture // u_sRoughness
+            >()
+          },
+
+          .m_pTexturesFrag
+          {
+            &SkullTextures[FinalSkull::E_BASE_COLOR],
+            &SkullTextures[FinalSkull::E_AMBIENT_OCCLUSION],
+            &SkullTextures[FinalSkull::E_NORMAL],
+            &SkullTextures[FinalSkull::E_ROUGHNESS]
+          },
+
+          .m_PushConstantRangeVert{ vulkanPipeline::createPushConstantInfo<glm::mat4>(VK_SHADER_STAGE_VERTEX_BIT) },// unused, keeps pc_Gamma at 64
+          .m_PushConstantRangeFrag{ vulkanPipeline::createPushConstantInfo<float>(VK_SHADER_STAGE_FRAGMENT_BIT) },
+        });
+        if (false == bQuantizedReady)skullQModel.destroyModel();
+      }
+      if (false == bQuantizedReady)
+      {
+        quantizedArena.destroyArena();
+        printWarning("quantized skull prep failed"sv);
+      }
+    }
+
+    // every draw of the frame goes through here, sorted before recording
+    vulkanRenderQueue renderQueue;
+
+    // every core but this one, for occlusion rasterizing and draw recording
+    MTU::threadPool workerPool{ std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+
+    // the car is drawn into a coarse CPU depth buffer
+    static constexpr uint32_t s_OcclusionWidth{ 320 };
+    MTU::occlusionBuffer cpuOcclusion;
+
+    // the crowd never moves, its world spheres are made once for the CPU cull
+    MTU::sphereSet crowdSpheres;
+    crowdSpheres.reserve(crowdM2W.size());
+    for (glm::mat4 const& x : crowdM2W)crowdSpheres.add(MTU::transformSphere(skullModel.m_BoundingSphere, x));
+
+    // the same crowd culled by a compute pass, one draw per visible skull
+    // at a fixed LOD (instance i is skull i), the objects never move. The
+    // skull and car follow the crowd's objects when occlusion culling is on,
+    // tested against the previous frame's depth pyramid
+    static constexpr std::string_view s_CullShaderComp{ "../Assets/Shaders/Cull.spv"sv };
+    static constexpr std::string_view s_HiZShaderComp{ "../Assets/Shaders/HiZ.spv"sv };
+    vulkanHiZ hiZ;
+    vulkanGPUCuller gpuCuller;
+    uint32_t crowdObjectCount{ static_cast<uint32_t>(crowdM2W.size()) };
+    bool bGPUCullReady
+    {
+      bCrowdReady && std::filesystem::exists(s_CullShaderComp) && std::filesystem::exists(s_HiZShaderComp) &&
+      hiZ.createHiZ(*upVKWin, s_HiZShaderComp) && gpuCuller.createGPUCuller(s_CullShaderComp, crowdObjectCount + 2, drawCommands, hiZ)
+    };
+    if (bGPUCullReady)
+    {
+      uint32_t crowdLOD{ static_cast<uint32_t>(skullModel.m_LODs.size() / 2) };
+      for (uint32_t f{ 0 }; f < upVKWin->m_FramesInFlight; ++f)
+      {
+        std::span<MTU::cullObject> objects{ gpuCuller.getObjects(f) };
+        for (uint32_t i{ 0 }; i < crowdObjectCount; ++i)objects[i] = skullModel.getCullObject(crowdM2W[i], crowdLOD, i);
+      }
+    }
+
     vulkanPipeline skullPipeline, carPipeline;
     if (false == upVKWin->createPipelineInfo(skullPipeline,
       vulkanPipeline::setup // ***************************** SKULL PIPELINE ****
       {
         .m_VertexBindingMode{ vulkanPipeline::E_VERTEX_BINDING_MODE::AOS_XYZ_UV_NML_TAN_F32 },
+        .m_InstanceBindingMode{ vulkanPipeline::E_INSTANCE_BINDING_MODE::M2W_MATERIAL },
         
-        .m_PathShaderVert{ "../Assets/Shaders/Vert.spv"sv },
+        .m_PathShaderVert{ "../Assets/Shaders/VertInstanced.spv"sv },
         .m_PathShaderFrag{ "../Assets/Shaders/fragBottomUpNormalsBC5.spv"sv },
 
         .m_UniformsVert
         {
           vulkanPipeline::createUniformInfo
           <
+            glm::mat4     // u_W2V
             //float,        // heightmap scale
             //vulkanTexture // u_sRoughness (for heightmap data)
           >()
@@ -328,8 +513,8 @@ int main()
           vulkanPipeline::createUniformInfo
           <
             float,        // u_AmbientStrength
-            glm::vec3,    // u_LocalCamPos
-            pointLight,   // u_LocalLightPos & u_LocalLightCol
+            glm::vec3,    // u_LocalCamPos (world space for instances)
+            pointLight,   // u_LocalLightPos & u_LocalLightCol (world space)
             vulkanTexture,// u_sColor
             vulkanTexture,// u_sAmbient
             vulkanTexture,// u_sNormal
@@ -349,27 +534,28 @@ int main()
           &SkullTextures[FinalSkull::E_ROUGHNESS]
         },
 
-        .m_PushConstantRangeVert{ vulkanPipeline::createPushConstantInfo<glm::mat4>(VK_SHADER_STAGE_VERTEX_BIT) },
+        .m_PushConstantRangeVert{ vulkanPipeline::createPushConstantInfo<glm::mat4>(VK_SHADER_STAGE_VERTEX_BIT) },// unused, keeps pc_Gamma at 64
         .m_PushConstantRangeFrag{ vulkanPipeline::createPushConstantInfo<float>(VK_SHADER_STAGE_FRAGMENT_BIT) },
       }) || false == upVKWin->createPipelineInfo(carPipeline,
       vulkanPipeline::setup // ******************************* CAR PIPELINE ****
       {
         .m_VertexBindingMode{ vulkanPipeline::E_VERTEX_BINDING_MODE::AOS_XYZ_UV_NML_TAN_F32 },
+        .m_InstanceBindingMode{ vulkanPipeline::E_INSTANCE_BINDING_MODE::M2W_MATERIAL },
 
-        .m_PathShaderVert{ "../Assets/Shaders/Vert.spv"sv },
+        .m_PathShaderVert{ "../Assets/Shaders/VertInstanced.spv"sv },
         .m_PathShaderFrag{ "../Assets/Shaders/fragTopDownNormalslR8G8B8A8.spv"sv },
 
         .m_UniformsVert
         {
-          vulkanPipeline::createUniformInfo<>()
+          vulkanPipeline::createUniformInfo<glm::mat4>()// u_W2V
         },
         .m_UniformsFrag
         {
           vulkanPipeline::createUniformInfo
           <
             float,        // u_AmbientStrength
-            glm::vec3,    // u_LocalCamPos
-            pointLight,   // u_LocalLightPos & u_LocalLightCol
+            glm::vec3,    // u_LocalCamPos (world space for instances)
+            pointLight,   // u_LocalLightPos & u_LocalLightCol (world space)
             vulkanTexture,// u_sColor
             vulkanTexture,// u_sAmbient
             vulkanTexture,// u_sNormal
@@ -386,7 +572,7 @@ int main()
         &CarTextures[FinalCar::E_ROUGHNESS]
       },
 
-      .m_PushConstantRangeVert{ vulkanPipeline::createPushConstantInfo<glm::mat4>(VK_SHADER_STAGE_VERTEX_BIT) },
+      .m_PushConstantRangeVert{ vulkanPipeline::createPushConstantInfo<glm::mat4>(VK_SHADER_STAGE_VERTEX_BIT) },// unused, keeps pc_Gamma at 64
       .m_PushConstantRangeFrag{ vulkanPipeline::createPushConstantInfo<float>(VK_SHADER_STAGE_FRAGMENT_BIT) },
       }))
     {
@@ -401,6 +587,125 @@ int main()
 
       if (win0Input.isTriggered(VK_F11))upVKWin->toggleFullscreen();
 
+      if (win0Input.isTriggered(VK_F2))
+      {
+        vulkanFrameWaits const& waits{ upVKWin->m_FrameWaits };
+        printf_s("CPU waits last frame: cap %.3fms, GPU fence %.3fms, swapchain acquire %.3fms\n", waits.m_Pace, waits.m_Fence, waits.m_Acquire);
+      }
+
+      if (win0Input.isTriggered(VK_F3))
+      {
+        static constexpr std::array s_FrameRateCaps{ 0.0, 30.0, 60.0, 144.0 };
+        static size_t s_FrameRateCapIndex{ 0 };
+        s_FrameRateCapIndex = (s_FrameRateCapIndex + 1) % s_FrameRateCaps.size();
+        upVKWin->m_FramePacer.setFrameRateCap(s_FrameRateCaps[s_FrameRateCapIndex]);
+        if (s_FrameRateCapIndex)printf_s("Frame rate capped to %.0f\n", s_FrameRateCaps[s_FrameRateCapIndex]);
+        else printf_s("Frame rate uncapped\n");
+      }
+
+      if (win0Input.isTriggered(VK_F4))
+      {
+        upVKWin->setMaxQueuedFrames(upVKWin->m_MaxQueuedFrames % upVKWin->m_FramesInFlight + 1);
+        printf_s("GPU may be up to %u frame(s) behind (%u in flight)\n", upVKWin->m_MaxQueuedFrames, upVKWin->m_FramesInFlight);
+      }
+
+      static bool s_bQuantizedSkull{ false };
+      if (win0Input.isTriggered(VK_F5) && bQuantizedReady)
+      {
+        s_bQuantizedSkull = !s_bQuantizedSkull;
+        printf_s("Quantized skull %s (%zu bytes per vertex)\n", s_bQuantizedSkull ? "ON" : "OFF", s_bQuantizedSkull ? sizeof(VTX_3D_UV_NML_TAN_Q16) : sizeof(VTX_3D_UV_NML_TAN));
+      }
+      // same mesh, pipeline and arena swapped for the Q16 ones
+      vulkanModel& skullDrawModel{ s_bQuantizedSkull ? skullQModel : skullModel };
+      vulkanPipeline& skullDrawPipeline{ s_bQuantizedSkull ? skullQPipeline : skullPipeline };
+      vulkanGeometryArena& skullDrawArena{ s_bQuantizedSkull ? quantizedArena : geometryArena };
+
+      static bool s_bSkullCrowd{ false };
+      if (win0Input.isTriggered(VK_4) && bCrowdReady)
+      {
+        s_bSkullCrowd = !s_bSkullCrowd;
+        printf_s("Skull crowd %s\n", s_bSkullCrowd ? "ON" : "OFF");
+      }
+
+      // thousands of queued draws instead of one per LOD, enough for
+      // recordParallel to split between every worker
+      static bool s_bCrowdPerSkull{ false };
+      if (win0Input.isTriggered(VK_F6) && bCrowdReady)
+      {
+        s_bCrowdPerSkull = !s_bCrowdPerSkull;
+        printf_s("Skull crowd as 1 draw per skull %s\n", s_bCrowdPerSkull ? "ON" : "OFF");
+      }
+
+      static bool s_bGPUCull{ false };
+      if (win0Input.isTriggered(VK_5) && bGPUCullReady)
+      {
+        s_bGPUCull = !s_bGPUCull;
+        printf_s("Skull crowd GPU culling %s\n", s_bGPUCull ? "ON" : "OFF");
+      }
+
+      static bool s_bCPUOcclusion{ false };
+      if (win0Input.isTriggered(VK_7))
+      {
+        s_bCPUOcclusion = !s_bCPUOcclusion;
+        printf_s("CPU occlusion culling %s (%zu occluder triangles)\n", s_bCPUOcclusion ? "ON" : "OFF", carModel.m_Occluder.m_Indices.size() / 3);
+      }
+
+      if (win0Input.isTriggered(VK_8))
+      {
+        vulkanCommandState::stats const& stats{ upVKWin->m_CommandStats };
+        printf_s
+        (
+          "Binds issued/skipped last frame: %u/%u\n"
+          "pipeline %u/%u, descriptor sets %u/%u, vertex buffer %u/%u, index buffer %u/%u, viewport %u/%u, scissor %u/%u\n",
+          stats.getIssued(), stats.getSkipped(),
+          stats.m_Issued[vulkanCommandState::E_BIND_PIPELINE], stats.m_Skipped[vulkanCommandState::E_BIND_PIPELINE],
+          stats.m_Issued[vulkanCommandState::E_BIND_DESCRIPTOR_SETS], stats.m_Skipped[vulkanCommandState::E_BIND_DESCRIPTOR_SETS],
+          stats.m_Issued[vulkanCommandState::E_BIND_VERTEX_BUFFER], stats.m_Skipped[vulkanCommandState::E_BIND_VERTEX_BUFFER],
+          stats.m_Issued[vulkanCommandState::E_BIND_INDEX_BUFFER], stats.m_Skipped[vulkanCommandState::E_BIND_INDEX_BUFFER],
+          stats.m_Issued[vulkanCommandState::E_SET_VIEWPORT], stats.m_Skipped[vulkanCommandState::E_SET_VIEWPORT],
+          stats.m_Issued[vulkanCommandState::E_SET_SCISSOR], stats.m_Skipped[vulkanCommandState::E_SET_SCISSOR]
+        );
+        printf_s("Replays recorded/reused so far: %u/%u\n", renderQueue.m_ReplaysRecorded, renderQueue.m_ReplaysReused);
+        printf_s("Last parallel recording: %u draws over %u secondaries\n", renderQueue.m_ParallelItems, renderQueue.m_ParallelChunks);
+      }
+
+      static bool s_bStaticReplay{ false };
+      if (win0Input.isTriggered(VK_9))
+      {
+        if (false == s_bStaticReplay && renderQueue.m_Replays.empty() && false == renderQueue.createReplay(*upVKWin))
+        {
+          printWarning("replay command buffers unavailable"sv);
+        }
+        else
+        {
+          s_bStaticReplay = !s_bStaticReplay;
+          printf_s("Static draw replay %s\n", s_bStaticReplay ? "ON" : "OFF");
+        }
+      }
+
+      static bool s_bParallelRecord{ false };
+      if (win0Input.isTriggered(VK_0))
+      {
+        // the calling thread records a chunk too
+        if (false == s_bParallelRecord && renderQueue.m_Workers.empty() && false == renderQueue.createParallel(*upVKWin, static_cast<uint32_t>(workerPool.getNumThreads()) + 1))
+        {
+          printWarning("parallel recording command buffers unavailable"sv);
+        }
+        else
+        {
+          s_bParallelRecord = !s_bParallelRecord;
+          printf_s("Parallel draw recording %s (%u threads)\n", s_bParallelRecord ? "ON" : "OFF", renderQueue.m_WorkerCount);
+        }
+      }
+      bool bSecondaryPass{ s_bStaticReplay || s_bParallelRecord };
+
+      static bool s_bHiZ{ false };
+      if (win0Input.isTriggered(VK_6) && bGPUCullReady)
+      {
+        s_bHiZ = !s_bHiZ;
+        printf_s("Hi-Z occlusion culling %s\n", s_bHiZ ? "ON" : "OFF");
+      }
+
       // *******************************************************************
       // ****************************************** CAMERA UPDATE BEGIN ****
 
@@ -460,10 +765,43 @@ int main()
       // *******************************************************************
 
       // FCB stands for Frame Command Buffer, this frame's command buffer!
-      if (VkCommandBuffer FCB{ upVKWin->FrameBegin() }; FCB != VK_NULL_HANDLE)
+      if (VkCommandBuffer FCB{ upVKWin->FrameBegin(false) }; FCB != VK_NULL_HANDLE)
       {
       // *******************************************************************
       // ******************************************** RENDER LOOP BEGIN ****
+
+        // last use of this frame's draws is done, check the GPU's culling
+        // before the frame's commands get rewritten
+        bool bGPUCrowd{ s_bSkullCrowd && s_bGPUCull };
+        bool bGPUCull{ bGPUCullReady && (bGPUCrowd || s_bHiZ) };
+        if (bGPUCullReady)
+        {
+          uint32_t visible{ 0 };
+          if (false == gpuCuller.verify(drawCommands, upVKWin->m_FrameIndex, visible))printWarning("GPU culling differs from the CPU"sv);
+          hiZ.update();
+          gpuCuller.beginFrame(upVKWin->m_FrameIndex, MTU::extractFrustum(cam.m_W2V), s_bHiZ);
+        }
+        drawCommands.begin(upVKWin->m_FrameIndex);
+
+        // compute work has to be recorded outside the render pass
+        uint32_t crowdBatch{ UINT32_MAX }, skullBatch{ UINT32_MAX }, carBatch{ UINT32_MAX };
+        if (bGPUCrowd)
+        {
+          std::span<VTX_INSTANCE> instances{ crowdInstances.getInstances(upVKWin->m_FrameIndex) };
+          for (size_t i{ 0 }, t{ crowdM2W.size() }; i < t; ++i)instances[i] = VTX_INSTANCE{ .m_M2W{ crowdM2W[i] }, .m_MaterialID{ 0 } };
+          crowdBatch = gpuCuller.cull(FCB, drawCommands, 0, crowdObjectCount);
+        }
+        if (bGPUCull && s_bHiZ)
+        { // whole models at their LOD, the skull sits inside the car in BOTH mode
+          float height{ static_cast<float>(upVKWin->m_windowsWindow.getHeight()) };
+          std::span<MTU::cullObject> objects{ gpuCuller.getObjects(upVKWin->m_FrameIndex) };
+          objects[crowdObjectCount] = skullDrawModel.getCullObject(skullInfo.m_M2W, skullDrawModel.selectLOD(cam.m_W2V * skullInfo.m_M2W, height), s_SkullInstance);
+          objects[crowdObjectCount + 1] = carModel.getCullObject(carInfo.m_M2W, carModel.selectLOD(cam.m_W2V * carInfo.m_M2W, height), s_CarInstance);
+          skullBatch = gpuCuller.cull(FCB, drawCommands, crowdObjectCount, 1);
+          carBatch = gpuCuller.cull(FCB, drawCommands, crowdObjectCount + 1, 1);
+        }
+        // a replayed pass holds only vkCmdExecuteCommands
+        upVKWin->RenderPassBegin(bSecondaryPass ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
         
         { // Setting uniforms
           //static float skullHeightMapScale{ 1.0f };
@@ -520,18 +858,27 @@ int main()
             printf_s("LIGHT INFO (A/R/G/B + UP/DOWN to adjust):\nAmbient strength: %f\nlightR: %.4f\nlightG: %.4f\nlightB: %.4f\n", s_AmbientStrength, s_Light.m_Col.r, s_Light.m_Col.g, s_Light.m_Col.b);
           }
 
+          // every model is drawn instanced, lit in world space
           pointLight l_light{ s_Light };
-          glm::vec3 l_camPos{ skullInfo.m_W2M * glm::vec4{ cam.m_Pos, 1.0f } };
-          l_light.m_Pos = skullInfo.m_W2M * glm::vec4{ s_Light.m_Pos, 1.0f };
+          glm::vec3 l_camPos{ cam.m_Pos };
+          upVKWin->setUniform(skullPipeline, 0, 0, &cam.m_W2V, sizeof(cam.m_W2V));
           upVKWin->setUniform(skullPipeline, 1, 0, &s_AmbientStrength, sizeof(s_AmbientStrength));
           upVKWin->setUniform(skullPipeline, 1, 1, &l_camPos, sizeof(l_camPos));
           upVKWin->setUniform(skullPipeline, 1, 2, &l_light, sizeof(l_light));
-          
-          l_camPos = carInfo.m_W2M * glm::vec4{ cam.m_Pos, 1.0f };
-          l_light.m_Pos = carInfo.m_W2M * glm::vec4{ s_Light.m_Pos, 1.0f };
+
+          upVKWin->setUniform(carPipeline, 0, 0, &cam.m_W2V, sizeof(cam.m_W2V));
           upVKWin->setUniform(carPipeline, 1, 0, &s_AmbientStrength, sizeof(s_AmbientStrength));
           upVKWin->setUniform(carPipeline, 1, 1, &l_camPos, sizeof(l_camPos));
           upVKWin->setUniform(carPipeline, 1, 2, &l_light, sizeof(l_light));
+
+          if (s_bQuantizedSkull)
+          {
+            upVKWin->setUniform(skullQPipeline, 0, 0, &skullQModel.m_Dequant, sizeof(skullQModel.m_Dequant));
+            upVKWin->setUniform(skullQPipeline, 0, 1, &cam.m_W2V, sizeof(cam.m_W2V));
+            upVKWin->setUniform(skullQPipeline, 1, 0, &s_AmbientStrength, sizeof(s_AmbientStrength));
+            upVKWin->setUniform(skullQPipeline, 1, 1, &l_camPos, sizeof(l_camPos));
+            upVKWin->setUniform(skullQPipeline, 1, 2, &l_light, sizeof(l_light));
+          }
         }
 
         static glm::vec2 s_gamma{ 2.25f, 1.0f / 2.25f };
@@ -556,20 +903,147 @@ int main()
           }
         }
 
-        upVKWin->createAndSetPipeline(skullPipeline);
+        // nothing is recorded for objects outside the view
+        MTU::frustum worldFrustum{ MTU::extractFrustum(cam.m_W2V) };
+        auto isModelVisible
+        {
+          [&worldFrustum](vulkanModel const& Model, glm::mat4 const& M2W)
+          {
+            glm::vec4 sphere{ MTU::transformSphere(Model.m_BoundingSphere, M2W) };
+            return MTU::isSphereInFrustum(worldFrustum, glm::vec3{ sphere }, sphere.w);
+          }
+        };
+
+        // or hidden behind the car, which only occludes (never tested)
+        if (s_bCPUOcclusion)
+        {
+          cpuOcclusion.resize(s_OcclusionWidth, static_cast<uint32_t>(s_OcclusionWidth / AR));
+          cpuOcclusion.clear();
+          if (isModelVisible(carModel, carInfo.m_M2W))cpuOcclusion.addOccluder(carModel.m_Occluder, cam.m_W2V * carInfo.m_M2W);
+          cpuOcclusion.rasterize(&workerPool);
+        }
+        auto isModelUnoccluded
+        {
+          [&cpuOcclusion](vulkanModel const& Model, glm::mat4 const& M2W)
+          {
+            return false == s_bCPUOcclusion || cpuOcclusion.isVisible(Model.m_AABB, cam.m_W2V * M2W);
+          }
+        };
+
+        // draws are queued in any order, record sorts them by pipeline then
+        // front to back and binds only what changes
+        renderQueue.clear();
+        std::span<VTX_INSTANCE> sceneSlots{ sceneInstances.getInstances(upVKWin->m_FrameIndex) };
+        sceneSlots[s_SkullInstance] = VTX_INSTANCE{ .m_M2W{ skullInfo.m_M2W }, .m_MaterialID{ 0 } };
+        sceneSlots[s_CarInstance] = VTX_INSTANCE{ .m_M2W{ carInfo.m_M2W }, .m_MaterialID{ 0 } };
+        auto getCameraDistance
+        {
+          [](vulkanModel const& Model, glm::mat4 const& M2W)
+          {
+            return glm::length(glm::vec3{ MTU::transformSphere(Model.m_BoundingSphere, M2W) } - cam.m_Pos);
+          }
+        };
+
+        if (isModelVisible(skullDrawModel, skullInfo.m_M2W) && isModelUnoccluded(skullDrawModel, skullInfo.m_M2W))
         { // skull object
           glm::mat4 xform{ cam.m_W2V * skullInfo.m_M2W };
-          skullPipeline.pushConstant(FCB, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(xform), &xform);
-          skullPipeline.pushConstant(FCB, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
-          skullModel.draw(FCB);
+          if (skullBatch == UINT32_MAX)
+          { // out of batches, appending now would land in the previous batch
+            // reserved so the batch records the same however many runs are seen
+            skullDrawModel.selectLOD(xform, static_cast<float>(upVKWin->m_windowsWindow.getHeight()));
+            skullBatch = drawCommands.beginBatch(skullDrawModel.getMaxCulledCommands());
+            if (skullBatch != UINT32_MAX)skullDrawModel.appendCulled(drawCommands, xform, glm::vec3{ skullInfo.m_W2M * glm::vec4{ cam.m_Pos, 1.0f } }, s_SkullInstance);
+          }
+          if (skullBatch != UINT32_MAX)
+          {
+            renderQueue.submit({ .m_pPipeline{ &skullDrawPipeline }, .m_pInstances{ &sceneInstances }, .m_pArena{ &skullDrawArena }, .m_Batch{ skullBatch }, .m_Depth{ getCameraDistance(skullDrawModel, skullInfo.m_M2W) } });
+            renderQueue.pushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
+          }
         }
 
-        upVKWin->createAndSetPipeline(carPipeline);
+        if (isModelVisible(carModel, carInfo.m_M2W))
         { // car object
           glm::mat4 xform{ cam.m_W2V * carInfo.m_M2W };
-          carPipeline.pushConstant(FCB, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(xform), &xform);
-          carPipeline.pushConstant(FCB, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
-          carModel.draw(FCB);
+          if (carBatch == UINT32_MAX)
+          { // out of batches, appending now would land in the previous batch
+            carModel.selectLOD(xform, static_cast<float>(upVKWin->m_windowsWindow.getHeight()));
+            carBatch = drawCommands.beginBatch(carModel.getMaxCulledCommands());
+            if (carBatch != UINT32_MAX)carModel.appendCulled(drawCommands, xform, glm::vec3{ carInfo.m_W2M * glm::vec4{ cam.m_Pos, 1.0f } }, s_CarInstance);
+          }
+          if (carBatch != UINT32_MAX)
+          {
+            renderQueue.submit({ .m_pPipeline{ &carPipeline }, .m_pInstances{ &sceneInstances }, .m_Batch{ carBatch }, .m_Depth{ getCameraDistance(carModel, carInfo.m_M2W) } });
+            renderQueue.pushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
+          }
+        }
+
+        if (bGPUCrowd)
+        { // skull crowd, the compute pass wrote the draws, spread out so no depth
+          if (crowdBatch != UINT32_MAX)
+          {
+            renderQueue.submit({ .m_pPipeline{ &skullPipeline }, .m_pInstances{ &crowdInstances }, .m_Batch{ crowdBatch } });
+            renderQueue.pushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
+          }
+        }
+        else if (s_bSkullCrowd)
+        { // skull crowd, a LOD picked per visible skull, drawn by LOD or per skull
+          // only the skulls in view cost anything past the batch test
+          float height{ static_cast<float>(upVKWin->m_windowsWindow.getHeight()) };
+          static std::vector<uint32_t> s_CrowdVisible;
+          static std::vector<uint32_t> s_CrowdLODs(crowdM2W.size());
+          crowdSpheres.cull(worldFrustum, s_CrowdVisible);
+          std::erase_if(s_CrowdVisible, [&](uint32_t i) { return false == isModelUnoccluded(skullModel, crowdM2W[i]); });
+          std::vector<uint32_t> lodFirst(std::max<size_t>(skullModel.m_LODs.size(), 1) + 1, 0);
+          for (uint32_t i : s_CrowdVisible)
+          {
+            s_CrowdLODs[i] = skullModel.selectLOD(cam.m_W2V * crowdM2W[i], height);
+            ++lodFirst[s_CrowdLODs[i] + 1];
+          }
+          for (size_t i{ 1 }, t{ lodFirst.size() }; i < t; ++i)lodFirst[i] += lodFirst[i - 1];
+
+          std::span<VTX_INSTANCE> instances{ crowdInstances.getInstances(upVKWin->m_FrameIndex) };
+          if (s_bCrowdPerSkull)
+          { // a batch and draw each, front to back like the skull and car
+            for (uint32_t slot{ 0 }; uint32_t i : s_CrowdVisible)
+            {
+              uint32_t batch{ drawCommands.beginBatch() };
+              if (batch == UINT32_MAX)break;
+              instances[slot] = VTX_INSTANCE{ .m_M2W{ crowdM2W[i] }, .m_MaterialID{ 0 } };
+              skullModel.m_CurrentLOD = s_CrowdLODs[i];
+              skullModel.appendInstanced(drawCommands, 1, slot++);
+              renderQueue.submit({ .m_pPipeline{ &skullPipeline }, .m_pInstances{ &crowdInstances }, .m_Batch{ batch }, .m_Depth{ getCameraDistance(skullModel, crowdM2W[i]) } });
+              renderQueue.pushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
+            }
+          }
+          else
+          { // one command per LOD, instances grouped by LOD
+            std::vector<uint32_t> lodFill(lodFirst.begin(), lodFirst.end() - 1);
+            for (uint32_t i : s_CrowdVisible)
+            {
+              instances[lodFill[s_CrowdLODs[i]]++] = VTX_INSTANCE{ .m_M2W{ crowdM2W[i] }, .m_MaterialID{ 0 } };// one material for now
+            }
+
+            if (uint32_t batch{ drawCommands.beginBatch(static_cast<uint32_t>(lodFirst.size() - 1)) }; batch != UINT32_MAX)
+            {
+              for (uint32_t i{ 0 }, t{ static_cast<uint32_t>(lodFirst.size() - 1) }; i < t; ++i)
+              {
+                skullModel.m_CurrentLOD = i;
+                skullModel.appendInstanced(drawCommands, lodFirst[i + 1] - lodFirst[i], lodFirst[i]);
+              }
+              renderQueue.submit({ .m_pPipeline{ &skullPipeline }, .m_pInstances{ &crowdInstances }, .m_Batch{ batch } });
+              renderQueue.pushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(s_gamma.y), &s_gamma.y);
+            }
+          }
+        }
+        if (s_bStaticReplay)renderQueue.replay(FCB, *upVKWin, drawCommands, geometryArena);
+        else if (s_bParallelRecord)renderQueue.recordParallel(FCB, *upVKWin, drawCommands, geometryArena, workerPool);
+        else renderQueue.record(FCB, *upVKWin, drawCommands, geometryArena);
+
+        // next frame's occlusion tests read this frame's depth
+        if (bGPUCull && s_bHiZ)
+        {
+          upVKWin->RenderPassEnd();
+          hiZ.build(FCB, cam.m_W2V);
         }
 
         upVKWin->FrameEnd();
@@ -580,10 +1054,24 @@ int main()
       // ************************************************** WINDOW LOOP END ****
       // ***********************************************************************
     }
+    renderQueue.destroyReplay();
+    renderQueue.destroyParallel();
     carModel.destroyModel();
     skullModel.destroyModel();
+    geometryArena.destroyArena();
+    if (bQuantizedReady)
+    {
+      skullQModel.destroyModel();
+      quantizedArena.destroyArena();
+      upVKWin->destroyPipelineInfo(skullQPipeline);
+    }
+    gpuCuller.destroyGPUCuller();
+    hiZ.destroyHiZ();
+    drawCommands.destroyIndirectBuffer();
     upVKWin->destroyPipelineInfo(carPipeline);
     upVKWin->destroyPipelineInfo(skullPipeline);
+    if (bCrowdReady)crowdInstances.destroyInstanceBuffer();
+    sceneInstances.destroyInstanceBuffer();
   }
 
   FinalCar::unloadTextures(CarTextures);
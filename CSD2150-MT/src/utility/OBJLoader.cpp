@@ -3,33 +3,63 @@
  * @author  Owen Huang Wensong  (w.huang@digipen.edu)
  * @date    19 MAR 2022
  * @brief   This file contains the definitions for an OBJ loader
- *          THIS FILE IS OBSOLETE AND NOT IN USE DUE TO THE INCLUSION OF ASSIMP.
+ *          Assimp handles everything else, OBJs are streamed through here
+ *          by vulkanModel::loadStreamedOBJ.
  *
  * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
 *******************************************************************************/
 
 #include <string>               // for individual lines from file
+#include <bit>                  // countr_zero, bit_ceil
+#include <cstring>              // memchr for chunk splitting, tail padding
+#include <cmath>                // std::abs for tangent fallback
 #include <charconv>             // string_view safe version of stoi/stof
 #include <glm/glm.hpp>          // for generic vectors
-#include <unordered_map>        // for map of vertexsig to vertex index
+#include <thread>               // for chunked parsing
+#include <utility>              // std::as_const
+#include <optional>             // for per chunk names
+#include <algorithm>            // for prefix sum lookups
 #include <utility/OBJLoader.h>  // declarations
 #include <utility/CStrHash.hpp> // for token hashing to do token switch case
+#include <utility/mappedFile.h> // for zero copy file source
+
+#if defined(__AVX2__)
+#include <immintrin.h>          // 32 byte character class scanning
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>          // 2x16 byte character class scanning
+#define OBJ_SCAN_SSE2
+#endif
 
 // *****************************************************************************
 // **************************************************************** HELPERS ****
 
 namespace MTU::Helper // helper namespace for MTU
 {
-  static constexpr const char WS[]{ " \t" };  // WhiteSpaces (no new line)
-  static constexpr const char SS[]{ " \t/" }; // Slash Spaces (WS and /)
-
-  struct OBJLine
+  // one whitespace separated token, slashes inside are remembered for faces
+  struct OBJToken
   {
-    size_t            m_FirstTokenHash{ 0 };
-    std::string_view  m_Content       { /* Default empty */ };
+    const char* m_pBegin      { nullptr };
+    const char* m_pEnd        { nullptr };
+    const char* m_pSlashes[2] { nullptr, nullptr };
+    uint32_t    m_nSlashes    { 0 };
   };
 
-  struct OBJFaceContents { std::string_view m_Verts[3]; };
+  // every token of one line, found in a single pass over the characters
+  struct OBJLineTokens
+  {
+    static constexpr uint32_t s_MaxTokens{ 5 };// keyword + 4, faces only need 3
+
+    OBJToken    m_Tokens[s_MaxTokens] {};
+    uint32_t    m_nTokens             { 0 };// may exceed s_MaxTokens
+    const char* m_pLastEnd            { nullptr };// end of the last token
+
+    // everything after the keyword, used for names with spaces in them
+    std::string_view content() const noexcept
+    {
+      if (m_nTokens < 2)return std::string_view{ /* no content, create empty */ };
+      return std::string_view{ m_Tokens[1].m_pBegin, static_cast<size_t>(m_pLastEnd - m_Tokens[1].m_pBegin) };
+    }
+  };
 
   struct OBJVertexSig
   {
@@ -41,232 +71,705 @@ namespace MTU::Helper // helper namespace for MTU
     bool operator==(OBJVertexSig const& RHS) const { return m_PosIndex == RHS.m_PosIndex && m_TexIndex == RHS.m_TexIndex && m_NmlIndex == RHS.m_NmlIndex; }
   };
 
-  struct OBJVertexSigHash // helper hasher
+  // flat vertex signature -> index table, open addressing with linear probing.
+  // OBJ indices are 1 based so a slot with m_PosIndex 0 is empty.
+  class OBJVertexSigTable
   {
-    size_t operator()(OBJVertexSig const& toHash) const
+  public:
+
+    explicit OBJVertexSigTable(size_t expectedCount)
+    {
+      // keep load under 1/2 so probes stay short
+      m_Slots.resize(std::bit_ceil(std::max<size_t>(expectedCount * 2, 16)));
+      m_Mask = m_Slots.size() - 1;
+    }
+
+    /// @brief finds inSig, or inserts it with inValue if not found
+    /// @return the stored value, and true if it was inserted
+    std::pair<uint32_t, bool> tryEmplace(OBJVertexSig const& inSig, uint32_t inValue)
+    {
+      if ((m_Count + 1) * 2 > m_Slots.size())grow();
+      for (size_t i{ hash(inSig) & m_Mask };; i = (i + 1) & m_Mask)
+      {
+        Slot& refSlot{ m_Slots[i] };
+        if (refSlot.m_Sig.m_PosIndex == 0)
+        {
+          refSlot = Slot{ inSig, inValue };
+          ++m_Count;
+          return { inValue, true };
+        }
+        if (refSlot.m_Sig == inSig)return { refSlot.m_Value, false };
+      }
+    }
+
+  private:
+
+    struct Slot
+    {
+      OBJVertexSig  m_Sig   { 0, 0, 0 };
+      uint32_t      m_Value { 0 };
+    };
+
+    // murmur3 fmix64 over the packed indices, every input bit reaches every output bit
+    static size_t hash(OBJVertexSig const& inSig) noexcept
+    {
+      uint64_t k{ (static_cast<uint64_t>(inSig.m_TexIndex) << 32 | inSig.m_PosIndex) ^ (inSig.m_NmlIndex * 0x9E3779B97F4A7C15ull) };
+      k ^= k >> 33;
+      k *= 0xFF51AFD7ED558CCDull;
+      k ^= k >> 33;
+      k *= 0xC4CEB9FE1A85EC53ull;
+      k ^= k >> 33;
+      return static_cast<size_t>(k);
+    }
+
+    void grow()
     {
-      return cstrHash(reinterpret_cast<const char*>(&toHash), sizeof(toHash));
+      std::vector<Slot> oldSlots(m_Slots.size() * 2);
+      oldSlots.swap(m_Slots);
+      m_Mask = m_Slots.size() - 1;
+      for (Slot const& x : oldSlots)
+      {
+        if (x.m_Sig.m_PosIndex == 0)continue;
+        size_t i{ hash(x.m_Sig) & m_Mask };
+        while (m_Slots[i].m_Sig.m_PosIndex != 0)i = (i + 1) & m_Mask;
+        m_Slots[i] = x;
+      }
     }
+
+    std::vector<Slot> m_Slots {};
+    size_t            m_Mask  { 0 };
+    size_t            m_Count { 0 };
   };
 
-  static OBJLine splitLine(std::string_view const& inStrView) noexcept
+  // bit i set if character i of the block is in the class
+  struct OBJCharMasks
+  {
+    uint32_t m_Space;   // ' ', '\t', '\r', '\v', '\f'
+    uint32_t m_Slash;   // '/'
+    uint32_t m_NewLine; // '\n'
+  };
+
+  static constexpr size_t s_ScanBlockSize{ 32 };
+
+  // classifies exactly s_ScanBlockSize characters
+  static OBJCharMasks classifyBlock(const char* pBlock) noexcept
   {
-    size_t FTS{ inStrView.find_first_not_of(WS) };    // First Token Start
-    if (FTS == std::string_view::npos)return OBJLine{ /* Empty line */ };
-
-    size_t FTE{ inStrView.find_first_of(WS, FTS) };   // First Token End
-    if (FTE == std::string_view::npos)return OBJLine{ cstrHash(inStrView.data() + FTS, inStrView.length() - FTS) };
-    
-    size_t CS{ inStrView.find_first_not_of(WS, FTE) };// Content Start
-    size_t CE{ inStrView.find_last_not_of(WS) + 1 };  // Content End
-    return OBJLine
+#if defined(__AVX2__)
+    __m256i chars{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBlock)) };
+    __m256i space{ _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\t'))) };
+    space = _mm256_or_si256(space, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\r')));
+    space = _mm256_or_si256(space, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\v')));
+    space = _mm256_or_si256(space, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\f')));
+    return OBJCharMasks
     {
-      cstrHash(inStrView.data() + FTS, FTE - FTS),  // guaranteed valid alr
-      CS == std::string_view::npos ? 
-        std::string_view{ /* no content, create empty */ } :
-        std::string_view{ inStrView.data() + CS, CE - CS }
+      static_cast<uint32_t>(_mm256_movemask_epi8(space)),
+      static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/')))),
+      static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n'))))
     };
+#elif defined(OBJ_SCAN_SSE2)
+    OBJCharMasks retval{ 0, 0, 0 };
+    for (int half{ 0 }; half < 2; ++half)
+    {
+      __m128i chars{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + 16 * half)) };
+      __m128i space{ _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t'))) };
+      space = _mm_or_si128(space, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+      space = _mm_or_si128(space, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\v')));
+      space = _mm_or_si128(space, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\f')));
+      retval.m_Space    |= static_cast<uint32_t>(_mm_movemask_epi8(space)) << (16 * half);
+      retval.m_Slash    |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('/')))) << (16 * half);
+      retval.m_NewLine  |= static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')))) << (16 * half);
+    }
+    return retval;
+#else
+    OBJCharMasks retval{ 0, 0, 0 };
+    for (uint32_t i{ 0 }; i < s_ScanBlockSize; ++i)
+    {
+      switch (pBlock[i])
+      {
+      case ' ': case '\t': case '\r': case '\v': case '\f':
+        retval.m_Space |= 1u << i;
+        break;
+      case '/':
+        retval.m_Slash |= 1u << i;
+        break;
+      case '\n':
+        retval.m_NewLine |= 1u << i;
+        break;
+      default:
+        break;
+      }
+    }
+    return retval;
+#endif
   }
 
-  bool read3floats(glm::fvec3& outRef, std::string_view const& inContents) noexcept
+  /// @brief walks srcBuffer once in blocks, calling onLine(OBJLineTokens const&)
+  ///        for every line with at least 1 token. Stops if onLine returns false
+  /// @return false if onLine returned false
+  template <typename Fn>
+  bool scanLines(std::span<const char> srcBuffer, Fn&& onLine)
   {
-    size_t S0{ inContents.find_first_not_of(WS) };    // Token 0 Start
-    if (S0 == std::string_view::npos)return false;    // Token 0 Not found
-    size_t E0{ inContents.find_first_of(WS, S0) };    // Token 0 End
+    OBJLineTokens lineTokens{};
+    OBJToken*     pCurrToken{ nullptr };// null if between tokens
+    OBJToken      discarded{};          // tokens past s_MaxTokens land here
+    uint32_t      prevInToken{ 0 };     // 1 if the last block ended in a token
 
-    size_t S1{ inContents.find_first_not_of(WS, E0) };// Token 1 Start
-    if (S1 == std::string_view::npos)return false;    // Token 1 Not found
-    size_t E1{ inContents.find_first_of(WS, S1) };    // Token 1 End
-
-    size_t S2{ inContents.find_first_not_of(WS, E1) };// Token 2 Start
-    if (S2 == std::string_view::npos)return false;    // Token 2 Not found
-    size_t E2{ inContents.find_first_of(WS, S2) };    // Token 2 End
+    const char* const pSrc{ srcBuffer.data() };
+    for (size_t blockStart{ 0 }; blockStart < srcBuffer.size(); blockStart += s_ScanBlockSize)
+    {
+      OBJCharMasks masks;
+      if (size_t remaining{ srcBuffer.size() - blockStart }; remaining >= s_ScanBlockSize)
+      {
+        masks = classifyBlock(pSrc + blockStart);
+      }
+      else // pad the tail with spaces so nothing is read past the end
+      {
+        char tail[s_ScanBlockSize];
+        std::memset(tail, ' ', sizeof(tail));
+        std::memcpy(tail, pSrc + blockStart, remaining);
+        masks = classifyBlock(tail);
+      }
 
-    if (E2 == std::string_view::npos)E2 = inContents.length();
+      const uint32_t inToken{ ~(masks.m_Space | masks.m_NewLine) };
+      const uint32_t prevChar{ (inToken << 1) | prevInToken };
+      const uint32_t starts { inToken & ~prevChar };
+      const uint32_t ends   { ~inToken & prevChar };
+      prevInToken = inToken >> (s_ScanBlockSize - 1);
 
-    if (const char *pS0{ inContents.data() + S0 }, *pE0{ inContents.data() + E0 }; std::from_chars(pS0, pE0, outRef.x).ptr != pE0)return false;
-    if (const char *pS1{ inContents.data() + S1 }, *pE1{ inContents.data() + E1 }; std::from_chars(pS1, pE1, outRef.y).ptr != pE1)return false;
-    if (const char *pS2{ inContents.data() + S2 }, *pE2{ inContents.data() + E2 }; std::from_chars(pS2, pE2, outRef.z).ptr != pE2)return false;
+      for (uint32_t events{ starts | ends | masks.m_Slash | masks.m_NewLine }; events != 0; events &= events - 1)
+      {
+        const uint32_t bit{ events & (~events + 1) };
+        const char* pCurr{ pSrc + blockStart + static_cast<size_t>(std::countr_zero(events)) };
 
+        if (ends & bit)
+        {
+          pCurrToken->m_pEnd = lineTokens.m_pLastEnd = pCurr;
+          pCurrToken = nullptr;
+        }
+        if (masks.m_NewLine & bit)
+        {
+          if (lineTokens.m_nTokens && false == onLine(std::as_const(lineTokens)))return false;
+          lineTokens.m_nTokens = 0;
+        }
+        if (starts & bit)
+        {
+          pCurrToken = lineTokens.m_nTokens < OBJLineTokens::s_MaxTokens ? &lineTokens.m_Tokens[lineTokens.m_nTokens] : &discarded;
+          ++lineTokens.m_nTokens;
+          *pCurrToken = OBJToken{ pCurr };
+        }
+        if (masks.m_Slash & bit)
+        {
+          if (pCurrToken->m_nSlashes < 2)pCurrToken->m_pSlashes[pCurrToken->m_nSlashes] = pCurr;
+          ++pCurrToken->m_nSlashes;
+        }
+      }
+    }
+    // the last line may not end with '\n', close it at the end of the buffer
+    if (pCurrToken != nullptr)pCurrToken->m_pEnd = lineTokens.m_pLastEnd = pSrc + srcBuffer.size();
+    if (lineTokens.m_nTokens && false == onLine(std::as_const(lineTokens)))return false;
     return true;
   }
 
-  bool read2floats(glm::fvec2& outRef, std::string_view const& inContents) noexcept
+  static size_t tokenHash(OBJToken const& inToken) noexcept
   {
-    size_t S0{ inContents.find_first_not_of(WS) };    // Token 0 Start
-    if (S0 == std::string_view::npos)return false;    // Token 0 Not found
-    size_t E0{ inContents.find_first_of(WS, S0) };    // Token 0 End
-
-    size_t S1{ inContents.find_first_not_of(WS, E0) };// Token 1 Start
-    if (S1 == std::string_view::npos)return false;    // Token 1 Not found
-    size_t E1{ inContents.find_first_of(WS, S1) };    // Token 1 End
-
-    if (E1 == std::string_view::npos)E1 = inContents.length();
+    return cstrHash(inToken.m_pBegin, static_cast<size_t>(inToken.m_pEnd - inToken.m_pBegin));
+  }
 
-    if (const char* pS0{ inContents.data() + S0 }, * pE0{ inContents.data() + E0 }; std::from_chars(pS0, pE0, outRef.x).ptr != pE0)return false;
-    if (const char* pS1{ inContents.data() + S1 }, * pE1{ inContents.data() + E1 }; std::from_chars(pS1, pE1, outRef.y).ptr != pE1)return false;
+  template <typename T>
+  static bool readToken(T& outRef, const char* pBegin, const char* pEnd) noexcept
+  {
+    return pBegin != pEnd && std::from_chars(pBegin, pEnd, outRef).ptr == pEnd;
+  }
 
+  template <typename V>
+  static bool readFloats(V& outRef, OBJLineTokens const& inLine) noexcept
+  {
+    if (inLine.m_nTokens < static_cast<uint32_t>(V::length()) + 1)return false;
+    for (typename V::length_type i{ 0 }; i < V::length(); ++i)
+    {
+      OBJToken const& currToken{ inLine.m_Tokens[i + 1] };
+      if (false == readToken(outRef[i], currToken.m_pBegin, currToken.m_pEnd))return false;
+    }
     return true;
   }
 
-  bool splitContents(OBJFaceContents& outRef, std::string_view const& inContents) noexcept
+  // pos[/[tex][/nml]], empty fields are left as 0 so v//vn keeps its normal
+  static bool getVertexSig(OBJVertexSig& outRef, OBJToken const& inToken) noexcept
   {
-    size_t S0{ inContents.find_first_not_of(WS) };    // Token 0 Start
-    if (S0 == std::string_view::npos)return false;    // Token 0 Not found
-    size_t E0{ inContents.find_first_of(WS, S0) };    // Token 0 End
-
-    size_t S1{ inContents.find_first_not_of(WS, E0) };// Token 1 Start
-    if (S1 == std::string_view::npos)return false;    // Token 1 Not found
-    size_t E1{ inContents.find_first_of(WS, S1) };    // Token 1 End
+    outRef.m_PosIndex = outRef.m_TexIndex = outRef.m_NmlIndex = 0;
 
-    size_t S2{ inContents.find_first_not_of(WS, E1) };// Token 2 Start
-    if (S2 == std::string_view::npos)return false;    // Token 2 Not found
-    size_t E2{ inContents.find_first_of(WS, S2) };    // Token 2 End
+    const char* pPosEnd{ inToken.m_nSlashes > 0 ? inToken.m_pSlashes[0] : inToken.m_pEnd };
+    if (false == readToken(outRef.m_PosIndex, inToken.m_pBegin, pPosEnd) || outRef.m_PosIndex == 0)return false;
+    if (inToken.m_nSlashes == 0)return true;
 
-    if (E2 == std::string_view::npos)E2 = inContents.length();
+    const char* pTexEnd{ inToken.m_nSlashes > 1 ? inToken.m_pSlashes[1] : inToken.m_pEnd };
+    if (false == readToken(outRef.m_TexIndex, inToken.m_pSlashes[0] + 1, pTexEnd))outRef.m_TexIndex = 0;
+    if (inToken.m_nSlashes == 1)return true;
 
-    outRef.m_Verts[0] = std::string_view{ inContents.data() + S0, E0 - S0 };
-    outRef.m_Verts[1] = std::string_view{ inContents.data() + S1, E1 - S1 };
-    outRef.m_Verts[2] = std::string_view{ inContents.data() + S2, E2 - S2 };
+    if (false == readToken(outRef.m_NmlIndex, inToken.m_pSlashes[1] + 1, inToken.m_pEnd))outRef.m_NmlIndex = 0;
     return true;
   }
 
-  bool getVertexSig(OBJVertexSig& outRef, std::string_view const& inContents) noexcept
+  // the first 3 vertices of a face line, false if the face should be skipped
+  static bool getFaceSigs(OBJVertexSig(&outRef)[3], OBJLineTokens const& lineTokens, OBJLoadSettings const& settings) noexcept
   {
-    outRef.m_PosIndex = outRef.m_TexIndex = outRef.m_NmlIndex = 0;
+    if (lineTokens.m_nTokens < 4)return false;
+    for (size_t i{ 0 }; i < 3; ++i)// confirmed 3 valid tokens
+    {
+      if (false == getVertexSig(outRef[i], lineTokens.m_Tokens[i + 1]))return false;
+      if (false == settings.m_bLoadNormals)outRef[i].m_NmlIndex = 0;
+      if (false == settings.m_bLoadTexCoords)outRef[i].m_TexIndex = 0;
+    }
+    return true;
+  }
 
-    size_t S0{ inContents.find_first_not_of(SS) };    // Token 0 Start
-    if (S0 == std::string_view::npos)return false;    // Token 0 Not found
-    size_t E0{ inContents.find_first_of(SS, S0) };    // Token 0 End
+  // records of one contiguous range of lines, faces are only resolved after
+  // every chunk is parsed so chunks can be parsed on their own threads.
+  struct OBJChunk
+  {
+    std::vector<glm::vec3>      m_Positions   {};
+    std::vector<glm::vec3>      m_Normals     {};
+    std::vector<glm::vec2>      m_TexCoords   {};
+    std::vector<OBJVertexSig>   m_Corners     {};// 3 per face, file order
+    std::optional<std::string>  m_Name        {};// last one in this chunk
+    std::optional<std::string>  m_Material    {};// last one in this chunk
+    bool                        m_bSkipFaces  { false };// attributes only
+
+    // filled by dedup, unique signatures in order of first appearance
+    std::vector<OBJVertexSig>   m_Unique      {};
+    std::vector<uint32_t>       m_LocalIndices{};// per corner, into m_Unique
+
+    bool processLine(OBJLineTokens const& lineTokens, OBJLoadSettings const& settings)
+    {
+      switch (tokenHash(lineTokens.m_Tokens[0]))
+      {
+      case "mtllib"_literalHash:
+        // OBJ material
+        m_Material = lineTokens.content();
+        break;
+      case "o"_literalHash:
+      case "g"_literalHash:
+        // OBJ name
+        m_Name = lineTokens.content();
+        break;
+      case "v"_literalHash:
+        // Vertex position
+        //if (false == settings.m_bLoadPositions)break;
+        if (glm::fvec3 tmpRes; readFloats(tmpRes, lineTokens))
+        {
+          m_Positions.emplace_back(std::move(tmpRes));
+        }
+        else
+        {
+          return false;
+        }
+        break;
+      case "vn"_literalHash:
+        // Vertex normal
+        if (false == settings.m_bLoadNormals)break;
+        if (glm::fvec3 tmpRes; readFloats(tmpRes, lineTokens))
+        {
+          m_Normals.emplace_back(std::move(tmpRes));
+        }
+        else
+        {
+          return false;
+        }
+        break;
+      case "vt"_literalHash:
+        // Vertex UV
+        if (false == settings.m_bLoadTexCoords)break;
+        if (glm::fvec2 tmpRes; readFloats(tmpRes, lineTokens))
+        {
+          m_TexCoords.emplace_back(std::move(tmpRes));
+        }
+        else
+        {
+          return false;
+        }
+        break;
+      case "f"_literalHash:
+        // Triangle faces
+        //if (false == settings.m_bLoadTriangles)break;
+        if (m_bSkipFaces)break;
+        if (OBJVertexSig tmpRes[3]; getFaceSigs(tmpRes, lineTokens, settings))
+        {
+          m_Corners.insert(m_Corners.end(), std::begin(tmpRes), std::end(tmpRes));
+        }
+        break;// will skip face if no 3 vertices. Ignore possiblity of 4 vertices
+      default:
+        break;
+      }
+      return true;
+    }
 
-    if (E0 == std::string_view::npos)E0 = inContents.length();
+    bool parse(std::span<const char> srcBuffer, OBJLoadSettings const& settings)
+    {
+      return scanLines(srcBuffer, [this, &settings](OBJLineTokens const& lineTokens)
+      {
+        return processLine(lineTokens, settings);
+      });
+    }
 
-    if (const char* pS0{ inContents.data() + S0 }, * pE0{ inContents.data() + E0 }; std::from_chars(pS0, pE0, outRef.m_PosIndex).ptr != pE0)return false;
+    void dedup()
+    {
+      OBJVertexSigTable ExistingVertices{ m_Corners.size() };// upper bound, never grows
+      m_LocalIndices.reserve(m_Corners.size());
+      for (OBJVertexSig const& x : m_Corners)
+      {
+        auto [idx, bInserted]{ ExistingVertices.tryEmplace(x, static_cast<uint32_t>(m_Unique.size())) };
+        if (bInserted)m_Unique.emplace_back(x);
+        m_LocalIndices.emplace_back(idx);
+      }
+      m_Corners.clear();
+      m_Corners.shrink_to_fit();// not needed anymore
+    }
+  };
 
-    size_t S1{ inContents.find_first_not_of(SS, E0) };// Token 1 Start
-    if (S1 == std::string_view::npos)return true;     // Token 1 Not found
-    size_t E1{ inContents.find_first_of(SS, S1) };    // Token 1 End
+  // global 1 based OBJ index -> element, walking the chunk prefix sums
+  template <typename T>
+  struct OBJAttribLookup
+  {
+    std::vector<std::vector<T> const*>  m_pChunkData{};
+    std::vector<size_t>                 m_Offsets   {};// prefix sum, size + 1
 
-    if (E1 == std::string_view::npos)E1 = inContents.length();
+    OBJAttribLookup(std::span<OBJChunk> chunks, std::vector<T> OBJChunk::* pMember)
+    {
+      m_pChunkData.reserve(chunks.size());
+      m_Offsets.reserve(chunks.size() + 1);
+      m_Offsets.emplace_back(0);
+      for (OBJChunk& x : chunks)
+      {
+        m_pChunkData.emplace_back(&(x.*pMember));
+        m_Offsets.emplace_back(m_Offsets.back() + (x.*pMember).size());
+      }
+    }
 
-    if (const char* pS1{ inContents.data() + S1 }, * pE1{ inContents.data() + E1 }; std::from_chars(pS1, pE1, outRef.m_TexIndex).ptr != pE1)outRef.m_TexIndex = 0;
+    T const* find(unsigned int OBJIndex) const noexcept
+    {
+      if (OBJIndex == 0 || OBJIndex > m_Offsets.back())return nullptr;
+      size_t idx{ OBJIndex - 1u };
+      size_t whichChunk{ static_cast<size_t>(std::upper_bound(m_Offsets.begin(), m_Offsets.end(), idx) - m_Offsets.begin()) - 1 };
+      return &(*m_pChunkData[whichChunk])[idx - m_Offsets[whichChunk]];
+    }
+  };
 
-    size_t S2{ inContents.find_first_not_of(SS, E1) };// Token 2 Start
-    if (S2 == std::string_view::npos)return true;     // Token 2 Not found
-    size_t E2{ inContents.find_first_of(SS, S2) };    // Token 2 End
+  // runs fn(i) for i in [0, count), one task per worker, calling thread helps
+  template <typename Fn>
+  void parallelFor(size_t count, Fn&& fn)
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i{ 1 }; i < count; ++i)workers.emplace_back([&fn, i]() { fn(i); });
+    if (count > 0)fn(0);
+  }// jthreads join here
+
+  // split at line boundaries, chunks after the first start after a '\n'
+  std::vector<std::span<const char>> splitChunks(std::span<const char> srcBuffer, OBJLoadSettings const& settings)
+  {
+    size_t numChunks{ settings.m_NumThreads ? settings.m_NumThreads : std::max(std::thread::hardware_concurrency(), 1u) };
+    numChunks = std::clamp<size_t>(srcBuffer.size() / OBJLoadSettings::s_MinChunkSize, 1, numChunks);
 
-    if (E2 == std::string_view::npos)E2 = inContents.length();
-    
-    if (const char* pS2{ inContents.data() + S2 }, * pE2{ inContents.data() + E2 }; std::from_chars(pS2, pE2, outRef.m_NmlIndex).ptr != pE2)outRef.m_NmlIndex = 0;
-  
-    return true;
+    std::vector<std::span<const char>> chunkSrcs;
+    chunkSrcs.reserve(numChunks);
+    for (size_t i{ 0 }, chunkStart{ 0 }; i < numChunks && chunkStart < srcBuffer.size(); ++i)
+    {
+      size_t chunkEnd{ srcBuffer.size() };
+      if (i + 1 < numChunks)
+      {
+        const char* pTarget{ srcBuffer.data() + std::max(chunkStart, srcBuffer.size() * (i + 1) / numChunks) };
+        const char* pNewLine{ static_cast<const char*>(std::memchr(pTarget, '\n', static_cast<size_t>(srcBuffer.data() + srcBuffer.size() - pTarget))) };
+        if (pNewLine != nullptr)chunkEnd = static_cast<size_t>(pNewLine - srcBuffer.data()) + 1;
+      }
+      chunkSrcs.emplace_back(srcBuffer.subspan(chunkStart, chunkEnd - chunkStart));
+      chunkStart = chunkEnd;
+    }
+    return chunkSrcs;
   }
 
-}
-
-// *****************************************************************************
-// ******************************************************* PUBLIC FUNCTIONS ****
-
-bool MTU::loadOBJ(std::ifstream& ifs, OBJOutputs& outputs, OBJLoadSettings settings)
-{
-  if (false == ifs.is_open())return false;// what are you doing with a bad ifs?
-  
-  std::vector<glm::vec3> OBJPositions;
-  std::vector<glm::vec3> OBJNormals;
-  std::vector<glm::vec2> OBJTexCoords;
-  std::unordered_map<MTU::Helper::OBJVertexSig, uint16_t, MTU::Helper::OBJVertexSigHash> ExistingVertices;
-  uint16_t nextIdx{ 0 };// next index when adding new vertex
+  // record counts of the first streaming pass
+  struct OBJRecordCounts
+  {
+    size_t m_Positions{ 0 };
+    size_t m_Normals  { 0 };
+    size_t m_TexCoords{ 0 };
+    size_t m_Faces    { 0 };
+  };
 
-  for (std::string lineStr; std::getline(ifs, lineStr);)
+  static OBJRecordCounts countRecords(std::span<const char> srcBuffer)
   {
-    MTU::Helper::OBJLine lineOBJData{ MTU::Helper::splitLine(lineStr) };
-    switch (lineOBJData.m_FirstTokenHash)
+    OBJRecordCounts retval{};
+    scanLines(srcBuffer, [&retval](OBJLineTokens const& lineTokens)
     {
-    case "mtllib"_literalHash:
-      // OBJ material
-      outputs.m_Material = lineOBJData.m_Content;
-      break;
-    case "o"_literalHash:
-    case "g"_literalHash:
-      // OBJ name
-      outputs.m_Name = lineOBJData.m_Content;
-      break;
-    case "v"_literalHash:
-      // Vertex position
-      //if (false == settings.m_bLoadPositions)break;
-      if (glm::fvec3 tmpRes; MTU::Helper::read3floats(tmpRes, lineOBJData.m_Content))
+      switch (tokenHash(lineTokens.m_Tokens[0]))
       {
-        OBJPositions.emplace_back(std::move(tmpRes));
+      case "v"_literalHash:  ++retval.m_Positions; break;
+      case "vn"_literalHash: ++retval.m_Normals;   break;
+      case "vt"_literalHash: ++retval.m_TexCoords; break;
+      case "f"_literalHash:  ++retval.m_Faces;     break;
+      default: break;
       }
-      else
+      return true;
+    });
+    return retval;
+  }
+
+  // fills in every vertex of the unique signatures, then accumulates face
+  // normals (only where the file had none) and tangents over the triangles
+  static bool writeStreamedVertices(std::span<VTX_3D_UV_NML_TAN> dstVertices, std::span<const OBJVertexSig> uniqueSigs, std::span<const uint32_t> indices, std::span<OBJChunk> chunks)
+  {
+    OBJAttribLookup<glm::vec3> Positions{ chunks, &OBJChunk::m_Positions };
+    OBJAttribLookup<glm::vec3> Normals  { chunks, &OBJChunk::m_Normals };
+    OBJAttribLookup<glm::vec2> TexCoords{ chunks, &OBJChunk::m_TexCoords };
+
+    for (size_t i{ 0 }, t{ uniqueSigs.size() }; i < t; ++i)
+    {
+      OBJVertexSig const& refSig{ uniqueSigs[i] };
+      VTX_3D_UV_NML_TAN& refVtx{ dstVertices[i] };
+
+      glm::vec3 const* pPos{ Positions.find(refSig.m_PosIndex) };
+      if (pPos == nullptr)return false;
+      refVtx.m_Pos = *pPos;
+
+      refVtx.m_Tex = glm::vec2{ 0.0f, 0.0f };
+      if (refSig.m_TexIndex != 0)
       {
-        return false;
+        glm::vec2 const* pTex{ TexCoords.find(refSig.m_TexIndex) };
+        if (pTex == nullptr)return false;
+        refVtx.m_Tex = glm::vec2{ pTex->x, 1.0f - pTex->y };// same as aiProcess_FlipUVs
       }
-      break;
-    case "vn"_literalHash:
-      // Vertex normal
-      if (false == settings.m_bLoadNormals)break;
-      if (glm::fvec3 tmpRes; MTU::Helper::read3floats(tmpRes, lineOBJData.m_Content))
+
+      refVtx.m_Nml = glm::vec3{ 0.0f, 0.0f, 0.0f };
+      if (refSig.m_NmlIndex != 0)
       {
-        OBJNormals.emplace_back(std::move(tmpRes));
+        glm::vec3 const* pNml{ Normals.find(refSig.m_NmlIndex) };
+        if (pNml == nullptr)return false;
+        refVtx.m_Nml = *pNml;
       }
-      else
+      refVtx.m_Tan = glm::vec3{ 0.0f, 0.0f, 0.0f };
+    }
+
+    for (size_t i{ 0 }, t{ indices.size() }; i + 2 < t; i += 3)
+    {
+      VTX_3D_UV_NML_TAN* pTri[3]{ &dstVertices[indices[i]], &dstVertices[indices[i + 1]], &dstVertices[indices[i + 2]] };
+      glm::vec3 e1{ pTri[1]->m_Pos - pTri[0]->m_Pos };
+      glm::vec3 e2{ pTri[2]->m_Pos - pTri[0]->m_Pos };
+      glm::vec2 d1{ pTri[1]->m_Tex - pTri[0]->m_Tex };
+      glm::vec2 d2{ pTri[2]->m_Tex - pTri[0]->m_Tex };
+
+      glm::vec3 faceNml{ glm::cross(e1, e2) };// area weighted
+      float det{ d1.x * d2.y - d2.x * d1.y };
+      glm::vec3 faceTan{ det != 0.0f ? (e1 * d2.y - e2 * d1.y) / det : glm::vec3{ 0.0f, 0.0f, 0.0f } };
+
+      for (size_t j{ 0 }; j < 3; ++j)
       {
-        return false;
+        if (uniqueSigs[indices[i + j]].m_NmlIndex == 0)pTri[j]->m_Nml += faceNml;
+        pTri[j]->m_Tan += faceTan;
       }
-      break;
-    case "vt"_literalHash:
-      // Vertex UV
-      if (false == settings.m_bLoadTexCoords)break;
-      if (glm::fvec2 tmpRes; MTU::Helper::read2floats(tmpRes, lineOBJData.m_Content))
+    }
+
+    // Gram-Schmidt the tangents against the final normals
+    for (VTX_3D_UV_NML_TAN& x : dstVertices)
+    {
+      float nmlLen{ glm::length(x.m_Nml) };
+      x.m_Nml = nmlLen > 0.0f ? x.m_Nml / nmlLen : glm::vec3{ 0.0f, 0.0f, 1.0f };
+
+      glm::vec3 tan{ x.m_Tan - x.m_Nml * glm::dot(x.m_Nml, x.m_Tan) };
+      if (float tanLen{ glm::length(tan) }; tanLen > 0.0f)
       {
-        OBJTexCoords.emplace_back(std::move(tmpRes));
+        x.m_Tan = tan / tanLen;
       }
-      else
+      else // no usable UVs, anything perpendicular will do
       {
-        return false;
+        glm::vec3 axis{ std::abs(x.m_Nml.x) < 0.9f ? glm::vec3{ 1.0f, 0.0f, 0.0f } : glm::vec3{ 0.0f, 1.0f, 0.0f } };
+        x.m_Tan = glm::normalize(glm::cross(x.m_Nml, axis));
       }
-      break;
-    case "f"_literalHash:
-      // Triangle faces
-      //if (false == settings.m_bLoadTriangles)break;
-      if (MTU::Helper::OBJFaceContents OBJFace; MTU::Helper::splitContents(OBJFace, lineOBJData.m_Content))
+    }
+    return true;
+  }
+
+  // merge chunks in file order so the result matches a single serial pass
+  bool assembleOutputs(std::span<OBJChunk> chunks, OBJOutputs& outputs, OBJLoadSettings const& settings)
+  {
+    for (OBJChunk& x : chunks)
+    {
+      if (x.m_Name.has_value())outputs.m_Name = std::move(*x.m_Name);
+      if (x.m_Material.has_value())outputs.m_Material = std::move(*x.m_Material);
+    }
+
+    parallelFor(chunks.size(), [&chunks](size_t i) { chunks[i].dedup(); });
+
+    OBJAttribLookup<glm::vec3> Positions{ chunks, &OBJChunk::m_Positions };
+    OBJAttribLookup<glm::vec3> Normals  { chunks, &OBJChunk::m_Normals };
+    OBJAttribLookup<glm::vec2> TexCoords{ chunks, &OBJChunk::m_TexCoords };
+
+    // serial part only touches each chunk's unique vertices once
+    std::vector<std::vector<uint32_t>> Remaps(chunks.size());
+    std::vector<size_t> CornerOffsets(chunks.size() + 1, 0);// prefix sum
+    size_t totalUnique{ 0 };
+    for (OBJChunk const& x : chunks)totalUnique += x.m_Unique.size();
+    OBJVertexSigTable ExistingVertices{ chunks.size() == 1 ? 0 : totalUnique };
+    uint32_t nextIdx{ 0 };// next index when adding new vertex
+    for (size_t i{ 0 }, t{ chunks.size() }; i < t; ++i)
+    {
+      OBJChunk& refChunk{ chunks[i] };
+      CornerOffsets[i + 1] = CornerOffsets[i] + refChunk.m_LocalIndices.size();
+      Remaps[i].reserve(refChunk.m_Unique.size());
+      for (OBJVertexSig const& x : refChunk.m_Unique)
       {
-        for (size_t i{ 0 }; i < 4; ++i)// confirmed 3 valid vertices
+        // a single chunk is already deduplicated, no need to look it up again
+        if (t != 1)
         {
-          if (MTU::Helper::OBJVertexSig tmpRes; MTU::Helper::getVertexSig(tmpRes, OBJFace.m_Verts[i]))
+          if (auto [idx, bInserted]{ ExistingVertices.tryEmplace(x, nextIdx) }; false == bInserted)
           {
-            if (false == settings.m_bLoadNormals)tmpRes.m_NmlIndex = 0;
-            if (false == settings.m_bLoadTexCoords)tmpRes.m_TexIndex = 0;
-            if (decltype(ExistingVertices)::iterator found{ ExistingVertices.find(tmpRes) }; found == ExistingVertices.end())
-            {
-              // does not already exist
-              outputs.m_Positions.emplace_back(OBJPositions[tmpRes.m_PosIndex - 1]);
-              if (tmpRes.m_TexIndex != 0)
-              {
-                outputs.m_TexCoords.emplace_back(OBJPositions[tmpRes.m_TexIndex - 1]);
-              }
-              if (tmpRes.m_NmlIndex != 0)
-              {
-                outputs.m_Normals.emplace_back(OBJPositions[tmpRes.m_NmlIndex - 1]);
-              }
-              // not generating normals, maybe next time outside
-              outputs.m_Triangles.emplace_back(nextIdx);
-              ExistingVertices.emplace(std::move(tmpRes), nextIdx++);
-            }
-            else
-            {
-              // already exists
-              outputs.m_Triangles.emplace_back(found->second);
-            }
+            Remaps[i].emplace_back(idx);
+            continue;
           }
         }
+        
+        // does not already exist
+        if (glm::vec3 const* pPos{ Positions.find(x.m_PosIndex) }; pPos != nullptr)
+        {
+          outputs.m_Positions.emplace_back(*pPos);
+        }
+        else
+        {
+          return false;// face refers to a position that does not exist
+        }
+        if (x.m_TexIndex != 0)
+        {
+          if (glm::vec2 const* pTex{ TexCoords.find(x.m_TexIndex) }; pTex != nullptr)outputs.m_TexCoords.emplace_back(*pTex);
+          else return false;
+        }
+        if (x.m_NmlIndex != 0)
+        {
+          if (glm::vec3 const* pNml{ Normals.find(x.m_NmlIndex) }; pNml != nullptr)outputs.m_Normals.emplace_back(*pNml);
+          else return false;
+        }
+        Remaps[i].emplace_back(nextIdx++);
       }
-      break;// will skip face if no 3 vertices. Ignore possiblity of 4 vertices
-    default:
-      break;
     }
+
+    // not generating normals, maybe next time outside
+    // narrowest index type that fits every unique vertex
+    outputs.m_Triangles = makeIndexVector(nextIdx, settings.m_bAllowUint8Indices);
+    std::visit([&](auto& refTriangles)
+    {
+      using indexType = typename std::remove_reference_t<decltype(refTriangles)>::value_type;
+      refTriangles.resize(CornerOffsets.back());
+      parallelFor(chunks.size(), [&](size_t i)
+      {
+        indexType* pDst{ refTriangles.data() + CornerOffsets[i] };
+        for (uint32_t x : chunks[i].m_LocalIndices)
+        {
+          *pDst++ = static_cast<indexType>(Remaps[i][x]);
+        }
+      });
+    }, outputs.m_Triangles);
+    return true;
+  }
+
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+bool MTU::loadOBJ(std::ifstream& ifs, OBJOutputs& outputs, OBJLoadSettings settings)
+{
+  if (false == ifs.is_open())return false;// what are you doing with a bad ifs?
+  
+  MTU::Helper::OBJChunk OBJData;
+  for (std::string lineStr; std::getline(ifs, lineStr);)
+  {
+    if (false == OBJData.parse(lineStr, settings))return false;
   }
+  return MTU::Helper::assembleOutputs(std::span{ &OBJData, 1 }, outputs, settings);
+}
+
+bool MTU::loadOBJ(std::filesystem::path const& fPath, OBJOutputs& outputs, OBJLoadSettings settings)
+{
+  MTU::mappedFile srcFile{ fPath };
+  if (false == srcFile.OK())return false;
+  return loadOBJBuffer(srcFile.data(), outputs, settings);
+}
+
+bool MTU::loadOBJBuffer(std::span<const char> srcBuffer, OBJOutputs& outputs, OBJLoadSettings settings)
+{
+  std::vector<std::span<const char>> chunkSrcs{ MTU::Helper::splitChunks(srcBuffer, settings) };
+
+  std::vector<MTU::Helper::OBJChunk> OBJData(chunkSrcs.size());
+  std::vector<char> chunkOK(chunkSrcs.size(), false);// not vector<bool>, threads write it
+  MTU::Helper::parallelFor(chunkSrcs.size(), [&](size_t i)
+  {
+    chunkOK[i] = OBJData[i].parse(chunkSrcs[i], settings);
+  });
+  if (std::find(chunkOK.begin(), chunkOK.end(), false) != chunkOK.end())return false;
+
+  return MTU::Helper::assembleOutputs(OBJData, outputs, settings);
+}
+
+bool MTU::streamOBJ(std::filesystem::path const& fPath, OBJStreamTarget const& target, OBJStreamCounts& outCounts, OBJLoadSettings settings)
+{
+  using namespace MTU::Helper;
+  outCounts = OBJStreamCounts{};
+
+  MTU::mappedFile srcFile{ fPath };
+  if (false == srcFile.OK())return false;
+  std::span<const char> srcBuffer{ srcFile.data() };
+
+  // pass 1: count records per chunk so attributes can be sized exactly
+  std::vector<std::span<const char>> chunkSrcs{ splitChunks(srcBuffer, settings) };
+  std::vector<OBJRecordCounts> chunkCounts(chunkSrcs.size());
+  parallelFor(chunkSrcs.size(), [&](size_t i) { chunkCounts[i] = countRecords(chunkSrcs[i]); });
+
+  OBJRecordCounts totalCounts{};
+  for (OBJRecordCounts const& x : chunkCounts)
+  {
+    totalCounts.m_Positions += x.m_Positions;
+    totalCounts.m_Faces     += x.m_Faces;
+  }
+
+  // pass 2a: attributes only, faces are resolved below without storing them
+  std::vector<OBJChunk> OBJData(chunkSrcs.size());
+  std::vector<char> chunkOK(chunkSrcs.size(), false);// not vector<bool>, threads write it
+  parallelFor(chunkSrcs.size(), [&](size_t i)
+  {
+    OBJChunk& refChunk{ OBJData[i] };
+    refChunk.m_bSkipFaces = true;
+    refChunk.m_Positions.reserve(chunkCounts[i].m_Positions);
+    if (settings.m_bLoadNormals)refChunk.m_Normals.reserve(chunkCounts[i].m_Normals);
+    if (settings.m_bLoadTexCoords)refChunk.m_TexCoords.reserve(chunkCounts[i].m_TexCoords);
+    chunkOK[i] = refChunk.parse(chunkSrcs[i], settings);
+  });
+  if (std::find(chunkOK.begin(), chunkOK.end(), false) != chunkOK.end())return false;
+
+  uint32_t* pIndices{ target.m_fnGetIndexMemory(totalCounts.m_Faces * 3) };
+  if (pIndices == nullptr)return false;
+
+  // pass 2b: dedup faces in file order, indices go straight to the target
+  std::vector<OBJVertexSig> uniqueSigs;
+  uniqueSigs.reserve(totalCounts.m_Positions);
+  OBJVertexSigTable ExistingVertices{ totalCounts.m_Positions };// grows if needed
+  size_t numIndices{ 0 };
+  scanLines(srcBuffer, [&](OBJLineTokens const& lineTokens)
+  {
+    OBJVertexSig tmpRes[3];
+    if (tokenHash(lineTokens.m_Tokens[0]) != "f"_literalHash || false == getFaceSigs(tmpRes, lineTokens, settings))return true;
+    for (OBJVertexSig const& x : tmpRes)
+    {
+      auto [idx, bInserted]{ ExistingVertices.tryEmplace(x, static_cast<uint32_t>(uniqueSigs.size())) };
+      if (bInserted)uniqueSigs.emplace_back(x);
+      pIndices[numIndices++] = idx;
+    }
+    return true;
+  });
+
+  VTX_3D_UV_NML_TAN* pVertices{ target.m_fnGetVertexMemory(uniqueSigs.size()) };
+  if (pVertices == nullptr)return false;
+  if (false == writeStreamedVertices({ pVertices, uniqueSigs.size() }, uniqueSigs, { pIndices, numIndices }, OBJData))return false;
+
+  outCounts.m_IndexCount  = numIndices;
+  outCounts.m_VertexCount = uniqueSigs.size();
   return true;
 }
 
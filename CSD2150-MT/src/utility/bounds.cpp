@@ -0,0 +1,217 @@
+/*!*****************************************************************************
+ * @file    bounds.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for model bounds and batch
+ *          sphere culling
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/bounds.h>
+#include <algorithm>  // for min/max
+#include <cstring>    // for position reads
+#include <bit>        // for visible mask bits
+#include <cmath>      // for sqrt
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>          // 4 positions/spheres per step
+#define BOUNDS_SSE
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>          // 8 spheres per step, needs /arch:AVX
+#define BOUNDS_AVX
+#endif
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  static constexpr size_t s_SpherePadding{ 8 };// widest cull step
+
+  static glm::vec3 readBoundsPosition(const float* pPositions, size_t positionStride, size_t vertexIndex) noexcept
+  {
+    glm::vec3 retval;
+    std::memcpy(&retval, reinterpret_cast<const char*>(pPositions) + positionStride * vertexIndex, sizeof(float) * 3);
+    return retval;
+  }
+
+#if defined(BOUNDS_SSE)
+  // 16 bytes from the position, only for vertices that aren't the last
+  static __m128 loadBoundsPosition(const float* pPositions, size_t positionStride, size_t vertexIndex) noexcept
+  {
+    return _mm_loadu_ps(reinterpret_cast<const float*>(reinterpret_cast<const char*>(pPositions) + positionStride * vertexIndex));
+  }
+
+  static float horizontalMax(__m128 x) noexcept
+  {
+    x = _mm_max_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+    x = _mm_max_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(x);
+  }
+#endif
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::bounds MTU::computeBounds(const float* pPositions, size_t positionStride, size_t vertexCount) noexcept
+{
+  bounds retval{};
+  if (pPositions == nullptr || vertexCount == 0)return retval;
+
+  // loads read a float past the position, the last vertex is read alone
+  size_t i{ 0 };
+  glm::vec3 first{ Helper::readBoundsPosition(pPositions, positionStride, 0) };
+  retval.m_Box = aabb{ first, first };
+#if defined(BOUNDS_SSE)
+  __m128 boxMin{ _mm_setr_ps(first.x, first.y, first.z, 0.0f) }, boxMax{ boxMin };
+  for (; i + 4 < vertexCount; i += 4)
+  {
+    __m128 a{ Helper::loadBoundsPosition(pPositions, positionStride, i) };
+    __m128 b{ Helper::loadBoundsPosition(pPositions, positionStride, i + 1) };
+    __m128 c{ Helper::loadBoundsPosition(pPositions, positionStride, i + 2) };
+    __m128 d{ Helper::loadBoundsPosition(pPositions, positionStride, i + 3) };
+    boxMin = _mm_min_ps(boxMin, _mm_min_ps(_mm_min_ps(a, b), _mm_min_ps(c, d)));
+    boxMax = _mm_max_ps(boxMax, _mm_max_ps(_mm_max_ps(a, b), _mm_max_ps(c, d)));
+  }
+  alignas(16) float lanes[2][4];
+  _mm_store_ps(lanes[0], boxMin);
+  _mm_store_ps(lanes[1], boxMax);
+  retval.m_Box = aabb{ glm::vec3{ lanes[0][0], lanes[0][1], lanes[0][2] }, glm::vec3{ lanes[1][0], lanes[1][1], lanes[1][2] } };
+#endif
+  for (; i < vertexCount; ++i)
+  {
+    glm::vec3 x{ Helper::readBoundsPosition(pPositions, positionStride, i) };
+    retval.m_Box.m_Min = glm::min(retval.m_Box.m_Min, x);
+    retval.m_Box.m_Max = glm::max(retval.m_Box.m_Max, x);
+  }
+
+  // farthest position from the box center, transposed to 4 x/y/z at a time
+  glm::vec3 center{ (retval.m_Box.m_Min + retval.m_Box.m_Max) * 0.5f };
+  float maxDist2{ 0.0f };
+  i = 0;
+#if defined(BOUNDS_SSE)
+  __m128 cx{ _mm_set1_ps(center.x) }, cy{ _mm_set1_ps(center.y) }, cz{ _mm_set1_ps(center.z) };
+  __m128 dist2Max{ _mm_setzero_ps() };
+  for (; i + 4 < vertexCount; i += 4)
+  {
+    __m128 x{ Helper::loadBoundsPosition(pPositions, positionStride, i) };
+    __m128 y{ Helper::loadBoundsPosition(pPositions, positionStride, i + 1) };
+    __m128 z{ Helper::loadBoundsPosition(pPositions, positionStride, i + 2) };
+    __m128 w{ Helper::loadBoundsPosition(pPositions, positionStride, i + 3) };
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    __m128 dx{ _mm_sub_ps(x, cx) }, dy{ _mm_sub_ps(y, cy) }, dz{ _mm_sub_ps(z, cz) };
+    dist2Max = _mm_max_ps(dist2Max, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+  }
+  maxDist2 = Helper::horizontalMax(dist2Max);
+#endif
+  for (; i < vertexCount; ++i)
+  {
+    glm::vec3 d{ Helper::readBoundsPosition(pPositions, positionStride, i) - center };
+    maxDist2 = std::max(maxDist2, glm::dot(d, d));
+  }
+  retval.m_Sphere = glm::vec4{ center, std::sqrt(maxDist2) };
+  return retval;
+}
+
+glm::vec4 MTU::transformSphere(glm::vec4 const& sphere, glm::mat4 const& M2W) noexcept
+{
+  glm::vec3 center{ M2W * glm::vec4{ glm::vec3{ sphere }, 1.0f } };
+  float scale{ std::max({ glm::length(glm::vec3{ M2W[0] }), glm::length(glm::vec3{ M2W[1] }), glm::length(glm::vec3{ M2W[2] }) }) };
+  return glm::vec4{ center, sphere.w * scale };
+}
+
+void MTU::sphereSet::clear() noexcept
+{
+  for (std::vector<float>& x : m_Components)x.clear();
+  m_Count = 0;
+}
+
+void MTU::sphereSet::reserve(size_t count)
+{
+  count = (count + Helper::s_SpherePadding - 1) & ~(Helper::s_SpherePadding - 1);
+  for (std::vector<float>& x : m_Components)x.reserve(count);
+}
+
+uint32_t MTU::sphereSet::add(glm::vec4 const& sphere)
+{
+  // padding has a negative radius, it fails every plane
+  if (m_Count == m_Components[E_RADIUS].size())
+  {
+    for (int i{ 0 }; i < E_RADIUS; ++i)m_Components[i].resize(m_Count + Helper::s_SpherePadding, 0.0f);
+    m_Components[E_RADIUS].resize(m_Count + Helper::s_SpherePadding, -1.0f);
+  }
+  m_Components[E_CENTER_X][m_Count] = sphere.x;
+  m_Components[E_CENTER_Y][m_Count] = sphere.y;
+  m_Components[E_CENTER_Z][m_Count] = sphere.z;
+  m_Components[E_RADIUS][m_Count]   = sphere.w;
+  return m_Count++;
+}
+
+void MTU::sphereSet::cull(frustum const& worldFrustum, std::vector<uint32_t>& outVisible) const
+{
+  outVisible.clear();
+
+  // visible if inside/touching every plane: dot(plane, center) + w >= -radius
+#if defined(BOUNDS_AVX)
+  __m256 planes[frustum::E_NUM_PLANES][4];
+  for (int i{ 0 }; i < frustum::E_NUM_PLANES; ++i)
+  {
+    for (int j{ 0 }; j < 4; ++j)planes[i][j] = _mm256_set1_ps(worldFrustum.m_Planes[i][j]);
+  }
+  for (uint32_t i{ 0 }; i < m_Count; i += 8)
+  {
+    __m256 cx{ _mm256_loadu_ps(&m_Components[E_CENTER_X][i]) };
+    __m256 cy{ _mm256_loadu_ps(&m_Components[E_CENTER_Y][i]) };
+    __m256 cz{ _mm256_loadu_ps(&m_Components[E_CENTER_Z][i]) };
+    __m256 radius{ _mm256_loadu_ps(&m_Components[E_RADIUS][i]) };
+    __m256 negRadius{ _mm256_sub_ps(_mm256_setzero_ps(), radius) };
+
+    __m256 visible{ _mm256_cmp_ps(radius, _mm256_setzero_ps(), _CMP_GE_OQ) };
+    for (int j{ 0 }; j < frustum::E_NUM_PLANES; ++j)
+    {
+      __m256 dist{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planes[j][0], cx), _mm256_mul_ps(planes[j][1], cy)), _mm256_add_ps(_mm256_mul_ps(planes[j][2], cz), planes[j][3])) };
+      visible = _mm256_and_ps(visible, _mm256_cmp_ps(dist, negRadius, _CMP_GE_OQ));
+    }
+    for (int mask{ _mm256_movemask_ps(visible) }; mask; mask &= mask - 1)
+    {
+      outVisible.emplace_back(i + static_cast<uint32_t>(std::countr_zero(static_cast<unsigned>(mask))));
+    }
+  }
+#elif defined(BOUNDS_SSE)
+  __m128 planes[frustum::E_NUM_PLANES][4];
+  for (int i{ 0 }; i < frustum::E_NUM_PLANES; ++i)
+  {
+    for (int j{ 0 }; j < 4; ++j)planes[i][j] = _mm_set1_ps(worldFrustum.m_Planes[i][j]);
+  }
+  for (uint32_t i{ 0 }; i < m_Count; i += 4)
+  {
+    __m128 cx{ _mm_loadu_ps(&m_Components[E_CENTER_X][i]) };
+    __m128 cy{ _mm_loadu_ps(&m_Components[E_CENTER_Y][i]) };
+    __m128 cz{ _mm_loadu_ps(&m_Components[E_CENTER_Z][i]) };
+    __m128 radius{ _mm_loadu_ps(&m_Components[E_RADIUS][i]) };
+    __m128 negRadius{ _mm_sub_ps(_mm_setzero_ps(), radius) };
+
+    __m128 visible{ _mm_cmpge_ps(radius, _mm_setzero_ps()) };
+    for (int j{ 0 }; j < frustum::E_NUM_PLANES; ++j)
+    {
+      __m128 dist{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes[j][0], cx), _mm_mul_ps(planes[j][1], cy)), _mm_add_ps(_mm_mul_ps(planes[j][2], cz), planes[j][3])) };
+      visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, negRadius));
+    }
+    for (int mask{ _mm_movemask_ps(visible) }; mask; mask &= mask - 1)
+    {
+      outVisible.emplace_back(i + static_cast<uint32_t>(std::countr_zero(static_cast<unsigned>(mask))));
+    }
+  }
+#else
+  for (uint32_t i{ 0 }; i < m_Count; ++i)
+  {
+    glm::vec3 center{ m_Components[E_CENTER_X][i], m_Components[E_CENTER_Y][i], m_Components[E_CENTER_Z][i] };
+    if (isSphereInFrustum(worldFrustum, center, m_Components[E_RADIUS][i]))outVisible.emplace_back(i);
+  }
+#endif
+}
+
+// *****************************************************************************
@@ -0,0 +1,74 @@
+/*!*****************************************************************************
+ * @file    framePacer.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the frame pacer
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/framePacer.h>
+#include <utility/windowsInclude.h>
+#include <thread>     // for sleep_for, yield
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002// Windows 10 1803 SDK
+#endif//CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::framePacer::framePacer() :
+  m_hTimer{ CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS) }
+{
+
+}
+
+MTU::framePacer::~framePacer()
+{
+  if (m_hTimer != nullptr)CloseHandle(m_hTimer);
+}
+
+void MTU::framePacer::setFrameRateCap(double framesPerSecond) noexcept
+{
+  m_Period = framesPerSecond > 0.0 ?
+    std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>{ 1.0 / framesPerSecond }) :
+    clock::duration{ 0 };
+  m_NextFrame = clock::now();
+}
+
+double MTU::framePacer::getFrameRateCap() const noexcept
+{
+  return m_Period.count() ? 1.0 / std::chrono::duration<double>{ m_Period }.count() : 0.0;
+}
+
+MTU::framePacer::clock::duration MTU::framePacer::pace()
+{
+  clock::time_point start{ clock::now() };
+  if (m_Period.count() == 0)return clock::duration{ 0 };
+  if (start - m_NextFrame > m_Period)m_NextFrame = start;
+
+  if (clock::duration remaining{ m_NextFrame - start }; remaining > s_SpinMargin)sleepFor(remaining - s_SpinMargin);
+  while (clock::now() < m_NextFrame)std::this_thread::yield();
+
+  m_NextFrame += m_Period;
+  return clock::now() - start;
+}
+
+// *****************************************************************************
+// ****************************************************** PRIVATE FUNCTIONS ****
+
+void MTU::framePacer::sleepFor(clock::duration duration)
+{
+  // relative due times are negative, in 100ns
+  LARGE_INTEGER dueTime{};
+  dueTime.QuadPart = -std::chrono::duration_cast<std::chrono::duration<LONGLONG, std::ratio<1, 10'000'000>>>(duration).count();
+  if (m_hTimer != nullptr && SetWaitableTimer(m_hTimer, &dueTime, 0, nullptr, nullptr, FALSE))
+  {
+    WaitForSingleObject(m_hTimer, INFINITE);
+    return;
+  }
+  std::this_thread::sleep_for(duration);
+}
+
+// *****************************************************************************
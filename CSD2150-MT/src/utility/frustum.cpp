@@ -0,0 +1,47 @@
+/*!*****************************************************************************
+ * @file    frustum.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the frustum helpers
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/frustum.h>
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::frustum MTU::extractFrustum(glm::mat4 const& toClip) noexcept
+{
+  // glm is column major, row i is toClip[0..3][i]
+  glm::vec4 row[4];
+  for (int i{ 0 }; i < 4; ++i)row[i] = glm::vec4{ toClip[0][i], toClip[1][i], toClip[2][i], toClip[3][i] };
+
+  frustum retval;
+  retval.m_Planes[frustum::E_LEFT]    = row[3] + row[0];
+  retval.m_Planes[frustum::E_RIGHT]   = row[3] - row[0];
+  retval.m_Planes[frustum::E_BOTTOM]  = row[3] + row[1];
+  retval.m_Planes[frustum::E_TOP]     = row[3] - row[1];
+  retval.m_Planes[frustum::E_NEAR]    = row[2];         // 0 <= z, not -w <= z
+  retval.m_Planes[frustum::E_FAR]     = row[3] - row[2];
+
+  // unit normals so the plane distance is a real distance for spheres
+  for (glm::vec4& x : retval.m_Planes)
+  {
+    float len{ glm::length(glm::vec3{ x.x, x.y, x.z }) };
+    if (len > 0.0f)x = x / len;
+  }
+  return retval;
+}
+
+bool MTU::isSphereInFrustum(frustum const& inFrustum, glm::vec3 const& center, float radius) noexcept
+{
+  for (glm::vec4 const& x : inFrustum.m_Planes)
+  {
+    if (x.x * center.x + x.y * center.y + x.z * center.z + x.w < -radius)return false;
+  }
+  return true;
+}
+
+// *****************************************************************************
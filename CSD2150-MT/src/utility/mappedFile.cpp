@@ -0,0 +1,121 @@
+/*!*****************************************************************************
+ * @file    mappedFile.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for a read only memory
+ *          mapped file
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/mappedFile.h>
+#include <utility/windowsInclude.h>
+#include <utility>  // std::exchange
+
+MTU::mappedFile::mappedFile(std::filesystem::path const& fPath)
+{
+  open(fPath);
+}
+
+MTU::mappedFile::~mappedFile()
+{
+  close();
+}
+
+MTU::mappedFile::mappedFile(mappedFile&& other) noexcept :
+  m_hFile   { std::exchange(other.m_hFile, nullptr) },
+  m_hMapping{ std::exchange(other.m_hMapping, nullptr) },
+  m_pView   { std::exchange(other.m_pView, nullptr) },
+  m_Size    { std::exchange(other.m_Size, 0) },
+  m_bOpen   { std::exchange(other.m_bOpen, false) }
+{
+
+}
+
+MTU::mappedFile& MTU::mappedFile::operator=(mappedFile&& other) noexcept
+{
+  if (this == &other)return *this;
+  close();
+  m_hFile     = std::exchange(other.m_hFile, nullptr);
+  m_hMapping  = std::exchange(other.m_hMapping, nullptr);
+  m_pView     = std::exchange(other.m_pView, nullptr);
+  m_Size      = std::exchange(other.m_Size, 0);
+  m_bOpen     = std::exchange(other.m_bOpen, false);
+  return *this;
+}
+
+bool MTU::mappedFile::open(std::filesystem::path const& fPath)
+{
+  close();
+
+  HANDLE hFile
+  {
+    CreateFileW
+    (
+      fPath.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,  // parsers go in order
+      nullptr
+    )
+  };
+  if (hFile == INVALID_HANDLE_VALUE)return false;
+  m_hFile = hFile;
+
+  LARGE_INTEGER fileSize;
+  if (FALSE == GetFileSizeEx(hFile, &fileSize) || static_cast<unsigned long long>(fileSize.QuadPart) > SIZE_MAX)
+  {
+    close();
+    return false;
+  }
+  m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+  // cannot map an empty file, but an empty file is still a valid file
+  if (m_Size != 0)
+  {
+    m_hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr)
+    {
+      close();
+      return false;
+    }
+    m_pView = static_cast<const char*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_pView == nullptr)
+    {
+      close();
+      return false;
+    }
+  }
+
+  m_bOpen = true;
+  return true;
+}
+
+void MTU::mappedFile::close() noexcept
+{
+  if (m_pView != nullptr)UnmapViewOfFile(m_pView);
+  if (m_hMapping != nullptr)CloseHandle(m_hMapping);
+  if (m_hFile != nullptr)CloseHandle(m_hFile);
+  m_pView     = nullptr;
+  m_hMapping  = nullptr;
+  m_hFile     = nullptr;
+  m_Size      = 0;
+  m_bOpen     = false;
+}
+
+bool MTU::mappedFile::OK() const noexcept
+{
+  return m_bOpen;
+}
+
+std::span<const char> MTU::mappedFile::data() const noexcept
+{
+  return std::span<const char>{ m_pView, m_Size };
+}
+
+size_t MTU::mappedFile::size() const noexcept
+{
+  return m_Size;
+}
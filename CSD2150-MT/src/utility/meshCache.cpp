@@ -0,0 +1,187 @@
+/*!*****************************************************************************
+ * @file    meshCache.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the cooked mesh cache
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/meshCache.h>
+#include <utility/CStrHash.hpp> // for path hashing
+#include <fstream>              // for writing the cache
+#include <cstring>              // for reading the header
+#include <charconv>             // for the key hash in the file name
+#include <atomic>               // for unique temporary files
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  struct meshSourceStats
+  {
+    uint64_t  m_PathHash{ 0 };
+    int64_t   m_MTime   { 0 };
+    uint64_t  m_Size    { 0 };
+  };
+
+  static bool getSourceStats(std::filesystem::path const& sourcePath, meshSourceStats& outStats)
+  {
+    std::error_code ec;
+    std::filesystem::path fullPath{ std::filesystem::weakly_canonical(sourcePath, ec) };
+    if (ec)return false;
+    std::filesystem::file_time_type mTime{ std::filesystem::last_write_time(fullPath, ec) };
+    if (ec)return false;
+    uintmax_t fileSize{ std::filesystem::file_size(fullPath, ec) };
+    if (ec)return false;
+
+    outStats.m_PathHash = strHash(fullPath.generic_string());
+    outStats.m_MTime    = static_cast<int64_t>(mTime.time_since_epoch().count());
+    outStats.m_Size     = static_cast<uint64_t>(fileSize);
+    return true;
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+bool MTU::cookedMesh::open(meshCacheKey const& inKey)
+{
+  m_File.close();
+  m_Header = meshCacheHeader{};
+
+  Helper::meshSourceStats srcStats;
+  if (false == Helper::getSourceStats(inKey.m_SourcePath, srcStats))return false;
+  if (false == m_File.open(getMeshCachePath(inKey)))return false;
+
+  std::span<const char> fileBytes{ m_File.data() };
+  if (fileBytes.size() < sizeof(meshCacheHeader))
+  {
+    m_File.close();
+    return false;
+  }
+  std::memcpy(&m_Header, fileBytes.data(), sizeof(meshCacheHeader));
+
+  // anything different means the cache is stale, cook it again
+  if
+  (
+    m_Header.m_Magic        != meshCacheHeader::s_Magic   ||
+    m_Header.m_Version      != meshCacheHeader::s_Version ||
+    m_Header.m_PathHash     != srcStats.m_PathHash        ||
+    m_Header.m_ImportFlags  != inKey.m_ImportFlags        ||
+    m_Header.m_CookFlags    != inKey.m_CookFlags          ||
+    m_Header.m_VertexStride != inKey.m_VertexStride       ||
+    m_Header.m_SourceMTime  != srcStats.m_MTime           ||
+    m_Header.m_SourceSize   != srcStats.m_Size            ||
+    fileBytes.size() != sizeof(meshCacheHeader) +
+      static_cast<size_t>(m_Header.m_VertexCount) * m_Header.m_VertexStride +
+      static_cast<size_t>(m_Header.m_IndexCount) * m_Header.m_IndexSize +
+      static_cast<size_t>(m_Header.m_MeshletCount) * m_Header.m_MeshletStride +
+      static_cast<size_t>(m_Header.m_LODCount) * m_Header.m_LODStride
+  )
+  {
+    m_File.close();
+    m_Header = meshCacheHeader{};
+    return false;
+  }
+  return true;
+}
+
+MTU::meshCacheHeader const& MTU::cookedMesh::getHeader() const noexcept
+{
+  return m_Header;
+}
+
+std::span<const std::byte> MTU::cookedMesh::getVertexBytes() const noexcept
+{
+  if (false == m_File.OK())return {};
+  return std::as_bytes(m_File.data()).subspan(sizeof(meshCacheHeader), static_cast<size_t>(m_Header.m_VertexCount) * m_Header.m_VertexStride);
+}
+
+std::span<const std::byte> MTU::cookedMesh::getIndexBytes() const noexcept
+{
+  if (false == m_File.OK())return {};
+  return std::as_bytes(m_File.data()).subspan(sizeof(meshCacheHeader) + static_cast<size_t>(m_Header.m_VertexCount) * m_Header.m_VertexStride, static_cast<size_t>(m_Header.m_IndexCount) * m_Header.m_IndexSize);
+}
+
+std::span<const std::byte> MTU::cookedMesh::getMeshletBytes() const noexcept
+{
+  if (false == m_File.OK())return {};
+  return std::as_bytes(m_File.data()).subspan(sizeof(meshCacheHeader) + static_cast<size_t>(m_Header.m_VertexCount) * m_Header.m_VertexStride + static_cast<size_t>(m_Header.m_IndexCount) * m_Header.m_IndexSize, static_cast<size_t>(m_Header.m_MeshletCount) * m_Header.m_MeshletStride);
+}
+
+std::span<const std::byte> MTU::cookedMesh::getLODBytes() const noexcept
+{
+  if (false == m_File.OK())return {};
+  return std::as_bytes(m_File.data()).subspan(sizeof(meshCacheHeader) + static_cast<size_t>(m_Header.m_VertexCount) * m_Header.m_VertexStride + static_cast<size_t>(m_Header.m_IndexCount) * m_Header.m_IndexSize + static_cast<size_t>(m_Header.m_MeshletCount) * m_Header.m_MeshletStride);
+}
+
+std::filesystem::path MTU::getMeshCachePath(meshCacheKey const& inKey)
+{
+  uint64_t keyBits[]{ inKey.m_ImportFlags, inKey.m_CookFlags, inKey.m_VertexStride };
+  uint64_t keyHash{ cstrHash(reinterpret_cast<const char*>(keyBits), sizeof(keyBits)) };
+
+  // Skull_textured.fbx.<hash>.mtumesh
+  char hexHash[17]{};
+  std::to_chars(hexHash, hexHash + 16, keyHash, 16);
+  std::filesystem::path retval{ inKey.m_SourcePath };
+  return retval.concat(".").concat(hexHash).concat(".mtumesh");
+}
+
+bool MTU::writeMeshCache
+(
+  meshCacheKey const& inKey,
+  meshCacheHeader const& inHeader,
+  std::span<const std::byte> vertexBytes,
+  std::span<const std::byte> indexBytes,
+  std::span<const std::byte> meshletBytes,
+  std::span<const std::byte> lodBytes
+)
+{
+  Helper::meshSourceStats srcStats;
+  if (false == Helper::getSourceStats(inKey.m_SourcePath, srcStats))return false;
+
+  meshCacheHeader Header{ inHeader };
+  Header.m_Magic        = meshCacheHeader::s_Magic;
+  Header.m_Version      = meshCacheHeader::s_Version;
+  Header.m_PathHash     = srcStats.m_PathHash;
+  Header.m_ImportFlags  = inKey.m_ImportFlags;
+  Header.m_CookFlags    = inKey.m_CookFlags;
+  Header.m_SourceMTime  = srcStats.m_MTime;
+  Header.m_SourceSize   = srcStats.m_Size;
+
+  // write beside it and swap in, a crash mid write never leaves a bad cache.
+  // Every write gets its own temporary, loads in one batch may share a key.
+  static std::atomic<uint32_t> s_TmpCounter{ 0 };
+  std::filesystem::path cachePath{ getMeshCachePath(inKey) };
+  std::filesystem::path tmpPath{ cachePath };
+  tmpPath.concat(".").concat(std::to_string(s_TmpCounter.fetch_add(1, std::memory_order_relaxed))).concat(".tmp");
+  {
+    std::ofstream ofs{ tmpPath, std::ios::binary | std::ios::trunc };
+    if (false == ofs.is_open())return false;
+    ofs.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+    ofs.write(reinterpret_cast<const char*>(vertexBytes.data()), static_cast<std::streamsize>(vertexBytes.size()));
+    ofs.write(reinterpret_cast<const char*>(indexBytes.data()), static_cast<std::streamsize>(indexBytes.size()));
+    ofs.write(reinterpret_cast<const char*>(meshletBytes.data()), static_cast<std::streamsize>(meshletBytes.size()));
+    ofs.write(reinterpret_cast<const char*>(lodBytes.data()), static_cast<std::streamsize>(lodBytes.size()));
+    if (false == ofs.good())
+    {
+      ofs.close();
+      std::error_code ec;
+      std::filesystem::remove(tmpPath, ec);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, cachePath, ec);
+  if (ec)
+  {
+    std::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+  return true;
+}
+
+// *****************************************************************************
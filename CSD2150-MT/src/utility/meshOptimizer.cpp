@@ -0,0 +1,283 @@
+/*!*****************************************************************************
+ * @file    meshOptimizer.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the post import mesh
+ *          optimization passes
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/meshOptimizer.h>
+#include <glm/glm.hpp>  // for cluster centroids and normals
+#include <algorithm>    // for cluster sort
+#include <cstring>      // for position reads
+#include <cmath>        // for vertex scores
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  // Forsyth's constants, "Linear-Speed Vertex Cache Optimisation"
+  static constexpr int    s_ForsythCacheSize      { 32 };
+  static constexpr float  s_ForsythDecayPower     { 1.5f };
+  static constexpr float  s_ForsythLastTriScore   { 0.75f };
+  static constexpr float  s_ForsythValenceScale   { 2.0f };
+  static constexpr float  s_ForsythValencePower   { 0.5f };
+  static constexpr uint32_t s_NoTriangle          { UINT32_MAX };
+
+  static float forsythVertexScore(int cachePos, uint32_t remainingValence) noexcept
+  {
+    if (remainingValence == 0)return -1.0f;// no triangles left, never wanted
+
+    float retval{ 0.0f };
+    if (cachePos >= 0)
+    {
+      if (cachePos < 3)
+      {
+        retval = s_ForsythLastTriScore;// just used, fixed score so strips don't win
+      }
+      else
+      {
+        float scaler{ 1.0f / static_cast<float>(s_ForsythCacheSize - 3) };
+        retval = std::pow(1.0f - static_cast<float>(cachePos - 3) * scaler, s_ForsythDecayPower);
+      }
+    }
+    // boost vertices with few triangles left so they get finished off
+    return retval + s_ForsythValenceScale * std::pow(static_cast<float>(remainingValence), -s_ForsythValencePower);
+  }
+
+  static glm::vec3 readPosition(const float* pPositions, size_t positionStride, uint32_t vertexIndex) noexcept
+  {
+    glm::vec3 retval;
+    std::memcpy(&retval, reinterpret_cast<const char*>(pPositions) + positionStride * vertexIndex, sizeof(float) * 3);
+    return retval;
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::vertexCacheStats MTU::analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize)
+{
+  // FIFO, a hit does not move the vertex like it would in an LRU
+  std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+  std::vector<char> bReferenced(vertexCount, false);
+  uint32_t timestamp{ cacheSize + 1 };
+  size_t misses{ 0 }, referenced{ 0 };
+  for (uint32_t x : indices)
+  {
+    if (timestamp - cacheTimestamps[x] > cacheSize)
+    {
+      cacheTimestamps[x] = timestamp++;
+      ++misses;
+    }
+    if (false == bReferenced[x])
+    {
+      bReferenced[x] = true;
+      ++referenced;
+    }
+  }
+
+  vertexCacheStats retval{};
+  if (size_t triCount{ indices.size() / 3 }; triCount)retval.m_ACMR = static_cast<float>(misses) / static_cast<float>(triCount);
+  if (referenced)retval.m_ATVR = static_cast<float>(misses) / static_cast<float>(referenced);
+  return retval;
+}
+
+void MTU::optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount)
+{
+  using namespace MTU::Helper;
+  const size_t triCount{ indices.size() / 3 };
+  if (triCount == 0)return;
+
+  // triangles using each vertex, live ones are kept at the front of each range
+  std::vector<uint32_t> valence(vertexCount, 0);
+  for (size_t i{ 0 }; i < triCount * 3; ++i)++valence[indices[i]];
+
+  std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+  for (size_t i{ 0 }; i < vertexCount; ++i)adjacencyOffsets[i + 1] = adjacencyOffsets[i] + valence[i];
+
+  std::vector<uint32_t> adjacency(triCount * 3);
+  {
+    std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i{ 0 }; i < triCount * 3; ++i)adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+  }
+
+  std::vector<int>    cachePos(vertexCount, -1);
+  std::vector<float>  vertScore(vertexCount);
+  for (size_t i{ 0 }; i < vertexCount; ++i)vertScore[i] = forsythVertexScore(-1, valence[i]);
+
+  std::vector<float>  triScore(triCount);
+  std::vector<char>   bEmitted(triCount, false);
+  uint32_t bestTri{ 0 };
+  for (size_t i{ 0 }; i < triCount; ++i)
+  {
+    triScore[i] = vertScore[indices[i * 3]] + vertScore[indices[i * 3 + 1]] + vertScore[indices[i * 3 + 2]];
+    if (triScore[i] > triScore[bestTri])bestTri = static_cast<uint32_t>(i);
+  }
+
+  std::vector<uint32_t> output(triCount * 3);
+  uint32_t cache[s_ForsythCacheSize + 3];
+  int cacheCount{ 0 };
+  size_t fallbackCursor{ 0 };// input order fallback when the cache has nothing
+
+  for (size_t outTri{ 0 }; outTri < triCount; ++outTri)
+  {
+    if (bestTri == s_NoTriangle)
+    {
+      while (bEmitted[fallbackCursor])++fallbackCursor;
+      bestTri = static_cast<uint32_t>(fallbackCursor);
+    }
+
+    const uint32_t* pTri{ &indices[static_cast<size_t>(bestTri) * 3] };
+    std::copy(pTri, pTri + 3, &output[outTri * 3]);
+    bEmitted[bestTri] = true;
+
+    // remove the triangle from its vertices' live ranges
+    for (int i{ 0 }; i < 3; ++i)
+    {
+      uint32_t v{ pTri[i] };
+      uint32_t* pBegin{ &adjacency[adjacencyOffsets[v]] };
+      uint32_t* pEnd{ pBegin + valence[v] };
+      *std::find(pBegin, pEnd, bestTri) = *(pEnd - 1);
+      --valence[v];
+    }
+
+    // LRU: the triangle's vertices go to the front, the rest shift back
+    uint32_t newCache[s_ForsythCacheSize + 3];
+    int newCount{ 0 };
+    for (int i{ 0 }; i < 3; ++i)newCache[newCount++] = pTri[i];
+    for (int i{ 0 }; i < cacheCount; ++i)
+    {
+      uint32_t v{ cache[i] };
+      if (v != pTri[0] && v != pTri[1] && v != pTri[2])newCache[newCount++] = v;
+    }
+
+    // rescore the vertices that moved, including the ones pushed out
+    for (int i{ 0 }; i < newCount; ++i)
+    {
+      uint32_t v{ newCache[i] };
+      cachePos[v] = i < s_ForsythCacheSize ? i : -1;
+      vertScore[v] = forsythVertexScore(cachePos[v], valence[v]);
+    }
+
+    // only triangles touching the cache can have changed, best comes from them
+    bestTri = s_NoTriangle;
+    float bestScore{ -1.0f };
+    for (int i{ 0 }; i < newCount; ++i)
+    {
+      uint32_t v{ newCache[i] };
+      for (uint32_t j{ adjacencyOffsets[v] }, k{ adjacencyOffsets[v] + valence[v] }; j < k; ++j)
+      {
+        uint32_t t{ adjacency[j] };
+        triScore[t] = vertScore[indices[t * 3]] + vertScore[indices[t * 3 + 1]] + vertScore[indices[t * 3 + 2]];
+        if (triScore[t] > bestScore)
+        {
+          bestScore = triScore[t];
+          bestTri = t;
+        }
+      }
+    }
+
+    cacheCount = std::min(newCount, s_ForsythCacheSize);
+    std::copy(newCache, newCache + cacheCount, cache);
+  }
+
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void MTU::optimizeOverdraw(std::span<uint32_t> indices, const float* pPositions, size_t positionStride, size_t vertexCount)
+{
+  using namespace MTU::Helper;
+  const size_t triCount{ indices.size() / 3 };
+  if (triCount == 0)return;
+
+  // cluster boundaries at hard cache flushes (all 3 vertices missed), so
+  // shuffling whole clusters barely changes the cache behaviour
+  static constexpr uint32_t s_ClusterCacheSize{ 16 };
+  std::vector<uint32_t> clusterStarts{ 0 };
+  {
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+    uint32_t timestamp{ s_ClusterCacheSize + 1 };
+    for (size_t i{ 0 }; i < triCount; ++i)
+    {
+      int misses{ 0 };
+      for (size_t j{ 0 }; j < 3; ++j)
+      {
+        uint32_t v{ indices[i * 3 + j] };
+        if (timestamp - cacheTimestamps[v] > s_ClusterCacheSize)
+        {
+          cacheTimestamps[v] = timestamp++;
+          ++misses;
+        }
+      }
+      if (misses == 3 && i != 0)clusterStarts.emplace_back(static_cast<uint32_t>(i));
+    }
+  }
+  clusterStarts.emplace_back(static_cast<uint32_t>(triCount));
+  const size_t clusterCount{ clusterStarts.size() - 1 };
+
+  // area weighted centroids and normals, per cluster and for the whole mesh
+  std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3{ 0.0f, 0.0f, 0.0f });
+  std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3{ 0.0f, 0.0f, 0.0f });
+  glm::vec3 meshCentroid{ 0.0f, 0.0f, 0.0f };
+  float meshArea{ 0.0f };
+  for (size_t c{ 0 }; c < clusterCount; ++c)
+  {
+    float clusterArea{ 0.0f };
+    for (uint32_t i{ clusterStarts[c] }; i < clusterStarts[c + 1]; ++i)
+    {
+      glm::vec3 p0{ readPosition(pPositions, positionStride, indices[i * 3]) };
+      glm::vec3 p1{ readPosition(pPositions, positionStride, indices[i * 3 + 1]) };
+      glm::vec3 p2{ readPosition(pPositions, positionStride, indices[i * 3 + 2]) };
+      glm::vec3 nml{ glm::cross(p1 - p0, p2 - p0) };
+      float area{ glm::length(nml) };
+      glm::vec3 centroid{ (p0 + p1 + p2) * (1.0f / 3.0f) };
+
+      clusterNormals[c] += nml;
+      clusterCentroids[c] += centroid * area;
+      clusterArea += area;
+    }
+    meshCentroid += clusterCentroids[c];
+    meshArea += clusterArea;
+
+    if (clusterArea > 0.0f)clusterCentroids[c] = clusterCentroids[c] / clusterArea;
+    if (float len{ glm::length(clusterNormals[c]) }; len > 0.0f)clusterNormals[c] = clusterNormals[c] / len;
+  }
+  if (meshArea > 0.0f)meshCentroid = meshCentroid / meshArea;
+
+  // further out along its own normal means more likely to occlude, draw first
+  std::vector<float> clusterSortKeys(clusterCount);
+  std::vector<uint32_t> clusterOrder(clusterCount);
+  for (size_t c{ 0 }; c < clusterCount; ++c)
+  {
+    clusterSortKeys[c] = glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c]);
+    clusterOrder[c] = static_cast<uint32_t>(c);
+  }
+  std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](uint32_t lhs, uint32_t rhs) { return clusterSortKeys[lhs] > clusterSortKeys[rhs]; });
+
+  std::vector<uint32_t> output;
+  output.reserve(triCount * 3);
+  for (uint32_t c : clusterOrder)
+  {
+    output.insert(output.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+  }
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+std::vector<uint32_t> MTU::optimizeVertexFetch(std::span<uint32_t> indices, size_t vertexCount)
+{
+  std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+  uint32_t nextVertex{ 0 };
+  for (uint32_t& x : indices)
+  {
+    if (remap[x] == UINT32_MAX)remap[x] = nextVertex++;
+    x = remap[x];
+  }
+  for (uint32_t& x : remap)if (x == UINT32_MAX)x = nextVertex++;// unused, keep at the back
+  return remap;
+}
+
+// *****************************************************************************
@@ -0,0 +1,357 @@
+/*!*****************************************************************************
+ * @file    meshSimplifier.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the mesh simplifier
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/meshSimplifier.h>
+#include <unordered_map>  // for welding and edges
+#include <glm/glm.hpp>    // for positions
+#include <algorithm>      // for min/max
+#include <cstring>        // for vertex reads
+#include <queue>          // for the collapse order
+#include <array>          // for triangles
+#include <cmath>          // for sqrt
+#include <cfloat>         // for FLT_MAX
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  // border/seam edges keep their shape this much harder than open surface
+  static constexpr double s_EdgePenaltyWeight{ 10.0 };
+
+  // symmetric 4x4 plane quadric, doubles since the sums cancel a lot
+  struct quadric
+  {
+    double m_A2{ 0 }, m_AB{ 0 }, m_AC{ 0 }, m_AD{ 0 };
+    double m_B2{ 0 }, m_BC{ 0 }, m_BD{ 0 };
+    double m_C2{ 0 }, m_CD{ 0 };
+    double m_D2{ 0 };
+    double m_Weight{ 0 };
+
+    void addPlane(glm::vec3 const& n, float d, double weight) noexcept
+    {
+      double a{ n.x }, b{ n.y }, c{ n.z }, dd{ d };
+      m_A2 += weight * a * a;  m_AB += weight * a * b;  m_AC += weight * a * c;  m_AD += weight * a * dd;
+      m_B2 += weight * b * b;  m_BC += weight * b * c;  m_BD += weight * b * dd;
+      m_C2 += weight * c * c;  m_CD += weight * c * dd;
+      m_D2 += weight * dd * dd;
+      m_Weight += weight;
+    }
+
+    quadric& operator+=(quadric const& rhs) noexcept
+    {
+      m_A2 += rhs.m_A2; m_AB += rhs.m_AB; m_AC += rhs.m_AC; m_AD += rhs.m_AD;
+      m_B2 += rhs.m_B2; m_BC += rhs.m_BC; m_BD += rhs.m_BD;
+      m_C2 += rhs.m_C2; m_CD += rhs.m_CD;
+      m_D2 += rhs.m_D2;
+      m_Weight += rhs.m_Weight;
+      return *this;
+    }
+
+    /// @brief weighted mean of squared distances from p to every plane
+    double error(glm::vec3 const& p) const noexcept
+    {
+      double x{ p.x }, y{ p.y }, z{ p.z };
+      double sum
+      {
+        m_A2 * x * x + 2 * m_AB * x * y + 2 * m_AC * x * z + 2 * m_AD * x +
+        m_B2 * y * y + 2 * m_BC * y * z + 2 * m_BD * y +
+        m_C2 * z * z + 2 * m_CD * z +
+        m_D2
+      };
+      return m_Weight > 0 ? std::max(sum / m_Weight, 0.0) : 0.0;
+    }
+  };
+
+  struct collapseCandidate
+  {
+    double    m_Cost;
+    uint32_t  m_From;
+    uint32_t  m_To;
+    uint32_t  m_VersionFrom;
+    uint32_t  m_VersionTo;
+
+    bool operator>(collapseCandidate const& rhs) const noexcept { return m_Cost > rhs.m_Cost; }
+  };
+
+  struct simplifyEdge
+  {
+    uint32_t m_Count    { 0 };
+    uint32_t m_FirstTri { 0 };
+    uint32_t m_OrigLo   { 0 };// original vertex at the lower welded id
+    uint32_t m_OrigHi   { 0 };
+    bool     m_bSeam    { false };
+  };
+
+  static glm::vec3 readPosition(const float* pPositions, size_t positionStride, uint32_t vertexIndex) noexcept
+  {
+    glm::vec3 retval;
+    std::memcpy(&retval, reinterpret_cast<const char*>(pPositions) + positionStride * vertexIndex, sizeof(float) * 3);
+    return retval;
+  }
+
+  static glm::vec2 readTexCoord(const float* pTexCoords, size_t texCoordStride, uint32_t vertexIndex) noexcept
+  {
+    glm::vec2 retval;
+    std::memcpy(&retval, reinterpret_cast<const char*>(pTexCoords) + texCoordStride * vertexIndex, sizeof(float) * 2);
+    return retval;
+  }
+
+  static uint64_t edgeKey(uint32_t a, uint32_t b) noexcept
+  {
+    return a < b ? (static_cast<uint64_t>(a) << 32 | b) : (static_cast<uint64_t>(b) << 32 | a);
+  }
+
+  static glm::vec3 triNormal(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2) noexcept
+  {
+    return glm::cross(p1 - p0, p2 - p0);
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+std::vector<uint32_t> MTU::simplifyMesh
+(
+  std::span<const uint32_t> indices,
+  simplifyVertexData const& vertexData,
+  size_t targetIndexCount,
+  float maxError,
+  float& outError
+)
+{
+  using namespace MTU::Helper;
+  outError = 0.0f;
+
+  // weld by position so seams collapse as one, work on welded ids from here
+  std::vector<uint32_t> weldID(vertexData.m_VertexCount);
+  std::vector<glm::vec3> positions;
+  {
+    struct posHash
+    {
+      size_t operator()(std::array<uint32_t, 3> const& x) const noexcept
+      {
+        uint64_t h{ x[0] * 0x9E3779B97F4A7C15ull ^ x[1] * 0xC2B2AE3D27D4EB4Full ^ x[2] * 0x165667B19E3779F9ull };
+        return static_cast<size_t>(h ^ (h >> 29));
+      }
+    };
+    std::unordered_map<std::array<uint32_t, 3>, uint32_t, posHash> welded;
+    welded.reserve(vertexData.m_VertexCount);
+    for (uint32_t i{ 0 }; i < vertexData.m_VertexCount; ++i)
+    {
+      glm::vec3 pos{ readPosition(vertexData.m_pPositions, vertexData.m_PositionStride, i) };
+      std::array<uint32_t, 3> key;
+      std::memcpy(key.data(), &pos, sizeof(key));
+      auto [It, bNew] { welded.try_emplace(key, static_cast<uint32_t>(positions.size())) };
+      if (bNew)positions.emplace_back(pos);
+      weldID[i] = It->second;
+    }
+  }
+  const uint32_t weldCount{ static_cast<uint32_t>(positions.size()) };
+
+  // welded vertex -> original vertices, for picking a side of a seam later
+  std::vector<uint32_t> groupOffsets(weldCount + 1, 0), groupVertices(vertexData.m_VertexCount);
+  for (uint32_t x : weldID)++groupOffsets[x + 1];
+  for (uint32_t i{ 0 }; i < weldCount; ++i)groupOffsets[i + 1] += groupOffsets[i];
+  {
+    std::vector<uint32_t> fill(groupOffsets.begin(), groupOffsets.end() - 1);
+    for (uint32_t i{ 0 }; i < vertexData.m_VertexCount; ++i)groupVertices[fill[weldID[i]]++] = i;
+  }
+
+  // triangles in welded ids, degenerate ones are dropped right away
+  std::vector<std::array<uint32_t, 3>> tris;
+  std::vector<std::array<uint32_t, 3>> trisOriginal;
+  tris.reserve(indices.size() / 3);
+  trisOriginal.reserve(indices.size() / 3);
+  for (size_t i{ 0 }; i + 2 < indices.size(); i += 3)
+  {
+    std::array<uint32_t, 3> welded{ weldID[indices[i]], weldID[indices[i + 1]], weldID[indices[i + 2]] };
+    if (welded[0] == welded[1] || welded[1] == welded[2] || welded[0] == welded[2])continue;
+    tris.emplace_back(welded);
+    trisOriginal.emplace_back(std::array<uint32_t, 3>{ indices[i], indices[i + 1], indices[i + 2] });
+  }
+
+  std::vector<quadric> quadrics(weldCount);
+  std::vector<std::vector<uint32_t>> vertexTris(weldCount);
+  std::unordered_map<uint64_t, simplifyEdge> edges;
+  edges.reserve(tris.size() * 2);
+  for (uint32_t t{ 0 }, tt{ static_cast<uint32_t>(tris.size()) }; t < tt; ++t)
+  {
+    std::array<uint32_t, 3> const& tri{ tris[t] };
+    glm::vec3 nml{ triNormal(positions[tri[0]], positions[tri[1]], positions[tri[2]]) };
+    float len{ glm::length(nml) };
+    for (int k{ 0 }; k < 3; ++k)vertexTris[tri[k]].emplace_back(t);
+    if (len > 0.0f)
+    {
+      nml = nml / len;
+      float d{ -glm::dot(nml, positions[tri[0]]) };
+      for (int k{ 0 }; k < 3; ++k)quadrics[tri[k]].addPlane(nml, d, 0.5 * len);// area weighted
+    }
+
+    for (int k{ 0 }; k < 3; ++k)
+    {
+      uint32_t a{ tri[k] }, b{ tri[(k + 1) % 3] };
+      uint32_t origA{ trisOriginal[t][k] }, origB{ trisOriginal[t][(k + 1) % 3] };
+      if (a > b)
+      {
+        std::swap(a, b);
+        std::swap(origA, origB);
+      }
+      simplifyEdge& refEdge{ edges[edgeKey(a, b)] };
+      if (refEdge.m_Count++ == 0)
+      {
+        refEdge.m_FirstTri = t;
+        refEdge.m_OrigLo = origA;
+        refEdge.m_OrigHi = origB;
+      }
+      else if (refEdge.m_OrigLo != origA || refEdge.m_OrigHi != origB)
+      {
+        refEdge.m_bSeam = true;// same positions, different attributes
+      }
+    }
+  }
+
+  // open borders and seams get a plane along the edge to hold them in place
+  for (auto const& [key, refEdge] : edges)
+  {
+    if (refEdge.m_Count != 1 && false == refEdge.m_bSeam)continue;
+    uint32_t a{ static_cast<uint32_t>(key >> 32) }, b{ static_cast<uint32_t>(key) };
+    std::array<uint32_t, 3> const& tri{ tris[refEdge.m_FirstTri] };
+    glm::vec3 faceNml{ triNormal(positions[tri[0]], positions[tri[1]], positions[tri[2]]) };
+    glm::vec3 edgeDir{ positions[b] - positions[a] };
+    glm::vec3 planeNml{ glm::cross(edgeDir, faceNml) };
+    float len{ glm::length(planeNml) };
+    if (len == 0.0f)continue;
+    planeNml = planeNml / len;
+    float d{ -glm::dot(planeNml, positions[a]) };
+    double weight{ s_EdgePenaltyWeight * glm::dot(edgeDir, edgeDir) };
+    quadrics[a].addPlane(planeNml, d, weight);
+    quadrics[b].addPlane(planeNml, d, weight);
+  }
+
+  std::vector<uint32_t> versions(weldCount, 0);
+  std::vector<char> bVertexDead(weldCount, false);
+  std::vector<char> bTriDead(tris.size(), false);
+  std::priority_queue<collapseCandidate, std::vector<collapseCandidate>, std::greater<collapseCandidate>> candidates;
+
+  auto pushEdge
+  {
+    [&](uint32_t a, uint32_t b)
+    {
+      quadric merged{ quadrics[a] };
+      merged += quadrics[b];
+      double costAB{ merged.error(positions[b]) }, costBA{ merged.error(positions[a]) };
+      if (costAB <= costBA)candidates.push(collapseCandidate{ costAB, a, b, versions[a], versions[b] });
+      else                 candidates.push(collapseCandidate{ costBA, b, a, versions[b], versions[a] });
+    }
+  };
+  for (auto const& [key, refEdge] : edges)pushEdge(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key));
+
+  size_t liveTris{ tris.size() };
+  const double maxCost{ static_cast<double>(maxError) * maxError };
+  double worstCost{ 0.0 };
+  std::vector<uint32_t> neighbours;
+
+  while (liveTris * 3 > targetIndexCount && false == candidates.empty())
+  {
+    collapseCandidate Curr{ candidates.top() };
+    candidates.pop();
+    if (bVertexDead[Curr.m_From] || bVertexDead[Curr.m_To])continue;
+    if (versions[Curr.m_From] != Curr.m_VersionFrom || versions[Curr.m_To] != Curr.m_VersionTo)continue;
+    if (Curr.m_Cost > maxCost)break;
+
+    // moving From onto To must not flip any triangle that survives
+    bool bFlips{ false };
+    for (uint32_t t : vertexTris[Curr.m_From])
+    {
+      if (bTriDead[t])continue;
+      std::array<uint32_t, 3> tri{ tris[t] };
+      if (tri[0] == Curr.m_To || tri[1] == Curr.m_To || tri[2] == Curr.m_To)continue;// collapses away
+      glm::vec3 before{ triNormal(positions[tri[0]], positions[tri[1]], positions[tri[2]]) };
+      for (uint32_t& x : tri)if (x == Curr.m_From)x = Curr.m_To;
+      glm::vec3 after{ triNormal(positions[tri[0]], positions[tri[1]], positions[tri[2]]) };
+      if (glm::dot(before, after) <= 0.0f)
+      {
+        bFlips = true;
+        break;
+      }
+    }
+    if (bFlips)continue;
+
+    for (uint32_t t : vertexTris[Curr.m_From])
+    {
+      if (bTriDead[t])continue;
+      std::array<uint32_t, 3>& tri{ tris[t] };
+      if (tri[0] == Curr.m_To || tri[1] == Curr.m_To || tri[2] == Curr.m_To)
+      {
+        bTriDead[t] = true;
+        --liveTris;
+        continue;
+      }
+      for (uint32_t& x : tri)if (x == Curr.m_From)x = Curr.m_To;
+      vertexTris[Curr.m_To].emplace_back(t);
+    }
+    quadrics[Curr.m_To] += quadrics[Curr.m_From];
+    bVertexDead[Curr.m_From] = true;
+    vertexTris[Curr.m_From] = std::vector<uint32_t>{};
+    ++versions[Curr.m_To];
+    worstCost = std::max(worstCost, Curr.m_Cost);
+
+    // drop dead triangles from To and re-cost every edge around it
+    std::vector<uint32_t>& refToTris{ vertexTris[Curr.m_To] };
+    refToTris.erase(std::remove_if(refToTris.begin(), refToTris.end(), [&bTriDead](uint32_t t) { return bTriDead[t]; }), refToTris.end());
+    neighbours.clear();
+    for (uint32_t t : refToTris)
+    {
+      for (uint32_t x : tris[t])if (x != Curr.m_To)neighbours.emplace_back(x);
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    for (uint32_t x : neighbours)pushEdge(Curr.m_To, x);
+  }
+  outError = static_cast<float>(std::sqrt(worstCost));
+
+  // back to original vertices, taking the seam side closest in UV
+  std::vector<uint32_t> retval;
+  retval.reserve(liveTris * 3);
+  for (size_t t{ 0 }, tt{ tris.size() }; t < tt; ++t)
+  {
+    if (bTriDead[t])continue;
+    for (int k{ 0 }; k < 3; ++k)
+    {
+      uint32_t orig{ trisOriginal[t][k] };
+      uint32_t welded{ tris[t][k] };
+      if (weldID[orig] == welded)
+      {
+        retval.emplace_back(orig);
+        continue;
+      }
+
+      uint32_t best{ groupVertices[groupOffsets[welded]] };
+      if (vertexData.m_pTexCoords != nullptr)
+      {
+        glm::vec2 uv{ readTexCoord(vertexData.m_pTexCoords, vertexData.m_TexCoordStride, orig) };
+        float bestDist{ FLT_MAX };
+        for (uint32_t i{ groupOffsets[welded] }; i < groupOffsets[welded + 1]; ++i)
+        {
+          glm::vec2 delta{ readTexCoord(vertexData.m_pTexCoords, vertexData.m_TexCoordStride, groupVertices[i]) - uv };
+          if (float dist{ glm::dot(delta, delta) }; dist < bestDist)
+          {
+            bestDist = dist;
+            best = groupVertices[i];
+          }
+        }
+      }
+      retval.emplace_back(best);
+    }
+  }
+  return retval;
+}
+
+// *****************************************************************************
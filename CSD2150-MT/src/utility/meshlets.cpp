@@ -0,0 +1,257 @@
+/*!*****************************************************************************
+ * @file    meshlets.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for meshlet building and
+ *          culling
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/meshlets.h>
+#include <algorithm>  // for min/max
+#include <cstring>    // for position reads
+#include <bit>        // for visible mask bits
+#include <cmath>      // for sqrt
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>          // 4 meshlets per test
+#define MESHLET_CULL_SSE
+#endif
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  static glm::vec3 readPosition(const float* pPositions, size_t positionStride, uint32_t vertexIndex) noexcept
+  {
+    glm::vec3 retval;
+    std::memcpy(&retval, reinterpret_cast<const char*>(pPositions) + positionStride * vertexIndex, sizeof(float) * 3);
+    return retval;
+  }
+
+  static meshlet computeMeshletBounds(std::span<const uint32_t> indices, const float* pPositions, size_t positionStride)
+  {
+    meshlet retval{};
+
+    // sphere around the box center, good enough for 64 vertices
+    glm::vec3 boxMin{ readPosition(pPositions, positionStride, indices[0]) }, boxMax{ boxMin };
+    for (uint32_t x : indices)
+    {
+      glm::vec3 pos{ readPosition(pPositions, positionStride, x) };
+      boxMin = glm::min(boxMin, pos);
+      boxMax = glm::max(boxMax, pos);
+    }
+    retval.m_Center = (boxMin + boxMax) * 0.5f;
+    for (uint32_t x : indices)
+    {
+      retval.m_Radius = std::max(retval.m_Radius, glm::length(readPosition(pPositions, positionStride, x) - retval.m_Center));
+    }
+
+    // cone of triangle normals, a wide cone can never be fully backfacing
+    std::vector<glm::vec3> triNormals;
+    triNormals.reserve(indices.size() / 3);
+    glm::vec3 axis{ 0.0f, 0.0f, 0.0f };
+    for (size_t i{ 0 }; i + 2 < indices.size(); i += 3)
+    {
+      glm::vec3 p0{ readPosition(pPositions, positionStride, indices[i]) };
+      glm::vec3 nml{ glm::cross(readPosition(pPositions, positionStride, indices[i + 1]) - p0, readPosition(pPositions, positionStride, indices[i + 2]) - p0) };
+      float len{ glm::length(nml) };
+      if (len == 0.0f)continue;// degenerate, faces nowhere
+      triNormals.emplace_back(nml / len);
+      axis += triNormals.back();
+    }
+
+    retval.m_ConeAxis = glm::vec3{ 0.0f, 0.0f, 1.0f };
+    retval.m_ConeCutoff = 1.0f;
+    if (float len{ glm::length(axis) }; len > 0.0f)
+    {
+      axis = axis / len;
+      float minDot{ 1.0f };
+      for (glm::vec3 const& x : triNormals)minDot = std::min(minDot, glm::dot(x, axis));
+      retval.m_ConeAxis = axis;
+      if (minDot > 0.1f)retval.m_ConeCutoff = std::sqrt(1.0f - minDot * minDot);// sin of the half angle
+    }
+    return retval;
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+std::vector<MTU::meshlet> MTU::buildMeshlets(std::span<const uint32_t> indices, const float* pPositions, size_t positionStride)
+{
+  std::vector<meshlet> retval;
+  const size_t triCount{ indices.size() / 3 };
+  if (triCount == 0)return retval;
+
+  uint32_t maxIndex{ 0 };
+  for (uint32_t x : indices)maxIndex = std::max(maxIndex, x);
+  std::vector<uint32_t> lastMeshlet(static_cast<size_t>(maxIndex) + 1, UINT32_MAX);
+
+  uint32_t meshletID{ 0 }, firstTri{ 0 }, numTris{ 0 }, numVerts{ 0 };
+  auto finishMeshlet
+  {
+    [&]()
+    {
+      std::span<const uint32_t> meshletIndices{ indices.subspan(static_cast<size_t>(firstTri) * 3, static_cast<size_t>(numTris) * 3) };
+      meshlet& refMeshlet{ retval.emplace_back(Helper::computeMeshletBounds(meshletIndices, pPositions, positionStride)) };
+      refMeshlet.m_FirstIndex = firstTri * 3;
+      refMeshlet.m_IndexCount = numTris * 3;
+    }
+  };
+
+  for (uint32_t i{ 0 }; i < triCount; ++i)
+  {
+    const uint32_t* pTri{ &indices[static_cast<size_t>(i) * 3] };
+    uint32_t newVerts{ 0 };
+    for (int j{ 0 }; j < 3; ++j)
+    {
+      // a vertex repeated inside the triangle only counts once
+      bool bRepeat{ (j > 0 && pTri[j] == pTri[0]) || (j > 1 && pTri[j] == pTri[1]) };
+      if (false == bRepeat && lastMeshlet[pTri[j]] != meshletID)++newVerts;
+    }
+
+    if (numTris + 1 > meshlet::s_MaxTriangles || numVerts + newVerts > meshlet::s_MaxVertices)
+    {
+      finishMeshlet();
+      ++meshletID;
+      firstTri = i;
+      numTris = numVerts = 0;
+      newVerts = 0;
+      for (int j{ 0 }; j < 3; ++j)
+      {
+        bool bRepeat{ (j > 0 && pTri[j] == pTri[0]) || (j > 1 && pTri[j] == pTri[1]) };
+        if (false == bRepeat)++newVerts;
+      }
+    }
+
+    for (int j{ 0 }; j < 3; ++j)lastMeshlet[pTri[j]] = meshletID;
+    numVerts += newVerts;
+    ++numTris;
+  }
+  finishMeshlet();
+
+  return retval;
+}
+
+void MTU::meshletCuller::setMeshlets(std::span<const meshlet> meshlets)
+{
+  size_t paddedSize{ (meshlets.size() + 3) & ~size_t{ 3 } };
+  for (std::vector<float>& x : m_Bounds)x.assign(paddedSize, 0.0f);
+  std::fill(m_Bounds[E_CUTOFF].begin(), m_Bounds[E_CUTOFF].end(), 1.0f);// padding never survives,
+  std::fill(m_Bounds[E_RADIUS].begin(), m_Bounds[E_RADIUS].end(), -1.0f);// it fails every plane
+  m_Ranges.clear();
+  m_Ranges.reserve(meshlets.size());
+
+  for (size_t i{ 0 }, t{ meshlets.size() }; i < t; ++i)
+  {
+    meshlet const& x{ meshlets[i] };
+    m_Bounds[E_CENTER_X][i] = x.m_Center.x;
+    m_Bounds[E_CENTER_Y][i] = x.m_Center.y;
+    m_Bounds[E_CENTER_Z][i] = x.m_Center.z;
+    m_Bounds[E_RADIUS][i]   = x.m_Radius;
+    m_Bounds[E_AXIS_X][i]   = x.m_ConeAxis.x;
+    m_Bounds[E_AXIS_Y][i]   = x.m_ConeAxis.y;
+    m_Bounds[E_AXIS_Z][i]   = x.m_ConeAxis.z;
+    m_Bounds[E_CUTOFF][i]   = x.m_ConeCutoff;
+    m_Ranges.emplace_back(indexRange{ x.m_FirstIndex, x.m_IndexCount });
+  }
+}
+
+bool MTU::meshletCuller::empty() const noexcept
+{
+  return m_Ranges.empty();
+}
+
+uint32_t MTU::meshletCuller::cull
+(
+  frustum const& inFrustum,
+  glm::vec3 const& localCamPos,
+  std::vector<indexRange>& outRanges,
+  uint32_t firstMeshlet,
+  uint32_t meshletCount
+) const
+{
+  uint32_t retval{ 0 };
+  const size_t begin{ std::min<size_t>(firstMeshlet, m_Ranges.size()) };
+  const size_t end{ begin + std::min<size_t>(meshletCount, m_Ranges.size() - begin) };
+  auto addRange
+  {
+    [&outRanges, &retval](indexRange const& x)
+    {
+      retval += x.m_IndexCount;
+      if (false == outRanges.empty() && outRanges.back().m_FirstIndex + outRanges.back().m_IndexCount == x.m_FirstIndex)
+      {
+        outRanges.back().m_IndexCount += x.m_IndexCount;
+        return;
+      }
+      outRanges.emplace_back(x);
+    }
+  };
+
+  // visible if inside/touching every plane and the cone isn't facing away:
+  // dot(center - cam, axis) >= cutoff * |center - cam| + radius culls
+#if defined(MESHLET_CULL_SSE)
+  __m128 planes[frustum::E_NUM_PLANES][4];
+  for (int i{ 0 }; i < frustum::E_NUM_PLANES; ++i)
+  {
+    for (int j{ 0 }; j < 4; ++j)planes[i][j] = _mm_set1_ps(inFrustum.m_Planes[i][j]);
+  }
+  __m128 camX{ _mm_set1_ps(localCamPos.x) }, camY{ _mm_set1_ps(localCamPos.y) }, camZ{ _mm_set1_ps(localCamPos.z) };
+
+  for (size_t i{ begin & ~size_t{ 3 } }; i < end; i += 4)
+  {
+    __m128 cx{ _mm_loadu_ps(&m_Bounds[E_CENTER_X][i]) };
+    __m128 cy{ _mm_loadu_ps(&m_Bounds[E_CENTER_Y][i]) };
+    __m128 cz{ _mm_loadu_ps(&m_Bounds[E_CENTER_Z][i]) };
+    __m128 radius{ _mm_loadu_ps(&m_Bounds[E_RADIUS][i]) };
+    __m128 negRadius{ _mm_sub_ps(_mm_setzero_ps(), radius) };
+
+    __m128 visible{ _mm_cmpge_ps(radius, _mm_setzero_ps()) };
+    for (int j{ 0 }; j < frustum::E_NUM_PLANES; ++j)
+    {
+      __m128 dist{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes[j][0], cx), _mm_mul_ps(planes[j][1], cy)), _mm_add_ps(_mm_mul_ps(planes[j][2], cz), planes[j][3])) };
+      visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, negRadius));
+    }
+
+    __m128 dx{ _mm_sub_ps(cx, camX) }, dy{ _mm_sub_ps(cy, camY) }, dz{ _mm_sub_ps(cz, camZ) };
+    __m128 len{ _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz))) };
+    __m128 facing
+    {
+      _mm_add_ps
+      (
+        _mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&m_Bounds[E_AXIS_X][i])), _mm_mul_ps(dy, _mm_loadu_ps(&m_Bounds[E_AXIS_Y][i]))),
+        _mm_mul_ps(dz, _mm_loadu_ps(&m_Bounds[E_AXIS_Z][i]))
+      )
+    };
+    __m128 coneLimit{ _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_Bounds[E_CUTOFF][i]), len), radius) };
+    visible = _mm_andnot_ps(_mm_cmpge_ps(facing, coneLimit), visible);
+
+    // lanes outside [begin, end) belong to another LOD
+    int laneMask{ 0xF };
+    if (i < begin)laneMask &= 0xF << (begin - i);
+    if (i + 4 > end)laneMask &= 0xF >> (i + 4 - end);
+    for (int mask{ _mm_movemask_ps(visible) & laneMask }; mask; mask &= mask - 1)
+    {
+      addRange(m_Ranges[i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)))]);
+    }
+  }
+#else
+  for (size_t i{ begin }; i < end; ++i)
+  {
+    glm::vec3 center{ m_Bounds[E_CENTER_X][i], m_Bounds[E_CENTER_Y][i], m_Bounds[E_CENTER_Z][i] };
+    glm::vec3 axis{ m_Bounds[E_AXIS_X][i], m_Bounds[E_AXIS_Y][i], m_Bounds[E_AXIS_Z][i] };
+    float radius{ m_Bounds[E_RADIUS][i] };
+    if (false == isSphereInFrustum(inFrustum, center, radius))continue;
+
+    glm::vec3 toCenter{ center - localCamPos };
+    if (glm::dot(toCenter, axis) >= m_Bounds[E_CUTOFF][i] * glm::length(toCenter) + radius)continue;
+    addRange(m_Ranges[i]);
+  }
+#endif
+  return retval;
+}
+
+// *****************************************************************************
@@ -0,0 +1,32 @@
+/*!*****************************************************************************
+ * @file    objectCuller.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the CPU object culling
+ *          reference
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/objectCuller.h>
+#include <utility/bounds.h>
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+glm::vec4 MTU::getWorldSphere(cullObject const& inObject) noexcept
+{
+  return transformSphere(inObject.m_BoundingSphere, inObject.m_M2W);
+}
+
+void MTU::cullObjects(frustum const& worldFrustum, std::span<const cullObject> objects, std::vector<uint32_t>& outVisible, float slack)
+{
+  outVisible.clear();
+  for (uint32_t i{ 0 }, t{ static_cast<uint32_t>(objects.size()) }; i < t; ++i)
+  {
+    glm::vec4 sphere{ getWorldSphere(objects[i]) };
+    if (isSphereInFrustum(worldFrustum, glm::vec3{ sphere }, sphere.w + slack))outVisible.emplace_back(i);
+  }
+}
+
+// *****************************************************************************
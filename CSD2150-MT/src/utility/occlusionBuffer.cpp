@@ -0,0 +1,304 @@
+/*!*****************************************************************************
+ * @file    occlusionBuffer.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the software occlusion
+ *          rasterizer
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/occlusionBuffer.h>
+#include <algorithm>  // for min/max
+#include <future>     // for tile row jobs
+#include <cmath>      // for floor/ceil/isfinite
+#include <cfloat>     // for FLT_MAX
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>          // 4 pixels per step
+#define OCCLUSION_SSE
+#endif
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  static constexpr float s_MinTriangleArea{ 1.0e-6f };// pixels squared, less covers nothing
+  static constexpr float s_ClearDepth     { 1.0f };
+
+  // pixel space like the flipped viewport, depth stays 0..1
+  static glm::vec3 toScreen(glm::vec4 const& clip, float width, float height) noexcept
+  {
+    glm::vec3 ndc{ glm::vec3{ clip } / clip.w };
+    return glm::vec3{ (ndc.x * 0.5f + 0.5f) * width, (0.5f - ndc.y * 0.5f) * height, ndc.z };
+  }
+
+  // a w near 0 divides into inf or nan, neither can be rasterized or clamped
+  static bool isFinite(glm::vec3 const& v) noexcept
+  {
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+void MTU::occlusionBuffer::resize(uint32_t width, uint32_t height)
+{
+  width = std::max(width, 1u);
+  height = std::max(height, 1u);
+  if (width == m_Width && height == m_Height)return;
+
+  m_Width = width;
+  m_Height = height;
+  m_TilesX = (width + s_TileWidth - 1) / s_TileWidth;
+  m_TilesY = (height + s_TileHeight - 1) / s_TileHeight;
+  m_Depth.assign(static_cast<size_t>(m_TilesX) * m_TilesY * s_TileWidth * s_TileHeight, Helper::s_ClearDepth);
+  m_Bins.resize(static_cast<size_t>(m_TilesX) * m_TilesY);
+  clear();
+}
+
+void MTU::occlusionBuffer::clear() noexcept
+{
+  m_Triangles.clear();
+  for (std::vector<uint32_t>& x : m_Bins)x.clear();
+}
+
+void MTU::occlusionBuffer::addOccluder(occluderMesh const& Mesh, glm::mat4 const& M2Clip)
+{
+  if (m_Bins.empty())return;
+  float width{ static_cast<float>(m_Width) }, height{ static_cast<float>(m_Height) };
+
+  std::vector<glm::vec4> clip;
+  clip.reserve(Mesh.m_Positions.size());
+  for (glm::vec3 const& x : Mesh.m_Positions)clip.emplace_back(M2Clip * glm::vec4{ x, 1.0f });
+
+  for (size_t i{ 0 }, t{ Mesh.m_Indices.size() - Mesh.m_Indices.size() % 3 }; i < t; i += 3)
+  {
+    glm::vec4 const& c0{ clip[Mesh.m_Indices[i]] };
+    glm::vec4 const& c1{ clip[Mesh.m_Indices[i + 1]] };
+    glm::vec4 const& c2{ clip[Mesh.m_Indices[i + 2]] };
+
+    // no clipping, 0 <= z keeps w > 0 for a perspective projection
+    if (c0.z < 0.0f || c1.z < 0.0f || c2.z < 0.0f || c0.w <= 0.0f || c1.w <= 0.0f || c2.w <= 0.0f)continue;
+    glm::vec3 v[3]{ Helper::toScreen(c0, width, height), Helper::toScreen(c1, width, height), Helper::toScreen(c2, width, height) };
+    if (false == (Helper::isFinite(v[0]) && Helper::isFinite(v[1]) && Helper::isFinite(v[2])))continue;
+
+    // edge i runs v[i] to v[i + 1], both windings are made positive inside.
+    // c comes from the same end whichever way an edge is walked, so the two
+    // triangles sharing it get exactly negated functions
+    screenTriangle tri;
+    for (int e{ 0 }; e < 3; ++e)
+    {
+      glm::vec3 const& p{ v[e] };
+      glm::vec3 const& q{ v[(e + 1) % 3] };
+      glm::vec3 const& o{ (p.x < q.x || (p.x == q.x && p.y < q.y)) ? p : q };
+      float a{ p.y - q.y }, b{ q.x - p.x };
+      tri.m_Edges[e] = glm::vec3{ a, b, -(a * o.x + b * o.y) };
+    }
+    float area{ glm::dot(tri.m_Edges[0], glm::vec3{ v[2].x, v[2].y, 1.0f }) };
+    if (std::abs(area) < Helper::s_MinTriangleArea)continue;
+    if (area < 0.0f)
+    {
+      for (glm::vec3& x : tri.m_Edges)x = -x;
+      area = -area;
+    }
+    // negated on the neighbour, so it owns the edge only if this one doesn't
+    for (int e{ 0 }; e < 3; ++e)tri.m_bOwned[e] = tri.m_Edges[e].x > 0.0f || (tri.m_Edges[e].x == 0.0f && tri.m_Edges[e].y > 0.0f);
+
+    // the edge opposite a vertex is its barycentric weight times area
+    tri.m_Depth = (tri.m_Edges[1] * v[0].z + tri.m_Edges[2] * v[1].z + tri.m_Edges[0] * v[2].z) / area;
+
+    // pixels whose centers can be inside, clamped before the casts so far
+    // off screen corners can't overflow them
+    float minX{ std::min({ v[0].x, v[1].x, v[2].x }) }, maxX{ std::max({ v[0].x, v[1].x, v[2].x }) };
+    float minY{ std::min({ v[0].y, v[1].y, v[2].y }) }, maxY{ std::max({ v[0].y, v[1].y, v[2].y }) };
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)continue;
+    tri.m_MinX = static_cast<int32_t>(std::ceil(std::max(minX, 0.0f) - 0.5f));
+    tri.m_MinY = static_cast<int32_t>(std::ceil(std::max(minY, 0.0f) - 0.5f));
+    tri.m_MaxX = static_cast<int32_t>(std::floor(std::min(maxX, width) - 0.5f));
+    tri.m_MaxY = static_cast<int32_t>(std::floor(std::min(maxY, height) - 0.5f));
+    if (tri.m_MinX > tri.m_MaxX || tri.m_MinY > tri.m_MaxY)continue;
+
+    uint32_t index{ static_cast<uint32_t>(m_Triangles.size()) };
+    m_Triangles.emplace_back(tri);
+    for (int32_t ty{ tri.m_MinY / static_cast<int32_t>(s_TileHeight) }, tyEnd{ tri.m_MaxY / static_cast<int32_t>(s_TileHeight) }; ty <= tyEnd; ++ty)
+    {
+      for (int32_t tx{ tri.m_MinX / static_cast<int32_t>(s_TileWidth) }, txEnd{ tri.m_MaxX / static_cast<int32_t>(s_TileWidth) }; tx <= txEnd; ++tx)
+      {
+        m_Bins[static_cast<size_t>(ty) * m_TilesX + tx].emplace_back(index);
+      }
+    }
+  }
+}
+
+void MTU::occlusionBuffer::rasterize(threadPool* pPool)
+{
+  // tiles share nothing, rows of them go to different threads
+  if (pPool == nullptr || m_TilesY < 2)
+  {
+    for (uint32_t ty{ 0 }; ty < m_TilesY; ++ty)
+    {
+      for (uint32_t tx{ 0 }; tx < m_TilesX; ++tx)rasterizeTile(tx, ty);
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> Jobs;
+  Jobs.reserve(m_TilesY);
+  for (uint32_t ty{ 0 }; ty < m_TilesY; ++ty)
+  {
+    Jobs.emplace_back(pPool->submit([this, ty]() { for (uint32_t tx{ 0 }; tx < m_TilesX; ++tx)rasterizeTile(tx, ty); }));
+  }
+  for (std::future<void>& x : Jobs)x.get();
+}
+
+bool MTU::occlusionBuffer::isVisible(aabb const& box, glm::mat4 const& M2Clip) const noexcept
+{
+  if (m_Depth.empty())return true;
+
+  glm::vec2 ndcMin{ FLT_MAX }, ndcMax{ -FLT_MAX };
+  float nearZ{ FLT_MAX };
+  for (int i{ 0 }; i < 8; ++i)
+  {
+    glm::vec3 corner{ (i & 1) ? box.m_Max.x : box.m_Min.x, (i & 2) ? box.m_Max.y : box.m_Min.y, (i & 4) ? box.m_Max.z : box.m_Min.z };
+    glm::vec4 clip{ M2Clip * glm::vec4{ corner, 1.0f } };
+    if (clip.w <= 0.0f)return true;// crosses the camera plane
+    glm::vec3 ndc{ glm::vec3{ clip } / clip.w };
+    if (false == Helper::isFinite(ndc))return true;
+    ndcMin = glm::min(ndcMin, glm::vec2{ ndc });
+    ndcMax = glm::max(ndcMax, glm::vec2{ ndc });
+    nearZ = std::min(nearZ, ndc.z);
+  }
+  if (nearZ <= 0.0f)return true;
+
+  // every pixel the box's rectangle touches, the viewport is flipped
+  float width{ static_cast<float>(m_Width) }, height{ static_cast<float>(m_Height) };
+  float minX{ (ndcMin.x * 0.5f + 0.5f) * width }, maxX{ (ndcMax.x * 0.5f + 0.5f) * width };
+  float minY{ (0.5f - ndcMax.y * 0.5f) * height }, maxY{ (0.5f - ndcMin.y * 0.5f) * height };
+  if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)return true;
+  // clamped as floats, a box near the camera plane can project far past
+  // anything a uint32_t holds
+  uint32_t x0{ static_cast<uint32_t>(std::max(minX, 0.0f)) }, x1{ static_cast<uint32_t>(std::min(maxX, width - 1.0f)) };
+  uint32_t y0{ static_cast<uint32_t>(std::max(minY, 0.0f)) }, y1{ static_cast<uint32_t>(std::min(maxY, height - 1.0f)) };
+
+#if defined(OCCLUSION_SSE)
+  // groups of 4 never straddle a tile, tiles are a multiple of 4 wide
+  __m128 boxZ{ _mm_set1_ps(nearZ) };
+  for (uint32_t y{ y0 }; y <= y1; ++y)
+  {
+    for (uint32_t x{ x0 & ~3u }; x <= x1; x += 4)
+    {
+      int laneMask{ 0xF };
+      if (x < x0)laneMask &= 0xF << (x0 - x);
+      if (x + 3 > x1)laneMask &= 0xF >> (x + 3 - x1);
+      __m128 depth{ _mm_loadu_ps(&m_Depth[getPixelOffset(x, y)]) };
+      if (_mm_movemask_ps(_mm_cmpge_ps(depth, boxZ)) & laneMask)return true;
+    }
+  }
+#else
+  for (uint32_t y{ y0 }; y <= y1; ++y)
+  {
+    for (uint32_t x{ x0 }; x <= x1; ++x)
+    {
+      if (m_Depth[getPixelOffset(x, y)] >= nearZ)return true;
+    }
+  }
+#endif
+  return false;
+}
+
+float MTU::occlusionBuffer::getDepth(uint32_t x, uint32_t y) const noexcept
+{
+  if (x >= m_Width || y >= m_Height)return Helper::s_ClearDepth;
+  return m_Depth[getPixelOffset(x, y)];
+}
+
+// *****************************************************************************
+// ****************************************************** PRIVATE FUNCTIONS ****
+
+void MTU::occlusionBuffer::rasterizeTile(uint32_t tileX, uint32_t tileY)
+{
+  size_t tileIndex{ static_cast<size_t>(tileY) * m_TilesX + tileX };
+  float* pTile{ &m_Depth[tileIndex * s_TileWidth * s_TileHeight] };
+  std::fill(pTile, pTile + s_TileWidth * s_TileHeight, Helper::s_ClearDepth);
+
+  int32_t tileX0{ static_cast<int32_t>(tileX * s_TileWidth) }, tileY0{ static_cast<int32_t>(tileY * s_TileHeight) };
+  for (uint32_t triIndex : m_Bins[tileIndex])
+  {
+    screenTriangle const& tri{ m_Triangles[triIndex] };
+    int32_t x0{ std::max(tri.m_MinX, tileX0) }, x1{ std::min(tri.m_MaxX, tileX0 + static_cast<int32_t>(s_TileWidth) - 1) };
+    int32_t y0{ std::max(tri.m_MinY, tileY0) }, y1{ std::min(tri.m_MaxY, tileY0 + static_cast<int32_t>(s_TileHeight) - 1) };
+
+    // pixel centers inside, or on an edge the triangle owns so pixels on a
+    // shared edge are drawn once instead of by neither. Lanes past the box
+    // are still tested against the edges
+#if defined(OCCLUSION_SSE)
+    __m128 laneCenters{ _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f) };
+    __m128 zero{ _mm_setzero_ps() };
+    __m128 edgeA[3], edgeOwned[3], zA{ _mm_set1_ps(tri.m_Depth.x) };
+    for (int e{ 0 }; e < 3; ++e)
+    {
+      edgeA[e] = _mm_set1_ps(tri.m_Edges[e].x);
+      edgeOwned[e] = tri.m_bOwned[e] ? _mm_cmpeq_ps(zero, zero) : zero;
+    }
+    auto insideEdge
+    {
+      [&edgeOwned, &zero](int e, __m128 value)
+      {
+        return _mm_or_ps(_mm_cmpgt_ps(value, zero), _mm_and_ps(_mm_cmpeq_ps(value, zero), edgeOwned[e]));
+      }
+    };
+    for (int32_t y{ y0 }; y <= y1; ++y)
+    {
+      float py{ static_cast<float>(y) + 0.5f };
+      __m128 rowE0{ _mm_set1_ps(tri.m_Edges[0].y * py + tri.m_Edges[0].z) };
+      __m128 rowE1{ _mm_set1_ps(tri.m_Edges[1].y * py + tri.m_Edges[1].z) };
+      __m128 rowE2{ _mm_set1_ps(tri.m_Edges[2].y * py + tri.m_Edges[2].z) };
+      __m128 rowZ{ _mm_set1_ps(tri.m_Depth.y * py + tri.m_Depth.z) };
+      float* pRow{ pTile + static_cast<size_t>(y - tileY0) * s_TileWidth };
+      for (int32_t x{ x0 & ~3 }; x <= x1; x += 4)
+      {
+        __m128 px{ _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneCenters) };
+        __m128 inside
+        {
+          _mm_and_ps
+          (
+            _mm_and_ps(insideEdge(0, _mm_add_ps(_mm_mul_ps(edgeA[0], px), rowE0)), insideEdge(1, _mm_add_ps(_mm_mul_ps(edgeA[1], px), rowE1))),
+            insideEdge(2, _mm_add_ps(_mm_mul_ps(edgeA[2], px), rowE2))
+          )
+        };
+        __m128 depth{ _mm_loadu_ps(pRow + (x - tileX0)) };
+        __m128 nearer{ _mm_min_ps(depth, _mm_add_ps(_mm_mul_ps(zA, px), rowZ)) };
+        _mm_storeu_ps(pRow + (x - tileX0), _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, depth)));
+      }
+    }
+#else
+    for (int32_t y{ y0 }; y <= y1; ++y)
+    {
+      float* pRow{ pTile + static_cast<size_t>(y - tileY0) * s_TileWidth };
+      for (int32_t x{ x0 }; x <= x1; ++x)
+      {
+        glm::vec3 p{ static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f, 1.0f };
+        bool bInside{ true };
+        for (int e{ 0 }; e < 3 && bInside; ++e)
+        {
+          float value{ glm::dot(tri.m_Edges[e], p) };
+          bInside = value > 0.0f || (value == 0.0f && tri.m_bOwned[e]);
+        }
+        if (false == bInside)continue;
+        pRow[x - tileX0] = std::min(pRow[x - tileX0], glm::dot(tri.m_Depth, p));
+      }
+    }
+#endif
+  }
+}
+
+size_t MTU::occlusionBuffer::getPixelOffset(uint32_t x, uint32_t y) const noexcept
+{
+  size_t tileIndex{ static_cast<size_t>(y / s_TileHeight) * m_TilesX + x / s_TileWidth };
+  return tileIndex * s_TileWidth * s_TileHeight + static_cast<size_t>(y % s_TileHeight) * s_TileWidth + x % s_TileWidth;
+}
+
+// *****************************************************************************
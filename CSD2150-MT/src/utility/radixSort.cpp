@@ -0,0 +1,50 @@
+/*!*****************************************************************************
+ * @file    radixSort.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the 64 bit key radix
+ *          sort
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/radixSort.h>
+#include <algorithm>  // for copy
+#include <utility>    // for swap
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+void MTU::radixSort(std::span<sortKey> keys, std::vector<sortKey>& scratch)
+{
+  static constexpr int s_Passes{ sizeof(uint64_t) };
+  if (keys.size() < 2)return;
+
+  // every histogram in one read of the keys
+  uint32_t counts[s_Passes][256]{};
+  for (sortKey const& x : keys)
+  {
+    for (int i{ 0 }; i < s_Passes; ++i)++counts[i][(x.m_Key >> (i * 8)) & 0xFF];
+  }
+
+  scratch.resize(keys.size());
+  std::span<sortKey> src{ keys }, dst{ scratch };
+  for (int i{ 0 }; i < s_Passes; ++i)
+  {
+    // one bucket holding every key, this byte changes nothing
+    if (counts[i][(src[0].m_Key >> (i * 8)) & 0xFF] == keys.size())continue;
+
+    uint32_t offsets[256];
+    for (uint32_t j{ 0 }, sum{ 0 }; j < 256; ++j)
+    {
+      offsets[j] = sum;
+      sum += counts[i][j];
+    }
+    for (sortKey const& x : src)dst[offsets[(x.m_Key >> (i * 8)) & 0xFF]++] = x;
+    std::swap(src, dst);
+  }
+
+  if (src.data() != keys.data())std::copy(src.begin(), src.end(), keys.begin());
+}
+
+// *****************************************************************************
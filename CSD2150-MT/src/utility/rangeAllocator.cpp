@@ -0,0 +1,91 @@
+/*!*****************************************************************************
+ * @file    rangeAllocator.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the range allocator
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/rangeAllocator.h>
+#include <cassert>  // for double frees
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::rangeAllocator::rangeAllocator(uint32_t capacity)
+{
+  reset(capacity);
+}
+
+void MTU::rangeAllocator::reset(uint32_t capacity)
+{
+  m_FreeRanges.clear();
+  if (capacity)m_FreeRanges.emplace(0, capacity);
+  m_Capacity = capacity;
+  m_Used = 0;
+}
+
+bool MTU::rangeAllocator::allocate(uint32_t count, uint32_t& outOffset)
+{
+  if (count == 0)
+  {
+    outOffset = 0;
+    return true;
+  }
+
+  for (auto It{ m_FreeRanges.begin() }; It != m_FreeRanges.end(); ++It)
+  {
+    if (It->second < count)continue;
+
+    outOffset = It->first;
+    uint32_t remaining{ It->second - count };
+    m_FreeRanges.erase(It);
+    if (remaining)m_FreeRanges.emplace(outOffset + count, remaining);
+    m_Used += count;
+    return true;
+  }
+  return false;
+}
+
+void MTU::rangeAllocator::free(uint32_t offset, uint32_t count)
+{
+  if (count == 0)return;
+  assert(offset + count <= m_Capacity && count <= m_Used);
+  m_Used -= count;
+
+  auto Next{ m_FreeRanges.lower_bound(offset) };
+  assert(Next == m_FreeRanges.end() || offset + count <= Next->first);
+
+  // join the range before and/or after if they touch
+  if (Next != m_FreeRanges.begin())
+  {
+    auto Prev{ std::prev(Next) };
+    assert(Prev->first + Prev->second <= offset);
+    if (Prev->first + Prev->second == offset)
+    {
+      offset = Prev->first;
+      count += Prev->second;
+      m_FreeRanges.erase(Prev);
+    }
+  }
+  if (Next != m_FreeRanges.end() && offset + count == Next->first)
+  {
+    count += Next->second;
+    m_FreeRanges.erase(Next);
+  }
+
+  m_FreeRanges.emplace(offset, count);
+}
+
+uint32_t MTU::rangeAllocator::getCapacity() const noexcept
+{
+  return m_Capacity;
+}
+
+uint32_t MTU::rangeAllocator::getUsed() const noexcept
+{
+  return m_Used;
+}
+
+// *****************************************************************************
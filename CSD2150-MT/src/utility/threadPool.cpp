@@ -0,0 +1,66 @@
+/*!*****************************************************************************
+ * @file    threadPool.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the thread pool
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/threadPool.h>
+#include <algorithm>  // for max
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::threadPool::threadPool(size_t numThreads)
+{
+  if (numThreads == 0)numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  m_Workers.reserve(numThreads);
+  for (size_t i{ 0 }; i < numThreads; ++i)
+  {
+    m_Workers.emplace_back([this](std::stop_token stopToken) { workerLoop(stopToken); });
+  }
+}
+
+MTU::threadPool::~threadPool()
+{
+  for (std::jthread& x : m_Workers)x.request_stop();
+  m_CV.notify_all();
+  m_Workers.clear();// joins, workers drain the queue before leaving
+}
+
+size_t MTU::threadPool::getNumThreads() const noexcept
+{
+  return m_Workers.size();
+}
+
+// *****************************************************************************
+// ****************************************************** PRIVATE FUNCTIONS ****
+
+void MTU::threadPool::push(std::function<void()>&& job)
+{
+  {
+    std::scoped_lock lock{ m_Mutex };
+    m_Jobs.emplace_back(std::move(job));
+  }
+  m_CV.notify_one();
+}
+
+void MTU::threadPool::workerLoop(std::stop_token stopToken)
+{
+  for (;;)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock lock{ m_Mutex };
+      // returns false only when stopping with nothing left to do
+      if (false == m_CV.wait(lock, stopToken, [this]() { return false == m_Jobs.empty(); }))return;
+      job = std::move(m_Jobs.front());
+      m_Jobs.pop_front();
+    }
+    job();
+  }
+}
+
+// *****************************************************************************
@@ -0,0 +1,158 @@
+/*!*****************************************************************************
+ * @file    vertexQuantizer.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This file contains the implementation for the vertex quantizer
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <utility/vertexQuantizer.h>
+#include <algorithm>  // for min/max
+#include <cassert>    // for size checks
+#include <cmath>      // for rounding and angles
+
+// *****************************************************************************
+// **************************************************************** HELPERS ****
+
+namespace MTU::Helper
+{
+  static constexpr float s_SNorm16Max{ 32767.0f };
+  static constexpr float s_UNorm16Max{ 65535.0f };
+  static constexpr float s_RadToDeg  { 57.2957795f };
+
+  // decoding matches VK_FORMAT_R16*_SNORM, max(c / 32767, -1)
+  static int16_t encodeSNorm16(float x) noexcept
+  {
+    return static_cast<int16_t>(std::round(std::clamp(x, -1.0f, 1.0f) * s_SNorm16Max));
+  }
+  static float decodeSNorm16(int16_t x) noexcept
+  {
+    return std::max(static_cast<float>(x) / s_SNorm16Max, -1.0f);
+  }
+
+  static uint16_t encodeUNorm16(float x) noexcept
+  {
+    return static_cast<uint16_t>(std::round(std::clamp(x, 0.0f, 1.0f) * s_UNorm16Max));
+  }
+  static float decodeUNorm16(uint16_t x) noexcept
+  {
+    return static_cast<float>(x) / s_UNorm16Max;
+  }
+
+  static float signNotZero(float x) noexcept
+  {
+    return x >= 0.0f ? 1.0f : -1.0f;
+  }
+
+  // unit vector onto the octahedron, lower half folded over the diagonals
+  static void encodeOctahedral(glm::vec3 const& v, int16_t(&outXY)[2]) noexcept
+  {
+    float l1{ std::abs(v.x) + std::abs(v.y) + std::abs(v.z) };
+    if (l1 == 0.0f)
+    {
+      outXY[0] = outXY[1] = 0;// degenerate, decodes to +z
+      return;
+    }
+    float x{ v.x / l1 }, y{ v.y / l1 };
+    if (v.z < 0.0f)
+    {
+      float fx{ (1.0f - std::abs(y)) * signNotZero(x) };
+      y = (1.0f - std::abs(x)) * signNotZero(y);
+      x = fx;
+    }
+    outXY[0] = encodeSNorm16(x);
+    outXY[1] = encodeSNorm16(y);
+  }
+
+  static glm::vec3 decodeOctahedral(const int16_t(&inXY)[2]) noexcept
+  {
+    glm::vec3 v{ decodeSNorm16(inXY[0]), decodeSNorm16(inXY[1]), 0.0f };
+    v.z = 1.0f - std::abs(v.x) - std::abs(v.y);
+    float t{ std::max(-v.z, 0.0f) };
+    v.x += v.x >= 0.0f ? -t : t;
+    v.y += v.y >= 0.0f ? -t : t;
+    return glm::normalize(v);
+  }
+
+  static float angleDeg(glm::vec3 const& a, glm::vec3 const& b) noexcept
+  {
+    float la{ glm::length(a) }, lb{ glm::length(b) };
+    if (la == 0.0f || lb == 0.0f)return 0.0f;
+    return std::acos(std::clamp(glm::dot(a, b) / (la * lb), -1.0f, 1.0f)) * s_RadToDeg;
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* PUBLIC FUNCTIONS ****
+
+MTU::vertexQuantizeError MTU::quantizeVertices
+(
+  std::span<const VTX_3D_UV_NML_TAN> src,
+  std::span<const float> tangentSigns,
+  std::span<VTX_3D_UV_NML_TAN_Q16> dst,
+  VTX_DEQUANT& outDequant
+)
+{
+  using namespace MTU::Helper;
+  assert(src.size() == dst.size() && (tangentSigns.empty() || tangentSigns.size() == src.size()));
+
+  outDequant = VTX_DEQUANT{};
+  vertexQuantizeError retval{};
+  if (src.empty())return retval;
+
+  // bounds of the whole mesh, every vertex shares one dequant transform
+  glm::vec3 posMin{ src.front().m_Pos }, posMax{ src.front().m_Pos };
+  glm::vec2 texMin{ src.front().m_Tex }, texMax{ src.front().m_Tex };
+  for (VTX_3D_UV_NML_TAN const& x : src)
+  {
+    posMin = glm::min(posMin, x.m_Pos);
+    posMax = glm::max(posMax, x.m_Pos);
+    texMin = glm::min(texMin, x.m_Tex);
+    texMax = glm::max(texMax, x.m_Tex);
+  }
+
+  glm::vec3 posCenter{ (posMin + posMax) * 0.5f };
+  glm::vec3 posHalfExtent{ (posMax - posMin) * 0.5f };
+  glm::vec2 texExtent{ texMax - texMin };
+  for (int i{ 0 }; i < 3; ++i)if (posHalfExtent[i] == 0.0f)posHalfExtent[i] = 1.0f;// flat axis
+  for (int i{ 0 }; i < 2; ++i)if (texExtent[i] == 0.0f)texExtent[i] = 1.0f;
+
+  outDequant.m_PosOffset      = glm::vec4{ posCenter, 0.0f };
+  outDequant.m_PosScale       = glm::vec4{ posHalfExtent, 1.0f };
+  outDequant.m_TexOffsetScale = glm::vec4{ texMin.x, texMin.y, texExtent.x, texExtent.y };
+
+  for (size_t i{ 0 }, t{ src.size() }; i < t; ++i)
+  {
+    VTX_3D_UV_NML_TAN const& in{ src[i] };
+    VTX_3D_UV_NML_TAN_Q16& out{ dst[i] };
+
+    for (int j{ 0 }; j < 3; ++j)out.m_Pos[j] = encodeSNorm16((in.m_Pos[j] - posCenter[j]) / posHalfExtent[j]);
+    out.m_Pos[3] = encodeSNorm16(tangentSigns.empty() ? 1.0f : signNotZero(tangentSigns[i]));
+    for (int j{ 0 }; j < 2; ++j)out.m_Tex[j] = encodeUNorm16((in.m_Tex[j] - texMin[j]) / texExtent[j]);
+    encodeOctahedral(in.m_Nml, out.m_Nml);
+    encodeOctahedral(in.m_Tan, out.m_Tan);
+
+    VTX_3D_UV_NML_TAN roundTrip{ dequantizeVertex(out, outDequant) };
+    for (int j{ 0 }; j < 3; ++j)retval.m_MaxPos = std::max(retval.m_MaxPos, std::abs(roundTrip.m_Pos[j] - in.m_Pos[j]));
+    for (int j{ 0 }; j < 2; ++j)retval.m_MaxTex = std::max(retval.m_MaxTex, std::abs(roundTrip.m_Tex[j] - in.m_Tex[j]));
+    retval.m_MaxNmlDeg = std::max(retval.m_MaxNmlDeg, angleDeg(roundTrip.m_Nml, in.m_Nml));
+    retval.m_MaxTanDeg = std::max(retval.m_MaxTanDeg, angleDeg(roundTrip.m_Tan, in.m_Tan));
+  }
+  retval.m_MaxPosRel = retval.m_MaxPos / (2.0f * std::max({ posHalfExtent.x, posHalfExtent.y, posHalfExtent.z }));
+
+  return retval;
+}
+
+VTX_3D_UV_NML_TAN MTU::dequantizeVertex(VTX_3D_UV_NML_TAN_Q16 const& src, VTX_DEQUANT const& dequant) noexcept
+{
+  using namespace MTU::Helper;
+  VTX_3D_UV_NML_TAN retval;
+  for (int i{ 0 }; i < 3; ++i)retval.m_Pos[i] = dequant.m_PosOffset[i] + decodeSNorm16(src.m_Pos[i]) * dequant.m_PosScale[i];
+  for (int i{ 0 }; i < 2; ++i)retval.m_Tex[i] = dequant.m_TexOffsetScale[i] + decodeUNorm16(src.m_Tex[i]) * dequant.m_TexOffsetScale[i + 2];
+  retval.m_Nml = decodeOctahedral(src.m_Nml);
+  retval.m_Tan = decodeOctahedral(src.m_Tan);
+  return retval;
+}
+
+// *****************************************************************************
@@ -0,0 +1,185 @@
+/*!*****************************************************************************
+ * @file    vulkanCommandState.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanCommandState struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <vector>
+#include <cstring>    // for viewport/scissor compares
+#include <numeric>    // for stat sums
+#include <algorithm>
+#include <vulkanHelpers/vulkanCommandState.h>
+
+namespace MTU
+{
+  namespace Helper
+  {
+    // a handful of frame command buffers, a linear search beats hashing
+    static std::vector<std::pair<VkCommandBuffer, vulkanCommandState*>> s_CommandStates;
+
+    static bool isTrackedBindPoint(VkPipelineBindPoint bindPoint) noexcept
+    {
+      return static_cast<uint32_t>(bindPoint) < vulkanCommandState::s_NumBindPoints;
+    }
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+uint32_t vulkanCommandState::stats::getIssued() const noexcept
+{
+  return std::accumulate(m_Issued.begin(), m_Issued.end(), 0u);
+}
+
+uint32_t vulkanCommandState::stats::getSkipped() const noexcept
+{
+  return std::accumulate(m_Skipped.begin(), m_Skipped.end(), 0u);
+}
+
+void vulkanCommandState::reset() noexcept
+{
+  VkCommandBuffer FCB{ m_CommandBuffer };
+  stats Stats{ m_Stats };
+  *this = vulkanCommandState{};
+  m_CommandBuffer = FCB;
+  m_Stats = Stats;
+}
+
+void vulkanCommandState::registerState(VkCommandBuffer FCB, vulkanCommandState& State)
+{
+  State.m_CommandBuffer = FCB;
+  State.reset();
+  unregisterState(FCB);
+  MTU::Helper::s_CommandStates.emplace_back(FCB, &State);
+}
+
+void vulkanCommandState::unregisterState(VkCommandBuffer FCB) noexcept
+{
+  std::erase_if(MTU::Helper::s_CommandStates, [FCB](auto const& x) { return x.first == FCB; });
+}
+
+vulkanCommandState* vulkanCommandState::find(VkCommandBuffer FCB) noexcept
+{
+  for (auto const& x : MTU::Helper::s_CommandStates)
+  {
+    if (x.first == FCB)return x.second;
+  }
+  return nullptr;
+}
+
+void vulkanCommandState::bindPipeline(VkCommandBuffer FCB, VkPipelineBindPoint bindPoint, VkPipeline pipeline)
+{
+  vulkanCommandState* pState{ find(FCB) };
+  if (pState != nullptr && MTU::Helper::isTrackedBindPoint(bindPoint))
+  {
+    VkPipeline& bound{ pState->m_BindPoints[bindPoint].m_Pipeline };
+    if (bound == pipeline)
+    {
+      ++pState->m_Stats.m_Skipped[E_BIND_PIPELINE];
+      return;
+    }
+    bound = pipeline;
+    ++pState->m_Stats.m_Issued[E_BIND_PIPELINE];
+  }
+  vkCmdBindPipeline(FCB, bindPoint, pipeline);
+}
+
+void vulkanCommandState::bindDescriptorSets(VkCommandBuffer FCB, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* pSets)
+{
+  vulkanCommandState* pState{ find(FCB) };
+  if (pState != nullptr && MTU::Helper::isTrackedBindPoint(bindPoint))
+  {
+    bindPointState& bound{ pState->m_BindPoints[bindPoint] };
+    bool bFits{ firstSet + setCount <= s_MaxSets };
+    if (bFits && bound.m_Layout == layout && std::equal(pSets, pSets + setCount, bound.m_Sets.begin() + firstSet))
+    {
+      ++pState->m_Stats.m_Skipped[E_BIND_DESCRIPTOR_SETS];
+      return;
+    }
+
+    // another layout may disturb every other set, forget them
+    if (false == bFits || bound.m_Layout != layout)bound.m_Sets.fill(VK_NULL_HANDLE);
+    bound.m_Layout = layout;
+    if (bFits)std::copy(pSets, pSets + setCount, bound.m_Sets.begin() + firstSet);
+    ++pState->m_Stats.m_Issued[E_BIND_DESCRIPTOR_SETS];
+  }
+  vkCmdBindDescriptorSets(FCB, bindPoint, layout, firstSet, setCount, pSets, 0, nullptr);
+}
+
+void vulkanCommandState::bindVertexBuffer(VkCommandBuffer FCB, uint32_t binding, VkBuffer buffer, VkDeviceSize offset)
+{
+  vulkanCommandState* pState{ find(FCB) };
+  if (pState != nullptr && binding < s_MaxVertexBindings)
+  {
+    if (pState->m_VertexBuffers[binding] == buffer && pState->m_VertexOffsets[binding] == offset)
+    {
+      ++pState->m_Stats.m_Skipped[E_BIND_VERTEX_BUFFER];
+      return;
+    }
+    pState->m_VertexBuffers[binding] = buffer;
+    pState->m_VertexOffsets[binding] = offset;
+    ++pState->m_Stats.m_Issued[E_BIND_VERTEX_BUFFER];
+  }
+  vkCmdBindVertexBuffers(FCB, binding, 1, &buffer, &offset);
+}
+
+void vulkanCommandState::bindIndexBuffer(VkCommandBuffer FCB, VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+{
+  if (vulkanCommandState* pState{ find(FCB) }; pState != nullptr)
+  {
+    if (pState->m_IndexBuffer == buffer && pState->m_IndexOffset == offset && pState->m_IndexType == indexType)
+    {
+      ++pState->m_Stats.m_Skipped[E_BIND_INDEX_BUFFER];
+      return;
+    }
+    pState->m_IndexBuffer = buffer;
+    pState->m_IndexOffset = offset;
+    pState->m_IndexType = indexType;
+    ++pState->m_Stats.m_Issued[E_BIND_INDEX_BUFFER];
+  }
+  vkCmdBindIndexBuffer(FCB, buffer, offset, indexType);
+}
+
+void vulkanCommandState::setViewport(VkCommandBuffer FCB, VkViewport const& viewport)
+{
+  if (vulkanCommandState* pState{ find(FCB) }; pState != nullptr)
+  {
+    if (pState->m_bViewport && 0 == std::memcmp(&pState->m_Viewport, &viewport, sizeof(VkViewport)))
+    {
+      ++pState->m_Stats.m_Skipped[E_SET_VIEWPORT];
+      return;
+    }
+    pState->m_Viewport = viewport;
+    pState->m_bViewport = true;
+    ++pState->m_Stats.m_Issued[E_SET_VIEWPORT];
+  }
+  vkCmdSetViewport(FCB, 0, 1, &viewport);
+}
+
+void vulkanCommandState::setScissor(VkCommandBuffer FCB, VkRect2D const& scissor)
+{
+  if (vulkanCommandState* pState{ find(FCB) }; pState != nullptr)
+  {
+    if (pState->m_bScissor && 0 == std::memcmp(&pState->m_Scissor, &scissor, sizeof(VkRect2D)))
+    {
+      ++pState->m_Stats.m_Skipped[E_SET_SCISSOR];
+      return;
+    }
+    pState->m_Scissor = scissor;
+    pState->m_bScissor = true;
+    ++pState->m_Stats.m_Issued[E_SET_SCISSOR];
+  }
+  vkCmdSetScissor(FCB, 0, 1, &scissor);
+}
+
+void vulkanCommandState::executeCommands(VkCommandBuffer FCB, uint32_t commandBufferCount, const VkCommandBuffer* pCommandBuffers)
+{
+  vkCmdExecuteCommands(FCB, commandBufferCount, pCommandBuffers);
+  if (vulkanCommandState* pState{ find(FCB) }; pState != nullptr)pState->reset();
+}
+
+// *****************************************************************************
@@ -0,0 +1,186 @@
+/*!*****************************************************************************
+ * @file    vulkanComputePipeline.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanComputePipeline struct
+ *          and the windowHandler functions that create it
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <vulkanHelpers/vulkanComputePipeline.h>
+#include <vulkanHelpers/printWarnings.h>
+#include <handlers/windowHandler.h>
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+void vulkanComputePipeline::bind(VkCommandBuffer FCB, uint32_t setIndex) const
+{
+  vulkanCommandState::bindPipeline(FCB, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline);
+  vulkanCommandState::bindDescriptorSets(FCB, VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, 0, 1, &m_DescriptorSets[setIndex]);
+}
+
+void vulkanComputePipeline::pushConstant(VkCommandBuffer FCB, void const* pData) const
+{
+  vkCmdPushConstants(FCB, m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, m_PushConstantSize, pData);
+}
+
+bool windowHandler::createComputePipeline(vulkanComputePipeline& outPipeline, vulkanComputePipeline::setup const& inSetup)
+{
+  assert(outPipeline.m_Pipeline == VK_NULL_HANDLE);
+  outPipeline.m_Bindings = inSetup.m_Bindings;
+  outPipeline.m_PushConstantSize = inSetup.m_PushConstantSize;
+
+  std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+  layoutBindings.reserve(inSetup.m_Bindings.size());
+  for (uint32_t i{ 0 }, t{ static_cast<uint32_t>(inSetup.m_Bindings.size()) }; i < t; ++i)
+  {
+    layoutBindings.emplace_back
+    (
+      i,                            // binding
+      inSetup.m_Bindings[i],        // descriptorType
+      1,                            // descriptorCount
+      VK_SHADER_STAGE_COMPUTE_BIT,  // stageFlags
+      nullptr                       // pImmutableSamplers
+    );
+  }
+  VkDescriptorSetLayoutCreateInfo layoutCreateInfo
+  {
+    .sType{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO },
+    .bindingCount { static_cast<uint32_t>(layoutBindings.size()) },
+    .pBindings    { layoutBindings.data() }
+  };
+  if (VkResult tmpRes{ vkCreateDescriptorSetLayout(m_pVKDevice->m_VKDevice, &layoutCreateInfo, m_pVKInst->m_pVKAllocator, &outPipeline.m_DescriptorSetLayout) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "could not create the compute shader's descriptor set layout"sv, true);
+    return false;
+  }
+
+  VkPushConstantRange pushConstantRange
+  {
+    .stageFlags { VK_SHADER_STAGE_COMPUTE_BIT },
+    .offset     { 0 },
+    .size       { inSetup.m_PushConstantSize }
+  };
+  outPipeline.m_PipelineLayout = createPipelineLayout(VkPipelineLayoutCreateInfo
+  {
+    .sType{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO },
+    .setLayoutCount         { 1 },
+    .pSetLayouts            { &outPipeline.m_DescriptorSetLayout },
+    .pushConstantRangeCount { inSetup.m_PushConstantSize ? 1u : 0u },
+    .pPushConstantRanges    { inSetup.m_PushConstantSize ? &pushConstantRange : nullptr }
+  });
+  if (outPipeline.m_PipelineLayout == VK_NULL_HANDLE)
+  {
+    destroyComputePipeline(outPipeline);
+    return false;
+  }
+
+  VkShaderModule shaderComp{ createShaderModule(std::string{ inSetup.m_PathShaderComp }.c_str()) };
+  if (shaderComp == VK_NULL_HANDLE)
+  {
+    destroyComputePipeline(outPipeline);
+    return false;
+  }
+  VkComputePipelineCreateInfo CreateInfo
+  {
+    .sType{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO },
+    .stage
+    {
+      .sType  { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO },
+      .stage  { VK_SHADER_STAGE_COMPUTE_BIT },
+      .module { shaderComp },
+      .pName  { "main" }
+    },
+    .layout{ outPipeline.m_PipelineLayout }
+  };
+  VkResult pipelineRes{ vkCreateComputePipelines(m_pVKDevice->m_VKDevice, m_pVKDevice->m_VKPipelineCache, 1, &CreateInfo, m_pVKInst->m_pVKAllocator, &outPipeline.m_Pipeline) };
+  destroyShaderModule(shaderComp);
+  if (pipelineRes != VK_SUCCESS)
+  {
+    printVKWarning(pipelineRes, "could not create the compute pipeline"sv, true);
+    destroyComputePipeline(outPipeline);
+    return false;
+  }
+
+  outPipeline.m_DescriptorSets.resize(inSetup.m_SetCount, VK_NULL_HANDLE);
+  std::vector<VkDescriptorSetLayout> setLayouts(inSetup.m_SetCount, outPipeline.m_DescriptorSetLayout);
+  VkResult allocRes{ VK_SUCCESS };
+  {
+    std::scoped_lock lock{ m_pVKDevice->m_LockedVKDescriptorPool };
+    VkDescriptorSetAllocateInfo allocInfo
+    {
+      .sType{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO },
+      .descriptorPool     { m_pVKDevice->m_LockedVKDescriptorPool.get() },
+      .descriptorSetCount { inSetup.m_SetCount },
+      .pSetLayouts        { setLayouts.data() }
+    };
+    allocRes = vkAllocateDescriptorSets(m_pVKDevice->m_VKDevice, &allocInfo, outPipeline.m_DescriptorSets.data());
+  }
+  if (allocRes != VK_SUCCESS)
+  {
+    printVKWarning(allocRes, "failed to create a compute descriptor set"sv, true);
+    outPipeline.m_DescriptorSets.clear();
+    destroyComputePipeline(outPipeline);
+    return false;
+  }
+  return true;
+}
+
+bool windowHandler::updateComputeDescriptors(vulkanComputePipeline& inPipeline, uint32_t setIndex, std::span<const vulkanComputePipeline::descriptorInfo> infos)
+{
+  if (setIndex >= inPipeline.m_DescriptorSets.size() || infos.size() != inPipeline.m_Bindings.size())
+  {
+    printWarning("compute descriptors don't match the pipeline's bindings"sv, true);
+    return false;
+  }
+
+  std::vector<VkWriteDescriptorSet> descriptorWrites;
+  descriptorWrites.reserve(infos.size());
+  for (uint32_t i{ 0 }, t{ static_cast<uint32_t>(infos.size()) }; i < t; ++i)
+  {
+    descriptorWrites.emplace_back(VkWriteDescriptorSet
+    {
+      .sType{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET },
+      .dstSet           { inPipeline.m_DescriptorSets[setIndex] },
+      .dstBinding       { i },
+      .dstArrayElement  { 0 },
+      .descriptorCount  { 1 },
+      .descriptorType   { inPipeline.m_Bindings[i] },
+      .pImageInfo       { std::get_if<VkDescriptorImageInfo>(&infos[i]) },
+      .pBufferInfo      { std::get_if<VkDescriptorBufferInfo>(&infos[i]) },
+      .pTexelBufferView { VK_NULL_HANDLE }
+    });
+  }
+  vkUpdateDescriptorSets(m_pVKDevice->m_VKDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+  return true;
+}
+
+void windowHandler::destroyComputePipeline(vulkanComputePipeline& inPipeline)
+{
+  if (false == inPipeline.m_DescriptorSets.empty())
+  {
+    std::scoped_lock lock{ m_pVKDevice->m_LockedVKDescriptorPool };
+    if (VkResult tmpRes{ vkFreeDescriptorSets(m_pVKDevice->m_VKDevice, m_pVKDevice->m_LockedVKDescriptorPool.get(), static_cast<uint32_t>(inPipeline.m_DescriptorSets.size()), inPipeline.m_DescriptorSets.data()) }; tmpRes != VK_SUCCESS)
+    {
+      printVKWarning(tmpRes, "failed to free the compute descriptor sets"sv, true);
+    }
+    inPipeline.m_DescriptorSets.clear();
+  }
+  if (inPipeline.m_Pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline(m_pVKDevice->m_VKDevice, inPipeline.m_Pipeline, m_pVKInst->m_pVKAllocator);
+    inPipeline.m_Pipeline = VK_NULL_HANDLE;
+  }
+  destroyPipelineLayout(inPipeline.m_PipelineLayout);
+  if (inPipeline.m_DescriptorSetLayout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout(m_pVKDevice->m_VKDevice, inPipeline.m_DescriptorSetLayout, m_pVKInst->m_pVKAllocator);
+    inPipeline.m_DescriptorSetLayout = VK_NULL_HANDLE;
+  }
+  inPipeline.m_Bindings.clear();
+  inPipeline.m_PushConstantSize = 0;
+}
+
+// *****************************************************************************
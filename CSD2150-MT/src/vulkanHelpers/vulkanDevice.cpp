@@ -77,6 +77,25 @@ std::vector<VkPhysicalDevice> collectPhysicalDevices(vulkanInstance& vkInst)
     return retval;
 }
 
+std::vector<VkExtensionProperties> collectDeviceExtensions(VkPhysicalDevice PhysicalDevice)
+{
+    uint32_t numExtensions{ 0 };
+    if (VkResult tmpRes{ vkEnumerateDeviceExtensionProperties(PhysicalDevice, nullptr, &numExtensions, nullptr) }; tmpRes != VK_SUCCESS)
+    {
+        printVKWarning(tmpRes, "Unable to get device extension count"sv);
+        return { /* return empty vector */ };
+    }
+
+    std::vector<VkExtensionProperties> retval{ static_cast<decltype(retval)::size_type>(numExtensions) };
+    if (VkResult tmpRes{ vkEnumerateDeviceExtensionProperties(PhysicalDevice, nullptr, &numExtensions, retval.data()) }; tmpRes != VK_SUCCESS)
+    {
+        printVKWarning(tmpRes, "Unable to get device extensions"sv);
+        return { /* return empty vector */ };
+    }
+    retval.resize(numExtensions);
+    return retval;
+}
+
 bool vulkanDevice::createGraphicsDevice(std::vector<VkQueueFamilyProperties> const& DeviceProperties)
 {
     for (uint32_t i{ 0 }, t{ static_cast<uint32_t>(DeviceProperties.size()) }; i < t; ++i)
@@ -114,28 +133,76 @@ bool vulkanDevice::createGraphicsDevice(std::vector<VkQueueFamilyProperties> con
         }
     };
 
+    // Optional extensions, only enabled if the device has them
+    std::vector<const char*> enabledExtensions
+    {   //VK_NV_GLSL_SHADER_EXTENSION_NAME is deprecated, should not use.
+        VK_KHR_SWAPCHAIN_EXTENSION_NAME
+    };
+    std::vector<VkExtensionProperties> availableExtensions{ collectDeviceExtensions(m_VKPhysicalDevice) };
+    auto isExtensionAvailable
+    {
+        [&availableExtensions](std::string_view const& extName)
+        {
+            return std::any_of(availableExtensions.begin(), availableExtensions.end(), [&extName](VkExtensionProperties const& x) { return extName == x.extensionName; });
+        }
+    };
+
     // Create device
-    VkPhysicalDeviceFeatures Features;
-    vkGetPhysicalDeviceFeatures(m_VKPhysicalDevice, &Features);
+    VkPhysicalDeviceIndexTypeUint8FeaturesEXT IndexTypeUint8Features
+    {
+        .sType                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INDEX_TYPE_UINT8_FEATURES_EXT,
+        .pNext                      = nullptr
+    };
+    VkPhysicalDeviceVulkan12Features Vulkan12Features
+    {
+        .sType                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext                      = nullptr
+    };
+    VkPhysicalDeviceFeatures2 Features2
+    {
+        .sType                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext                      = &Vulkan12Features
+    };
+    if (isExtensionAvailable(VK_EXT_INDEX_TYPE_UINT8_EXTENSION_NAME))Vulkan12Features.pNext = &IndexTypeUint8Features;
+    vkGetPhysicalDeviceFeatures2(m_VKPhysicalDevice, &Features2);
+
+    VkPhysicalDeviceFeatures& Features{ Features2.features };
     Features.shaderClipDistance = true; // ??? overriding some stuff ???
     Features.shaderCullDistance = true;
     Features.samplerAnisotropy  = true;
 
-    static constexpr std::array enabledExtensions
-    {   //VK_NV_GLSL_SHADER_EXTENSION_NAME is deprecated, should not use.
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME
+    hasMultiDrawIndirect = Features.multiDrawIndirect ? 1 : 0;
+
+    // only take what we use from 1.2, some of it (capture replay) costs
+    hasDrawIndirectCount = Vulkan12Features.drawIndirectCount ? 1 : 0;
+    Vulkan12Features = VkPhysicalDeviceVulkan12Features
+    {
+        .sType                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext                      = Vulkan12Features.pNext,
+        .drawIndirectCount          = Vulkan12Features.drawIndirectCount
     };
+
+    hasIndexTypeUint8 = IndexTypeUint8Features.indexTypeUint8 ? 1 : 0;
+    if (hasIndexTypeUint8)
+    {
+        enabledExtensions.emplace_back(VK_EXT_INDEX_TYPE_UINT8_EXTENSION_NAME);
+    }
+    else
+    {
+        Vulkan12Features.pNext = nullptr;
+    }
+
     VkDeviceCreateInfo deviceCreateInfo
     {
         .sType                      = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pNext                      = nullptr,
+        .pNext                      = &Features2,   // features go through pNext
         .queueCreateInfoCount       = static_cast<decltype(VkDeviceCreateInfo::queueCreateInfoCount)>(queueCreateInfo.size()),
         .pQueueCreateInfos          = queueCreateInfo.data(),
         .enabledLayerCount          = 0,
         .ppEnabledLayerNames        = nullptr,
         .enabledExtensionCount      = static_cast<decltype(VkDeviceCreateInfo::enabledExtensionCount)>(enabledExtensions.size()),
         .ppEnabledExtensionNames    = enabledExtensions.data(),
-        .pEnabledFeatures           = &Features
+        .pEnabledFeatures           = nullptr
     };
 
     std::vector<const char*> ValidationLayers;
@@ -161,14 +228,20 @@ bool vulkanDevice::OK() const noexcept
 }
 
 vulkanDevice::vulkanDevice() : 
-    isCreated{ 0 }
+    isCreated{ 0 },
+    hasIndexTypeUint8{ 0 },
+    hasMultiDrawIndirect{ 0 },
+    hasDrawIndirectCount{ 0 }
 {
 
 }
 
 vulkanDevice::vulkanDevice(std::shared_ptr<vulkanInstance>& pVKInst) : 
     m_pVKInst{ pVKInst },
-    isCreated{ 0 }
+    isCreated{ 0 },
+    hasIndexTypeUint8{ 0 },
+    hasMultiDrawIndirect{ 0 },
+    hasDrawIndirectCount{ 0 }
 {
     if (m_pVKInst && m_pVKInst->OK())
     {
@@ -0,0 +1,280 @@
+/*!*****************************************************************************
+ * @file    vulkanGPUCuller.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanGPUCuller struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <array>
+#include <cstdio>
+#include <utility>
+#include <algorithm>
+#include <vulkanHelpers/vulkanGPUCuller.h>
+#include <vulkanHelpers/vulkanWindow.h>
+#include <handlers/windowHandler.h>
+
+namespace MTU
+{
+  namespace Helper
+  {
+    static constexpr uint32_t s_CommandWords{ sizeof(VkDrawIndexedIndirectCommand) / sizeof(uint32_t) };
+    static constexpr float    s_VerifySlack { 1.0e-3f };// world units either side of a plane GPU and CPU may disagree on
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+bool vulkanGPUCuller::createGPUCuller(std::string_view const& shaderPath, uint32_t maxObjects, vulkanIndirectBuffer const& Indirect, vulkanHiZ const& HiZ)
+{
+  assert(m_Buffers.empty());
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  uint32_t frameCount{ static_cast<uint32_t>(Indirect.m_Buffers.size()) };
+  if (maxObjects == 0 || frameCount == 0)return false;
+
+  if (false == pWH->createComputePipeline(m_Pipeline,
+    vulkanComputePipeline::setup
+    {
+      .m_PathShaderComp   { shaderPath },
+      .m_Bindings         { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER },
+      .m_SetCount         { frameCount },
+      .m_PushConstantSize { sizeof(cullConstants) }
+    }))
+  {
+    printWarning("failed to create the cull pipeline"sv, true);
+    return false;
+  }
+
+  m_pHiZ = &HiZ;
+  m_pIndirect = &Indirect;
+  m_MaxObjects = maxObjects;
+  m_Buffers.resize(frameCount);
+  m_pMapped.resize(frameCount, nullptr);
+  m_ViewBuffers.resize(frameCount);
+  m_pViews.resize(frameCount, nullptr);
+  m_Frames.resize(frameCount);
+  for (uint32_t i{ 0 }; i < frameCount; ++i)
+  {
+    if (false == pWH->createBuffer
+    (
+      m_Buffers[i],
+      {
+        .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Storage },
+        .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Storage },
+        .m_Count      { maxObjects },
+        .m_ElemSize   { sizeof(MTU::cullObject) }
+      }
+    ) || nullptr == (m_pMapped[i] = static_cast<MTU::cullObject*>(pWH->mapBuffer(m_Buffers[i]))))
+    {
+      printWarning("failed to create cull object buffer"sv, true);
+      destroyGPUCuller();
+      return false;
+    }
+    if (false == pWH->createBuffer
+    (
+      m_ViewBuffers[i],
+      {
+        .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Uniform },
+        .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Uniform },
+        .m_Count      { 1 },
+        .m_ElemSize   { sizeof(cullView) }
+      }
+    ) || nullptr == (m_pViews[i] = static_cast<cullView*>(pWH->mapBuffer(m_ViewBuffers[i]))))
+    {
+      printWarning("failed to create cull view buffer"sv, true);
+      destroyGPUCuller();
+      return false;
+    }
+    *m_pViews[i] = cullView{};
+    if (false == writeDescriptors(i))
+    {
+      destroyGPUCuller();
+      return false;
+    }
+  }
+  return true;
+}
+
+void vulkanGPUCuller::destroyGPUCuller()
+{
+  if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)
+  {
+    for (size_t i{ 0 }, t{ m_Buffers.size() }; i < t; ++i)
+    {
+      if (m_pMapped[i] != nullptr)pWH->unmapBuffer(m_Buffers[i]);
+      pWH->destroyBuffer(m_Buffers[i]);
+      if (m_pViews[i] != nullptr)pWH->unmapBuffer(m_ViewBuffers[i]);
+      pWH->destroyBuffer(m_ViewBuffers[i]);
+    }
+    pWH->destroyComputePipeline(m_Pipeline);
+  }
+  m_Buffers.clear();
+  m_pMapped.clear();
+  m_ViewBuffers.clear();
+  m_pViews.clear();
+  m_Frames.clear();
+  m_pHiZ = nullptr;
+  m_pIndirect = nullptr;
+  m_MaxObjects = 0;
+}
+
+bool vulkanGPUCuller::beginFrame(uint32_t frameIndex, MTU::frustum const& worldFrustum, bool bOcclusion)
+{
+  if (frameIndex >= m_Frames.size())return false;
+  frameState& refFrame{ m_Frames[frameIndex] };
+  refFrame.m_Culls.clear();
+  refFrame.m_Frustum = worldFrustum;
+
+  // the pyramid was remade since this set last pointed at it
+  if (refFrame.m_HiZGeneration != m_pHiZ->m_Generation && false == writeDescriptors(frameIndex))return false;
+
+  refFrame.m_bOcclusion = bOcclusion && m_pHiZ->m_bValid;
+  cullView& refView{ *m_pViews[frameIndex] };
+  std::copy(std::begin(worldFrustum.m_Planes), std::end(worldFrustum.m_Planes), refView.m_Planes);
+  refView.m_HiZW2V = m_pHiZ->m_W2V;
+  refView.m_HiZInfo = glm::ivec4
+  {
+    m_pHiZ->m_pWindow->m_DepthExtent.width,
+    m_pHiZ->m_pWindow->m_DepthExtent.height,
+    m_pHiZ->m_LevelCount,
+    refFrame.m_bOcclusion ? 1 : 0
+  };
+  return true;
+}
+
+std::span<MTU::cullObject> vulkanGPUCuller::getObjects(uint32_t frameIndex)
+{
+  if (frameIndex >= m_pMapped.size())return {};
+  return std::span<MTU::cullObject>{ m_pMapped[frameIndex], m_MaxObjects };
+}
+
+uint32_t vulkanGPUCuller::cull(VkCommandBuffer FCB, vulkanIndirectBuffer& Indirect, uint32_t firstObject, uint32_t objectCount)
+{
+  assert(&Indirect == m_pIndirect);
+  firstObject = std::min(firstObject, m_MaxObjects);
+  objectCount = std::min(objectCount, m_MaxObjects - firstObject);
+  uint32_t batchIndex{ Indirect.beginBatch(objectCount) };
+  if (batchIndex == UINT32_MAX)return batchIndex;
+
+  uint32_t frameIndex{ Indirect.m_FrameIndex };
+  cullRecord& refRecord
+  {
+    m_Frames[frameIndex].m_Culls.emplace_back(cullRecord
+    {
+      .m_FirstObject  { firstObject },
+      .m_ObjectCount  { objectCount },
+      .m_FirstCommand { Indirect.m_Batches[batchIndex].m_FirstCommand },
+      .m_CountWord    { static_cast<uint32_t>(Indirect.getCountOffset(batchIndex) / sizeof(uint32_t)) },
+      .m_bCompact     { Indirect.readsDrawCount(objectCount) }
+    })
+  };
+  if (objectCount == 0)return batchIndex;
+
+  // beginBatch zeroed the count through the mapping, visible at submit
+  cullConstants constants
+  {
+    .m_FirstObject  { firstObject },
+    .m_ObjectCount  { objectCount },
+    .m_FirstWord    { refRecord.m_FirstCommand * MTU::Helper::s_CommandWords },
+    .m_CountWord    { refRecord.m_CountWord },
+    .m_Compact      { refRecord.m_bCompact ? 1u : 0u }
+  };
+
+  m_Pipeline.bind(FCB, frameIndex);
+  m_Pipeline.pushConstant(FCB, &constants);
+  vkCmdDispatch(FCB, (objectCount + s_GroupSize - 1) / s_GroupSize, 1, 1);
+
+  VkMemoryBarrier barrier
+  {
+    .sType        { VK_STRUCTURE_TYPE_MEMORY_BARRIER },
+    .srcAccessMask{ VK_ACCESS_SHADER_WRITE_BIT },
+    .dstAccessMask{ VK_ACCESS_INDIRECT_COMMAND_READ_BIT }
+  };
+  vkCmdPipelineBarrier(FCB, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  return batchIndex;
+}
+
+bool vulkanGPUCuller::verify(vulkanIndirectBuffer const& Indirect, uint32_t frameIndex, uint32_t& outVisible)
+{
+  outVisible = 0;
+  if (frameIndex >= m_Frames.size() || frameIndex >= Indirect.m_pMapped.size())return false;
+  frameState& refFrame{ m_Frames[frameIndex] };
+  std::vector<cullRecord> culls{ std::move(refFrame.m_Culls) };
+  refFrame.m_Culls.clear();
+  bool bOK{ true };
+  for (cullRecord const& refRecord : culls)
+  {
+    if (refRecord.m_ObjectCount == 0)continue;
+    std::span<const MTU::cullObject> objects{ m_pMapped[frameIndex] + refRecord.m_FirstObject, refRecord.m_ObjectCount };
+
+    // what the GPU drew, as instance IDs
+    VkDrawIndexedIndirectCommand const* pCommands{ Indirect.m_pMapped[frameIndex] + refRecord.m_FirstCommand };
+    uint32_t commandCount{ refRecord.m_bCompact ? reinterpret_cast<uint32_t const*>(Indirect.m_pMapped[frameIndex])[refRecord.m_CountWord] : refRecord.m_ObjectCount };
+    if (commandCount > refRecord.m_ObjectCount)
+    {
+      printWarning("GPU cull wrote more draws than objects"sv, true);
+      return false;
+    }
+    std::vector<uint32_t> gpuVisible;
+    for (uint32_t i{ 0 }; i < commandCount; ++i)
+    {
+      if (pCommands[i].instanceCount)gpuVisible.emplace_back(pCommands[i].firstInstance);
+    }
+    outVisible += static_cast<uint32_t>(gpuVisible.size());
+
+    // the CPU sets with borderline objects kept (loose) and dropped (tight)
+    std::vector<uint32_t> loose, tight;
+    MTU::cullObjects(refFrame.m_Frustum, objects, loose, MTU::Helper::s_VerifySlack);
+    if (false == refFrame.m_bOcclusion)MTU::cullObjects(refFrame.m_Frustum, objects, tight, -MTU::Helper::s_VerifySlack);
+    auto toInstanceIDs
+    {
+      [&objects](std::vector<uint32_t>& x)
+      {
+        for (uint32_t& i : x)i = objects[i].m_InstanceID;
+        std::sort(x.begin(), x.end());
+      }
+    };
+    toInstanceIDs(loose);
+    toInstanceIDs(tight);
+    std::sort(gpuVisible.begin(), gpuVisible.end());
+
+    // occluded objects are a subset of the frustum's, only check the outside
+    bool bCullOK{ std::adjacent_find(gpuVisible.begin(), gpuVisible.end()) == gpuVisible.end() };// no object drawn twice
+    bCullOK = bCullOK && std::includes(loose.begin(), loose.end(), gpuVisible.begin(), gpuVisible.end());
+    bCullOK = bCullOK && std::includes(gpuVisible.begin(), gpuVisible.end(), tight.begin(), tight.end());
+    if (false == bCullOK)
+    {
+      printf_s("GPU cull mismatch: GPU %zu, CPU %zu to %zu visible of %u\n", gpuVisible.size(), tight.size(), loose.size(), refRecord.m_ObjectCount);
+    }
+    bOK = bOK && bCullOK;
+  }
+  return bOK;
+}
+
+// *****************************************************************************
+// ****************************************************** Private functions ****
+
+bool vulkanGPUCuller::writeDescriptors(uint32_t frameIndex)
+{
+  if (m_pHiZ->m_View == VK_NULL_HANDLE)
+  {
+    printWarning("the Hi-Z pyramid the culler reads is missing"sv, true);
+    return false;
+  }
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  std::array<vulkanComputePipeline::descriptorInfo, 4> infos
+  {
+    VkDescriptorBufferInfo{ .buffer{ m_Buffers[frameIndex].m_Buffer }, .offset{ 0 }, .range{ VK_WHOLE_SIZE } },
+    VkDescriptorBufferInfo{ .buffer{ m_pIndirect->m_Buffers[frameIndex].m_Buffer }, .offset{ 0 }, .range{ VK_WHOLE_SIZE } },
+    VkDescriptorBufferInfo{ .buffer{ m_ViewBuffers[frameIndex].m_Buffer }, .offset{ 0 }, .range{ VK_WHOLE_SIZE } },
+    m_pHiZ->getDescriptorInfo()
+  };
+  if (false == pWH->updateComputeDescriptors(m_Pipeline, frameIndex, infos))return false;
+  m_Frames[frameIndex].m_HiZGeneration = m_pHiZ->m_Generation;
+  return true;
+}
+
+// *****************************************************************************
@@ -0,0 +1,95 @@
+/*!*****************************************************************************
+ * @file    vulkanGeometryArena.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanGeometryArena struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <vulkanHelpers/vulkanGeometryArena.h>
+#include <handlers/windowHandler.h>
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+bool vulkanGeometryArena::createArena(uint32_t vertexCapacity, uint32_t vertexStride, uint32_t indexCapacity, VkIndexType indexType)
+{
+  assert(m_Buffer_Vertex.m_Buffer == VK_NULL_HANDLE && m_Buffer_Index.m_Buffer == VK_NULL_HANDLE);
+  assert(indexType == VK_INDEX_TYPE_UINT16 || indexType == VK_INDEX_TYPE_UINT32);
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (vertexCapacity == 0 || vertexStride == 0 || indexCapacity == 0)return false;
+
+  m_IndexType = indexType;
+  m_VertexStride = vertexStride;
+  if (false == pWH->createBuffer
+  (
+    m_Buffer_Vertex,
+    {
+      .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Vertex },
+      .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Vertex },
+      .m_Count      { vertexCapacity },
+      .m_ElemSize   { vertexStride }
+    }
+  ) || false == pWH->createBuffer
+  (
+    m_Buffer_Index,
+    {
+      .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Index },
+      .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Index },
+      .m_Count      { indexCapacity },
+      .m_ElemSize   { getIndexSize() }
+    }
+  ))
+  {
+    printWarning("failed to create geometry arena buffers"sv, true);
+    destroyArena();
+    return false;
+  }
+
+  m_VertexRanges.reset(vertexCapacity);
+  m_IndexRanges.reset(indexCapacity);
+  return true;
+}
+
+void vulkanGeometryArena::destroyArena()
+{
+  if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)
+  {
+    pWH->destroyBuffer(m_Buffer_Vertex);
+    pWH->destroyBuffer(m_Buffer_Index);
+  }
+  m_VertexRanges.reset(0);
+  m_IndexRanges.reset(0);
+}
+
+bool vulkanGeometryArena::allocate(uint32_t vertexCount, uint32_t indexCount, uint32_t& outVertexOffset, uint32_t& outFirstIndex)
+{
+  if (false == m_VertexRanges.allocate(vertexCount, outVertexOffset))return false;
+  if (false == m_IndexRanges.allocate(indexCount, outFirstIndex))
+  {
+    m_VertexRanges.free(outVertexOffset, vertexCount);
+    return false;
+  }
+  return true;
+}
+
+void vulkanGeometryArena::free(uint32_t vertexOffset, uint32_t vertexCount, uint32_t firstIndex, uint32_t indexCount)
+{
+  m_VertexRanges.free(vertexOffset, vertexCount);
+  m_IndexRanges.free(firstIndex, indexCount);
+}
+
+uint32_t vulkanGeometryArena::getIndexSize() const noexcept
+{
+  return m_IndexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+void vulkanGeometryArena::bind(VkCommandBuffer FCB) const
+{
+  vulkanCommandState::bindVertexBuffer(FCB, 0, m_Buffer_Vertex.m_Buffer);
+  vulkanCommandState::bindIndexBuffer(FCB, m_Buffer_Index.m_Buffer, 0, m_IndexType);
+}
+
+// *****************************************************************************
@@ -0,0 +1,298 @@
+/*!*****************************************************************************
+ * @file    vulkanHiZ.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanHiZ struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <array>
+#include <algorithm>
+#include <vulkanHelpers/vulkanHiZ.h>
+#include <vulkanHelpers/vulkanWindow.h>
+#include <handlers/windowHandler.h>
+
+namespace MTU
+{
+  namespace Helper
+  {
+    // shaderHiZ.comp's push constants
+    struct hiZConstants
+    {
+      int32_t m_SrcWidth;
+      int32_t m_SrcHeight;
+      int32_t m_DstWidth;
+      int32_t m_DstHeight;
+    };
+
+    static constexpr VkImageLayout s_DepthReadLayout{ VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+bool vulkanHiZ::createHiZ(vulkanWindow& Window, std::string_view const& shaderPath)
+{
+  assert(m_Image == VK_NULL_HANDLE);
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (0 == Window.m_bfDepthReadable)
+  {
+    printWarning("Hi-Z needs a window made with m_bDepthReadable"sv, true);
+    return false;
+  }
+  m_pWindow = &Window;
+
+  VkSamplerCreateInfo SamplerInfo
+  {
+    .sType        { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO },
+    .magFilter    { VK_FILTER_NEAREST },
+    .minFilter    { VK_FILTER_NEAREST },
+    .mipmapMode   { VK_SAMPLER_MIPMAP_MODE_NEAREST },
+    .addressModeU { VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE },
+    .addressModeV { VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE },
+    .addressModeW { VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE },
+    .maxLod       { VK_LOD_CLAMP_NONE }
+  };
+  if (VkResult tmpRes{ vkCreateSampler(Window.m_Device->m_VKDevice, &SamplerInfo, Window.m_Device->m_pVKInst->m_pVKAllocator, &m_Sampler) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Failed to create the Hi-Z sampler"sv, true);
+    destroyHiZ();
+    return false;
+  }
+
+  if (false == pWH->createComputePipeline(m_Pipeline,
+    vulkanComputePipeline::setup
+    {
+      .m_PathShaderComp   { shaderPath },
+      .m_Bindings         { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE },
+      .m_SetCount         { s_MaxLevels },
+      .m_PushConstantSize { sizeof(MTU::Helper::hiZConstants) }
+    }) || false == createPyramid())
+  {
+    printWarning("failed to create the Hi-Z pyramid"sv, true);
+    destroyHiZ();
+    return false;
+  }
+  return true;
+}
+
+void vulkanHiZ::destroyHiZ()
+{
+  if (m_pWindow != nullptr)
+  {
+    destroyPyramid();
+    if (m_Sampler != VK_NULL_HANDLE)vkDestroySampler(m_pWindow->m_Device->m_VKDevice, m_Sampler, m_pWindow->m_Device->m_pVKInst->m_pVKAllocator);
+  }
+  if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)pWH->destroyComputePipeline(m_Pipeline);
+  m_Sampler = VK_NULL_HANDLE;
+  m_pWindow = nullptr;
+}
+
+bool vulkanHiZ::update()
+{
+  assert(m_pWindow != nullptr);
+  if (m_DepthGeneration == m_pWindow->m_DepthGeneration)return true;
+
+  // the swapchain remake already waited, this is for anything since
+  m_pWindow->m_Device->waitForDeviceIdle();
+  destroyPyramid();
+  if (createPyramid())return true;
+  destroyPyramid();
+  return false;
+}
+
+void vulkanHiZ::build(VkCommandBuffer FCB, glm::mat4 const& W2V)
+{
+  assert(m_pWindow != nullptr && m_DepthGeneration == m_pWindow->m_DepthGeneration);
+  if (m_Image == VK_NULL_HANDLE)return;// a failed remake
+
+  // this frame's cull read the pyramid, don't overwrite it under that read
+  // (the render pass dependency covers the depth buffer)
+  VkMemoryBarrier barrier
+  {
+    .sType        { VK_STRUCTURE_TYPE_MEMORY_BARRIER },
+    .srcAccessMask{ 0 },
+    .dstAccessMask{ 0 }
+  };
+  vkCmdPipelineBarrier(FCB, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+  barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+  VkExtent2D srcExtent{ m_pWindow->m_DepthExtent }, dstExtent{ m_Extent };
+  for (uint32_t i{ 0 }; i < m_LevelCount; ++i)
+  {
+    if (i)vkCmdPipelineBarrier(FCB, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    MTU::Helper::hiZConstants constants
+    {
+      .m_SrcWidth { static_cast<int32_t>(srcExtent.width) },
+      .m_SrcHeight{ static_cast<int32_t>(srcExtent.height) },
+      .m_DstWidth { static_cast<int32_t>(dstExtent.width) },
+      .m_DstHeight{ static_cast<int32_t>(dstExtent.height) }
+    };
+    m_Pipeline.bind(FCB, i);
+    m_Pipeline.pushConstant(FCB, &constants);
+    vkCmdDispatch(FCB, (dstExtent.width + s_GroupSize - 1) / s_GroupSize, (dstExtent.height + s_GroupSize - 1) / s_GroupSize, 1);
+
+    srcExtent = dstExtent;
+    dstExtent = VkExtent2D{ (dstExtent.width + 1) / 2, (dstExtent.height + 1) / 2 };
+  }
+
+  // readers are compute (next frame's cull), they barrier nothing themselves
+  vkCmdPipelineBarrier(FCB, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+  m_W2V = W2V;
+  m_bValid = true;
+}
+
+VkDescriptorImageInfo vulkanHiZ::getDescriptorInfo() const noexcept
+{
+  return VkDescriptorImageInfo{ .sampler{ m_Sampler }, .imageView{ m_View }, .imageLayout{ VK_IMAGE_LAYOUT_GENERAL } };
+}
+
+// *****************************************************************************
+// ****************************************************** Private functions ****
+
+bool vulkanHiZ::createPyramid()
+{
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  vulkanDevice& Device{ *m_pWindow->m_Device };
+  VkAllocationCallbacks* pAllocator{ Device.m_pVKInst->m_pVKAllocator };
+
+  m_DepthGeneration = m_pWindow->m_DepthGeneration;
+  m_Extent = VkExtent2D{ std::max((m_pWindow->m_DepthExtent.width + 1) / 2, 1u), std::max((m_pWindow->m_DepthExtent.height + 1) / 2, 1u) };
+  m_LevelCount = 1;
+  for (uint32_t w{ m_Extent.width }, h{ m_Extent.height }; (w > 1 || h > 1) && m_LevelCount < s_MaxLevels; ++m_LevelCount)
+  {
+    w = (w + 1) / 2;
+    h = (h + 1) / 2;
+  }
+  m_bValid = false;
+  ++m_Generation;
+
+  VkImageCreateInfo ImageInfo
+  {
+    .sType          { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO },
+    .imageType      { VK_IMAGE_TYPE_2D },
+    .format         { s_Format },
+    .extent         { .width{ m_Extent.width }, .height{ m_Extent.height }, .depth{ 1 } },
+    .mipLevels      { m_LevelCount },
+    .arrayLayers    { 1 },
+    .samples        { VK_SAMPLE_COUNT_1_BIT },
+    .tiling         { VK_IMAGE_TILING_OPTIMAL },
+    .usage          { VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT },
+    .sharingMode    { VK_SHARING_MODE_EXCLUSIVE },
+    .initialLayout  { VK_IMAGE_LAYOUT_UNDEFINED }
+  };
+  if (VkResult tmpRes{ vkCreateImage(Device.m_VKDevice, &ImageInfo, pAllocator, &m_Image) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Failed to create the Hi-Z image"sv, true);
+    return false;
+  }
+
+  VkMemoryRequirements memRequirements;
+  vkGetImageMemoryRequirements(Device.m_VKDevice, m_Image, &memRequirements);
+  uint32_t MemoryIndex;
+  if (false == Device.getMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryIndex))
+  {
+    printWarning("Failed to find the right type of memory to allocate the Hi-Z image"sv, true);
+    return false;
+  }
+  VkMemoryAllocateInfo AllocInfo
+  {
+    .sType          { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO },
+    .allocationSize { memRequirements.size },
+    .memoryTypeIndex{ MemoryIndex }
+  };
+  if (VkResult tmpRes{ vkAllocateMemory(Device.m_VKDevice, &AllocInfo, pAllocator, &m_Memory) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Failed to allocate memory for the Hi-Z image"sv, true);
+    return false;
+  }
+  if (VkResult tmpRes{ vkBindImageMemory(Device.m_VKDevice, m_Image, m_Memory, 0) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Failed to bind the Hi-Z image with its memory"sv, true);
+    return false;
+  }
+
+  // level views are written, the whole view is read by culling
+  m_LevelViews.resize(m_LevelCount, VK_NULL_HANDLE);
+  for (uint32_t i{ 0 }; i <= m_LevelCount; ++i)
+  {
+    VkImageViewCreateInfo ViewInfo
+    {
+      .sType      { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO },
+      .image      { m_Image },
+      .viewType   { VK_IMAGE_VIEW_TYPE_2D },
+      .format     { s_Format },
+      .subresourceRange
+      {
+        .aspectMask     { VK_IMAGE_ASPECT_COLOR_BIT },
+        .baseMipLevel   { i == m_LevelCount ? 0 : i },
+        .levelCount     { i == m_LevelCount ? m_LevelCount : 1 },
+        .baseArrayLayer { 0 },
+        .layerCount     { 1 }
+      }
+    };
+    if (VkResult tmpRes{ vkCreateImageView(Device.m_VKDevice, &ViewInfo, pAllocator, i == m_LevelCount ? &m_View : &m_LevelViews[i]) }; tmpRes != VK_SUCCESS)
+    {
+      printVKWarning(tmpRes, "Failed to create a Hi-Z view"sv, true);
+      return false;
+    }
+  }
+
+  // level i reads level i - 1 (or the depth buffer) and writes level i
+  for (uint32_t i{ 0 }; i < m_LevelCount; ++i)
+  {
+    std::array<vulkanComputePipeline::descriptorInfo, 2> infos
+    {
+      i == 0 ?
+      VkDescriptorImageInfo{ .sampler{ m_Sampler }, .imageView{ m_pWindow->m_VKDepthbufferView }, .imageLayout{ MTU::Helper::s_DepthReadLayout } } :
+      VkDescriptorImageInfo{ .sampler{ m_Sampler }, .imageView{ m_LevelViews[i - 1] }, .imageLayout{ VK_IMAGE_LAYOUT_GENERAL } },
+      VkDescriptorImageInfo{ .sampler{ VK_NULL_HANDLE }, .imageView{ m_LevelViews[i] }, .imageLayout{ VK_IMAGE_LAYOUT_GENERAL } }
+    };
+    if (false == pWH->updateComputeDescriptors(m_Pipeline, i, infos))return false;
+  }
+
+  // GENERAL for good, storage writes and sampled reads both allow it
+  VkCommandBuffer CmdBuffer{ pWH->beginOneTimeSubmitCommand(true) };
+  if (CmdBuffer == VK_NULL_HANDLE)return false;
+  VkImageMemoryBarrier ImageBarrier
+  {
+    .sType              { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER },
+    .srcAccessMask      { 0 },
+    .dstAccessMask      { VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT },
+    .oldLayout          { VK_IMAGE_LAYOUT_UNDEFINED },
+    .newLayout          { VK_IMAGE_LAYOUT_GENERAL },
+    .srcQueueFamilyIndex{ VK_QUEUE_FAMILY_IGNORED },
+    .dstQueueFamilyIndex{ VK_QUEUE_FAMILY_IGNORED },
+    .image              { m_Image },
+    .subresourceRange   { .aspectMask{ VK_IMAGE_ASPECT_COLOR_BIT }, .baseMipLevel{ 0 }, .levelCount{ m_LevelCount }, .baseArrayLayer{ 0 }, .layerCount{ 1 } }
+  };
+  vkCmdPipelineBarrier(CmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &ImageBarrier);
+  pWH->endOneTimeSubmitCommand(CmdBuffer, true);
+  return true;
+}
+
+void vulkanHiZ::destroyPyramid()
+{
+  vulkanDevice& Device{ *m_pWindow->m_Device };
+  VkAllocationCallbacks* pAllocator{ Device.m_pVKInst->m_pVKAllocator };
+  for (VkImageView& x : m_LevelViews)
+  {
+    if (x != VK_NULL_HANDLE)vkDestroyImageView(Device.m_VKDevice, x, pAllocator);
+  }
+  m_LevelViews.clear();
+  if (m_View != VK_NULL_HANDLE)vkDestroyImageView(Device.m_VKDevice, m_View, pAllocator);
+  if (m_Image != VK_NULL_HANDLE)vkDestroyImage(Device.m_VKDevice, m_Image, pAllocator);
+  if (m_Memory != VK_NULL_HANDLE)vkFreeMemory(Device.m_VKDevice, m_Memory, pAllocator);
+  m_View = VK_NULL_HANDLE;
+  m_Image = VK_NULL_HANDLE;
+  m_Memory = VK_NULL_HANDLE;
+  m_LevelCount = 0;
+  m_bValid = false;
+}
+
+// *****************************************************************************
@@ -0,0 +1,151 @@
+/*!*****************************************************************************
+ * @file    vulkanIndirectBuffer.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanIndirectBuffer struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <algorithm>
+#include <vulkanHelpers/vulkanIndirectBuffer.h>
+#include <handlers/windowHandler.h>
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+bool vulkanIndirectBuffer::createIndirectBuffer(uint32_t maxCommands, uint32_t maxBatches, uint32_t frameCount)
+{
+  assert(m_Buffers.empty());
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (maxCommands == 0 || maxBatches == 0 || frameCount == 0)return false;
+
+  m_MaxCommands = maxCommands;
+  m_MaxBatches = maxBatches;
+  m_MaxDrawCount = std::max(pWH->getMaxDrawIndirectCount(), 1u);
+  m_bDrawCount = pWH->isDrawIndirectCountSupported();
+  m_Batches.reserve(maxBatches);
+
+  // counts sit after the commands, both are 4 byte aligned as required
+  static_assert(sizeof(VkDrawIndexedIndirectCommand) % sizeof(uint32_t) == 0);
+  uint32_t countElems{ static_cast<uint32_t>((maxBatches * sizeof(uint32_t) + sizeof(VkDrawIndexedIndirectCommand) - 1) / sizeof(VkDrawIndexedIndirectCommand)) };
+
+  m_Buffers.resize(frameCount);
+  m_pMapped.resize(frameCount, nullptr);
+  for (uint32_t i{ 0 }; i < frameCount; ++i)
+  {
+    if (false == pWH->createBuffer
+    (
+      m_Buffers[i],
+      {
+        .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Indirect },
+        .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Indirect },
+        .m_Count      { maxCommands + countElems },
+        .m_ElemSize   { sizeof(VkDrawIndexedIndirectCommand) }
+      }
+    ) || nullptr == (m_pMapped[i] = static_cast<VkDrawIndexedIndirectCommand*>(pWH->mapBuffer(m_Buffers[i]))))
+    {
+      printWarning("failed to create indirect buffer"sv, true);
+      destroyIndirectBuffer();
+      return false;
+    }
+  }
+  return true;
+}
+
+void vulkanIndirectBuffer::destroyIndirectBuffer()
+{
+  if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)
+  {
+    for (size_t i{ 0 }, t{ m_Buffers.size() }; i < t; ++i)
+    {
+      if (m_pMapped[i] != nullptr)pWH->unmapBuffer(m_Buffers[i]);
+      pWH->destroyBuffer(m_Buffers[i]);
+    }
+  }
+  m_Buffers.clear();
+  m_pMapped.clear();
+  m_Batches.clear();
+  m_MaxCommands = m_MaxBatches = m_UsedCommands = m_FrameIndex = 0;
+}
+
+void vulkanIndirectBuffer::begin(uint32_t frameIndex)
+{
+  assert(frameIndex < m_Buffers.size());
+  m_FrameIndex = frameIndex;
+  m_UsedCommands = 0;
+  m_Batches.clear();
+}
+
+uint32_t vulkanIndirectBuffer::beginBatch(uint32_t reserveCommands)
+{
+  // close the open batch so its reserved slots can't be appended over
+  if (false == m_Batches.empty())m_UsedCommands = m_Batches.back().m_FirstCommand + std::max(m_Batches.back().m_CommandCount, m_Batches.back().m_MaxCommands);
+  if (m_Batches.size() >= m_MaxBatches || m_UsedCommands + reserveCommands > m_MaxCommands)return UINT32_MAX;
+
+  uint32_t batchIndex{ static_cast<uint32_t>(m_Batches.size()) };
+  m_Batches.emplace_back(batch{ .m_FirstCommand{ m_UsedCommands }, .m_CommandCount{ 0 }, .m_MaxCommands{ reserveCommands } });
+  reinterpret_cast<uint32_t*>(m_pMapped[m_FrameIndex] + m_MaxCommands)[batchIndex] = 0;
+
+  // without a count every reserved slot is drawn, unwritten ones as nothing
+  if (false == readsDrawCount(reserveCommands))std::fill_n(m_pMapped[m_FrameIndex] + m_UsedCommands, reserveCommands, VkDrawIndexedIndirectCommand{});
+  return batchIndex;
+}
+
+bool vulkanIndirectBuffer::append(VkDrawIndexedIndirectCommand const& command)
+{
+  if (m_Batches.empty())return false;
+  batch& refBatch{ m_Batches.back() };
+  uint32_t slot{ refBatch.m_FirstCommand + refBatch.m_CommandCount };
+  if (slot >= m_MaxCommands)return false;
+
+  m_pMapped[m_FrameIndex][slot] = command;
+  reinterpret_cast<uint32_t*>(m_pMapped[m_FrameIndex] + m_MaxCommands)[m_Batches.size() - 1] = ++refBatch.m_CommandCount;
+  return true;
+}
+
+std::span<VkDrawIndexedIndirectCommand> vulkanIndirectBuffer::getCommands(uint32_t batchIndex)
+{
+  if (batchIndex >= m_Batches.size())return {};
+  batch const& refBatch{ m_Batches[batchIndex] };
+  return std::span<VkDrawIndexedIndirectCommand>{ m_pMapped[m_FrameIndex] + refBatch.m_FirstCommand, std::max(refBatch.m_CommandCount, refBatch.m_MaxCommands) };
+}
+
+VkDeviceSize vulkanIndirectBuffer::getCommandOffset(uint32_t batchIndex) const
+{
+  return static_cast<VkDeviceSize>(m_Batches[batchIndex].m_FirstCommand) * sizeof(VkDrawIndexedIndirectCommand);
+}
+
+VkDeviceSize vulkanIndirectBuffer::getCountOffset(uint32_t batchIndex) const
+{
+  return static_cast<VkDeviceSize>(m_MaxCommands) * sizeof(VkDrawIndexedIndirectCommand) + static_cast<VkDeviceSize>(batchIndex) * sizeof(uint32_t);
+}
+
+bool vulkanIndirectBuffer::readsDrawCount(uint32_t maxCommands) const noexcept
+{
+  return m_bDrawCount && maxCommands <= m_MaxDrawCount;
+}
+
+void vulkanIndirectBuffer::draw(VkCommandBuffer FCB, uint32_t batchIndex) const
+{
+  if (batchIndex >= m_Batches.size())return;
+  batch const& refBatch{ m_Batches[batchIndex] };
+  VkBuffer buffer{ m_Buffers[m_FrameIndex].m_Buffer };
+  constexpr uint32_t stride{ sizeof(VkDrawIndexedIndirectCommand) };
+
+  // a GPU filled batch needs the count from the buffer, the CPU count is 0
+  uint32_t maxCount{ std::max(refBatch.m_CommandCount, refBatch.m_MaxCommands) };
+  if (readsDrawCount(maxCount))
+  {
+    if (maxCount)vkCmdDrawIndexedIndirectCount(FCB, buffer, getCommandOffset(batchIndex), buffer, getCountOffset(batchIndex), maxCount, stride);
+    return;
+  }
+
+  for (uint32_t i{ 0 }, t{ maxCount }; i < t; i += m_MaxDrawCount)
+  {
+    vkCmdDrawIndexedIndirect(FCB, buffer, getCommandOffset(batchIndex) + static_cast<VkDeviceSize>(i) * stride, std::min(t - i, m_MaxDrawCount), stride);
+  }
+}
+
+// *****************************************************************************
@@ -0,0 +1,74 @@
+/*!*****************************************************************************
+ * @file    vulkanInstanceBuffer.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanInstanceBuffer struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <vulkanHelpers/vulkanInstanceBuffer.h>
+#include <vulkanHelpers/vulkanPipeline.h>
+#include <handlers/windowHandler.h>
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+bool vulkanInstanceBuffer::createInstanceBuffer(uint32_t maxInstances, uint32_t frameCount)
+{
+  assert(m_Buffers.empty());
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (maxInstances == 0 || frameCount == 0)return false;
+
+  m_MaxInstances = maxInstances;
+  m_Buffers.resize(frameCount);
+  m_pMapped.resize(frameCount, nullptr);
+  for (uint32_t i{ 0 }; i < frameCount; ++i)
+  {
+    if (false == pWH->createBuffer
+    (
+      m_Buffers[i],
+      {
+        .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Instance },
+        .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Instance },
+        .m_Count      { maxInstances },
+        .m_ElemSize   { sizeof(VTX_INSTANCE) }
+      }
+    ) || nullptr == (m_pMapped[i] = static_cast<VTX_INSTANCE*>(pWH->mapBuffer(m_Buffers[i]))))
+    {
+      printWarning("failed to create instance buffer"sv, true);
+      destroyInstanceBuffer();
+      return false;
+    }
+  }
+  return true;
+}
+
+void vulkanInstanceBuffer::destroyInstanceBuffer()
+{
+  if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)
+  {
+    for (size_t i{ 0 }, t{ m_Buffers.size() }; i < t; ++i)
+    {
+      if (m_pMapped[i] != nullptr)pWH->unmapBuffer(m_Buffers[i]);
+      pWH->destroyBuffer(m_Buffers[i]);
+    }
+  }
+  m_Buffers.clear();
+  m_pMapped.clear();
+  m_MaxInstances = 0;
+}
+
+std::span<VTX_INSTANCE> vulkanInstanceBuffer::getInstances(uint32_t frameIndex)
+{
+  if (frameIndex >= m_pMapped.size())return {};
+  return std::span<VTX_INSTANCE>{ m_pMapped[frameIndex], m_MaxInstances };
+}
+
+void vulkanInstanceBuffer::bind(VkCommandBuffer FCB, uint32_t frameIndex) const
+{
+  vulkanCommandState::bindVertexBuffer(FCB, vulkanPipeline::s_InstanceBinding, m_Buffers[frameIndex].m_Buffer);
+}
+
+// *****************************************************************************
@@ -9,6 +9,20 @@
 
 #include <vulkanHelpers/vulkanModel.h>
 #include <handlers/windowHandler.h>
+#include <utility/indexTypes.hpp>
+#include <utility/OBJLoader.h>
+#include <utility/meshCache.h>
+#include <utility/meshOptimizer.h>
+#include <utility/vertexQuantizer.h>
+#include <utility/meshlets.h>
+#include <utility/meshSimplifier.h>
+#include <utility/bounds.h>
+#include <utility/threadPool.h>
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <cfloat>
+#include <array>
 
 #pragma warning (disable : 26451)
 #include <assimp/Importer.hpp>  // file IO
@@ -19,43 +33,111 @@
 // *****************************************************************************
 // ****************************************************** non-class helpers ****
 
+// matches the alternative order of MTU::indexVector
+static constexpr VkIndexType s_IndexTypes[]
+{
+  VK_INDEX_TYPE_UINT8_EXT,
+  VK_INDEX_TYPE_UINT16,
+  VK_INDEX_TYPE_UINT32
+};
 
-
-// *****************************************************************************
-// ******************************************************* Public functions ****
-
-void vulkanModel::drawVerts(VkCommandBuffer FCB)
+// output of the importer, ready to be uploaded or cached as is
+struct cooked3DUVModel
 {
-  VkDeviceSize offsets[]{ 0 };
-  vkCmdBindVertexBuffers(FCB, 0, 1, &m_Buffer_Vertex.m_Buffer, offsets);
-  vkCmdDraw(FCB, m_VertexCount, 1, 0, 0);
-}
+  std::vector<VTX_3D_UV_NML_TAN>      m_Vertices  {};
+  std::vector<VTX_3D_UV_NML_TAN_Q16>  m_QVertices {};// replaces m_Vertices if quantized
+  VTX_DEQUANT                         m_Dequant   {};
+  MTU::indexVector                    m_Indices   {};
+  std::vector<MTU::meshlet>           m_Meshlets  {};
+  std::vector<MTU::meshLOD>           m_LODs      {};// always has LOD 0 if there are indices
+};
 
-void vulkanModel::drawIndexed(VkCommandBuffer FCB)
+static constexpr unsigned int s_AssimpImportFlags
 {
-  VkDeviceSize offsets[]{ 0 };
-  vkCmdBindVertexBuffers(FCB, 0, 1, &m_Buffer_Vertex.m_Buffer, offsets);
-  vkCmdBindIndexBuffer(FCB, m_Buffer_Index.m_Buffer, 0, m_IndexType);
-  vkCmdDrawIndexed(FCB, m_IndexCount, 1, 0, 0, 0);
-}
+    aiProcess_Triangulate             // only support triangles
+  | aiProcess_GenUVCoords             // what is orcylindrical mapping?
+  | aiProcess_RemoveRedundantMaterials// claims to be useful w/ PreTransform
+  | aiProcess_JoinIdenticalVertices   // my OBJ parser had it too... cool
+  | aiProcess_PreTransformVertices    // force the right transform for skull
+  | aiProcess_CalcTangentSpace        // should always work after GenNormals
+  | aiProcess_GenNormals              // in case they don't exist
+  | aiProcess_FlipUVs                 // rather than flipping the textures
+};
 
-void vulkanModel::drawInit(VkCommandBuffer FCB)
+// anything done to the import that changes the cooked bytes, for cache keys
+static constexpr uint64_t s_CookFlag_Uint8Indices{ 0b0001 };
+static constexpr uint64_t s_CookFlag_Optimized    { 0b0010 };
+static constexpr uint64_t s_CookFlag_Quantized    { 0b0100 };
+static constexpr uint64_t s_CookFlag_LODs         { 0b1000 };
+
+static constexpr uint32_t s_MaxLODs{ 5 };
+static constexpr float    s_OccluderMaxError{ 0.01f };// of the bounding radius, a coarser LOD may poke out
+
+/// @brief reorders triangles and vertices for the post transform cache,
+///        overdraw and vertex fetch, printing the ACMR/ATVR gained
+static void optimize3DUVModel(std::string_view const& fPath, std::vector<VTX_3D_UV_NML_TAN>& vertices, std::vector<float>& tangentSigns, std::vector<uint32_t>& indices)
 {
-  m_pFnDraw = ((m_IndexType == VK_INDEX_TYPE_NONE_KHR || m_IndexType == VK_INDEX_TYPE_MAX_ENUM || m_IndexCount == 0) ? &vulkanModel::drawVerts : &vulkanModel::drawIndexed);
-  if (FCB != nullptr)(this->*m_pFnDraw)(FCB);
+  MTU::vertexCacheStats Before{ MTU::analyzeVertexCache(indices, vertices.size()) };
+
+  MTU::optimizeVertexCache(indices, vertices.size());
+  MTU::optimizeOverdraw(indices, &vertices.front().m_Pos.x, sizeof(VTX_3D_UV_NML_TAN), vertices.size());
+  std::vector<uint32_t> remap{ MTU::optimizeVertexFetch(indices, vertices.size()) };
+  MTU::remapVertices(vertices, remap);
+  if (false == tangentSigns.empty())MTU::remapVertices(tangentSigns, remap);
+
+  MTU::vertexCacheStats After{ MTU::analyzeVertexCache(indices, vertices.size()) };
+  printf_s
+  (
+    "%.*s | optimized %zu triangles, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+    static_cast<int>(fPath.size()), fPath.data(), indices.size() / 3,
+    Before.m_ACMR, After.m_ACMR, Before.m_ATVR, After.m_ATVR
+  );
 }
 
-void vulkanModel::draw(VkCommandBuffer FCB)
+/// @brief appends simplified copies of the LOD 0 triangles to indices, each
+///        about half of the one before, until s_MaxLODs or the simplifier
+///        can't get much further without breaking the shape
+static void generate3DUVModelLODs(std::string_view const& fPath, std::vector<VTX_3D_UV_NML_TAN> const& vertices, std::vector<uint32_t>& indices, bool bOptimize, std::vector<MTU::meshLOD>& outLODs)
 {
-  (this->*m_pFnDraw)(FCB);
+  MTU::simplifyVertexData VertexData
+  {
+    .m_pPositions     { &vertices.front().m_Pos.x },
+    .m_PositionStride { sizeof(VTX_3D_UV_NML_TAN) },
+    .m_pTexCoords     { &vertices.front().m_Tex.x },
+    .m_TexCoordStride { sizeof(VTX_3D_UV_NML_TAN) },
+    .m_VertexCount    { vertices.size() }
+  };
+
+  std::vector<uint32_t> prevIndices{ indices };
+  float totalError{ 0.0f };
+  while (outLODs.size() < s_MaxLODs)
+  {
+    float lodError{ 0.0f };
+    std::vector<uint32_t> lodIndices{ MTU::simplifyMesh(prevIndices, VertexData, prevIndices.size() / 2, FLT_MAX, lodError) };
+    if (lodIndices.empty() || lodIndices.size() * 4 > prevIndices.size() * 3)break;// not worth another LOD
+    if (bOptimize)MTU::optimizeVertexCache(lodIndices, vertices.size());
+
+    // each step measures from the one before, summing keeps it an upper bound
+    totalError += lodError;
+    outLODs.emplace_back(MTU::meshLOD{ .m_FirstIndex{ static_cast<uint32_t>(indices.size()) }, .m_IndexCount{ static_cast<uint32_t>(lodIndices.size()) }, .m_Error{ totalError } });
+    indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+    prevIndices = std::move(lodIndices);
+  }
+
+  for (size_t i{ 0 }, t{ outLODs.size() }; i < t; ++i)
+  {
+    printf_s
+    (
+      "%.*s | LOD %zu: %u triangles, error %g\n",
+      static_cast<int>(fPath.size()), fPath.data(), i, outLODs[i].m_IndexCount / 3, outLODs[i].m_Error
+    );
+  }
 }
 
-bool vulkanModel::load3DUVModel(std::string_view const& fPath)
+/// @brief runs assimp and builds the final vertices and indices
+/// @return false if the file can't be read or is missing any attribute
+static bool cook3DUVModel(std::string_view const& fPath, uint64_t cookFlags, cooked3DUVModel& outCooked)
 {
-  assert(m_Buffer_Vertex.m_Buffer == VK_NULL_HANDLE && m_Buffer_Index.m_Buffer == VK_NULL_HANDLE);
-  windowHandler* pWH{ windowHandler::getPInstance() };
-  assert(pWH != nullptr);// debug only, flow should be pretty standard.
-
 #define PATHWARNHELPER(x) printWarning(std::string{ fPath }.append(x), true)
 
   Assimp::Importer Importer;
@@ -64,21 +146,16 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
     Importer.ReadFile
     (
       fPath.data(),
-        aiProcess_Triangulate             // only support triangles
-      | aiProcess_GenUVCoords             // what is orcylindrical mapping?
-      | aiProcess_RemoveRedundantMaterials// claims to be useful w/ PreTransform
-      | aiProcess_JoinIdenticalVertices   // my OBJ parser had it too... cool
-      | aiProcess_PreTransformVertices    // force the right transform for skull
-      | aiProcess_CalcTangentSpace        // should always work after GenNormals
-      | aiProcess_GenNormals              // in case they don't exist
-      | aiProcess_FlipUVs                 // rather than flipping the textures
+      s_AssimpImportFlags
     )
   };
   
   if (pScene == nullptr || false == pScene->HasMeshes())return false;
 
-  std::vector<VTX_3D_UV_NML_TAN> vertices;
+  std::vector<VTX_3D_UV_NML_TAN>& vertices{ outCooked.m_Vertices };
   std::vector<uint32_t> indices;
+  std::vector<float> tangentSigns;// bitangent handedness, only kept for Q16
+  bool bQuantize{ (cookFlags & s_CookFlag_Quantized) != 0 };
 
   { // reserve all the space needed...
     size_t vSpace{ 0 }, iSpace{ 0 };
@@ -92,6 +169,7 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
     }
     vertices.reserve(vSpace);
     indices.reserve(iSpace);
+    if (bQuantize)tangentSigns.reserve(vSpace);
   }
 
   // end up being unnecessary, pretransformvertices was what I needed...
@@ -133,6 +211,12 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
         decltype(VTX_3D_UV_NML_TAN::m_Nml){ refNml.x, refNml.y, refNml.z },
         decltype(VTX_3D_UV_NML_TAN::m_Tan){ refTan.x, refTan.y, refTan.z }
       );
+
+      if (bQuantize)
+      {
+        aiVector3D Bitangent{ refNml ^ refTan };// the float shader assumes N x T
+        tangentSigns.emplace_back(Bitangent * refMesh.mBitangents[j] < 0.0f ? -1.0f : 1.0f);
+      }
     }
 
     // Set up Indices
@@ -149,13 +233,544 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
     }// else add by raw vertex?
   }
 
-  m_VertexCount = static_cast<uint32_t>(vertices.size());
-  m_IndexCount = static_cast<uint32_t>(indices.size());
+  if ((cookFlags & s_CookFlag_Optimized) && false == indices.empty())optimize3DUVModel(fPath, vertices, tangentSigns, indices);
+  if (false == indices.empty())
+  {
+    outCooked.m_LODs.emplace_back(MTU::meshLOD{ .m_IndexCount{ static_cast<uint32_t>(indices.size()) } });
+    if (cookFlags & s_CookFlag_LODs)generate3DUVModelLODs(fPath, vertices, indices, (cookFlags & s_CookFlag_Optimized) != 0, outCooked.m_LODs);
+
+    // meshlets never cross LODs so each LOD culls on its own
+    for (MTU::meshLOD& refLOD : outCooked.m_LODs)
+    {
+      std::vector<MTU::meshlet> lodMeshlets{ MTU::buildMeshlets(std::span<const uint32_t>{ indices }.subspan(refLOD.m_FirstIndex, refLOD.m_IndexCount), &vertices.front().m_Pos.x, sizeof(VTX_3D_UV_NML_TAN)) };
+      for (MTU::meshlet& x : lodMeshlets)x.m_FirstIndex += refLOD.m_FirstIndex;
+      refLOD.m_FirstMeshlet = static_cast<uint32_t>(outCooked.m_Meshlets.size());
+      refLOD.m_MeshletCount = static_cast<uint32_t>(lodMeshlets.size());
+      outCooked.m_Meshlets.insert(outCooked.m_Meshlets.end(), lodMeshlets.begin(), lodMeshlets.end());
+    }
+  }
+
+  if (bQuantize)
+  {
+    outCooked.m_QVertices.resize(vertices.size());
+    MTU::vertexQuantizeError Error{ MTU::quantizeVertices(vertices, tangentSigns, outCooked.m_QVertices, outCooked.m_Dequant) };
+    printf_s
+    (
+      "%.*s | quantized %zu vertices (%zu -> %zu bytes each), max error: pos %g (%.4f%% of bounds), uv %g, normal %.3f deg, tangent %.3f deg\n",
+      static_cast<int>(fPath.size()), fPath.data(), vertices.size(), sizeof(VTX_3D_UV_NML_TAN), sizeof(VTX_3D_UV_NML_TAN_Q16),
+      Error.m_MaxPos, Error.m_MaxPosRel * 100.0f, Error.m_MaxTex, Error.m_MaxNmlDeg, Error.m_MaxTanDeg
+    );
+  }
+
+  outCooked.m_Indices = MTU::narrowIndices(std::span<const uint32_t>{ indices }, vertices.size(), (cookFlags & s_CookFlag_Uint8Indices) != 0);
+  if (bQuantize)vertices = std::vector<VTX_3D_UV_NML_TAN>{};
+#undef PATHWARNHELPER
+  return true;
+}
+
+// final bytes of one model, mapped from the mesh cache or cooked in memory
+struct prepared3DUVModel
+{
+  MTU::cookedMesh             m_CachedMesh  {};
+  cooked3DUVModel             m_Cooked      {};
+  std::span<const std::byte>  m_VertexBytes {};// into one of the two above
+  std::span<const std::byte>  m_IndexBytes  {};
+  uint32_t                    m_VertexCount { 0 };
+  uint32_t                    m_VertexStride{ 0 };
+  uint32_t                    m_IndexCount  { 0 };
+  uint32_t                    m_IndexSize   { 0 };
+  VTX_DEQUANT                 m_Dequant     {};
+  std::vector<MTU::meshlet>   m_Meshlets    {};// copied, the mapped bytes may be unaligned
+  std::vector<MTU::meshLOD>   m_LODs        {};// copied too
+};
+
+/// @brief everything before the GPU upload, no vulkan calls so it can run on
+///        any thread. Reads the cooked mesh cache or cooks and writes it.
+static bool prepare3DUVModel(std::string_view const& fPath, vulkanModel::loadSettings const& Settings, bool bAllowUint8, prepared3DUVModel& outPrepared)
+{
+  uint64_t cookFlags{ 0 };
+  if (bAllowUint8)cookFlags |= s_CookFlag_Uint8Indices;
+  if (Settings.m_bOptimizeMesh)cookFlags |= s_CookFlag_Optimized;
+  if (Settings.m_bQuantize)cookFlags |= s_CookFlag_Quantized;
+  if (Settings.m_bGenerateLODs)cookFlags |= s_CookFlag_LODs;
+  uint32_t vertexStride{ static_cast<uint32_t>(Settings.m_bQuantize ? sizeof(VTX_3D_UV_NML_TAN_Q16) : sizeof(VTX_3D_UV_NML_TAN)) };
+  MTU::meshCacheKey cacheKey
+  {
+    .m_SourcePath   { fPath },
+    .m_ImportFlags  { s_AssimpImportFlags },
+    .m_CookFlags    { cookFlags },
+    .m_VertexStride { vertexStride }
+  };
+  outPrepared.m_VertexStride = vertexStride;
+
+  // cooked before, the mapped bytes go straight to staging
+  if
+  (
+    outPrepared.m_CachedMesh.open(cacheKey) &&
+    outPrepared.m_CachedMesh.getHeader().m_MeshletStride == sizeof(MTU::meshlet) &&
+    outPrepared.m_CachedMesh.getHeader().m_LODStride == sizeof(MTU::meshLOD)
+  )
+  {
+    MTU::meshCacheHeader const& Header{ outPrepared.m_CachedMesh.getHeader() };
+    outPrepared.m_Meshlets.resize(Header.m_MeshletCount);
+    std::memcpy(outPrepared.m_Meshlets.data(), outPrepared.m_CachedMesh.getMeshletBytes().data(), outPrepared.m_Meshlets.size() * sizeof(MTU::meshlet));
+    outPrepared.m_LODs.resize(Header.m_LODCount);
+    std::memcpy(outPrepared.m_LODs.data(), outPrepared.m_CachedMesh.getLODBytes().data(), outPrepared.m_LODs.size() * sizeof(MTU::meshLOD));
+    outPrepared.m_VertexBytes = outPrepared.m_CachedMesh.getVertexBytes();
+    outPrepared.m_IndexBytes  = outPrepared.m_CachedMesh.getIndexBytes();
+    outPrepared.m_VertexCount = Header.m_VertexCount;
+    outPrepared.m_IndexCount  = Header.m_IndexCount;
+    outPrepared.m_IndexSize   = Header.m_IndexSize;
+    outPrepared.m_Dequant     = Header.m_Dequant;
+    return outPrepared.m_VertexCount != 0;
+  }
+
+  cooked3DUVModel& Cooked{ outPrepared.m_Cooked };
+  if (false == cook3DUVModel(fPath, cookFlags, Cooked))return false;
+
+  outPrepared.m_VertexBytes = Settings.m_bQuantize ? std::as_bytes(std::span{ Cooked.m_QVertices }) : std::as_bytes(std::span{ Cooked.m_Vertices });
+  outPrepared.m_IndexBytes  = std::span<const std::byte>{ static_cast<const std::byte*>(MTU::indexData(Cooked.m_Indices)), MTU::indexCount(Cooked.m_Indices) * MTU::indexSize(Cooked.m_Indices) };
+  outPrepared.m_VertexCount = static_cast<uint32_t>(outPrepared.m_VertexBytes.size() / vertexStride);
+  outPrepared.m_IndexCount  = static_cast<uint32_t>(MTU::indexCount(Cooked.m_Indices));
+  outPrepared.m_IndexSize   = static_cast<uint32_t>(MTU::indexSize(Cooked.m_Indices));
+  outPrepared.m_Dequant     = Cooked.m_Dequant;
+  outPrepared.m_Meshlets    = Cooked.m_Meshlets;
+  outPrepared.m_LODs        = Cooked.m_LODs;
+
+  MTU::meshCacheHeader Header
+  {
+    .m_VertexCount  { outPrepared.m_VertexCount },
+    .m_VertexStride { vertexStride },
+    .m_IndexCount   { outPrepared.m_IndexCount },
+    .m_IndexSize    { outPrepared.m_IndexSize },
+    .m_MeshletCount { static_cast<uint32_t>(Cooked.m_Meshlets.size()) },
+    .m_MeshletStride{ sizeof(MTU::meshlet) },
+    .m_LODCount     { static_cast<uint32_t>(Cooked.m_LODs.size()) },
+    .m_LODStride    { sizeof(MTU::meshLOD) },
+    .m_Dequant      { Cooked.m_Dequant }
+  };
+  if (false == MTU::writeMeshCache(cacheKey, Header, outPrepared.m_VertexBytes, outPrepared.m_IndexBytes, std::as_bytes(std::span{ Cooked.m_Meshlets }), std::as_bytes(std::span{ Cooked.m_LODs })))
+  {
+    printWarning(std::string{ fPath }.append(" | failed to write mesh cache"sv));
+  }
+  return outPrepared.m_VertexCount != 0;
+}
+
+static glm::vec3 readPreparedPosition(prepared3DUVModel const& Prepared, uint32_t vertexIndex)
+{
+  const std::byte* pVertex{ Prepared.m_VertexBytes.data() + static_cast<size_t>(vertexIndex) * Prepared.m_VertexStride };
+  if (Prepared.m_VertexStride == sizeof(VTX_3D_UV_NML_TAN_Q16))
+  {
+    VTX_3D_UV_NML_TAN_Q16 vtx;
+    std::memcpy(&vtx, pVertex, sizeof(vtx));
+    return MTU::dequantizeVertex(vtx, Prepared.m_Dequant).m_Pos;
+  }
+  glm::vec3 retval;
+  std::memcpy(&retval, pVertex, sizeof(retval));
+  return retval;
+}
+
+/// @brief the coarsest LOD within s_OccluderMaxError, with only the
+///        vertices it uses, for MTU::occlusionBuffer
+static MTU::occluderMesh make3DUVOccluder(prepared3DUVModel const& Prepared, float radius)
+{
+  MTU::occluderMesh retval;
+  if (Prepared.m_IndexCount == 0)return retval;
+  MTU::meshLOD LOD{ .m_FirstIndex{ 0 }, .m_IndexCount{ Prepared.m_IndexCount } };
+  for (MTU::meshLOD const& x : Prepared.m_LODs)
+  {
+    if (x.m_IndexCount && x.m_Error <= s_OccluderMaxError * radius)LOD = x;
+  }
+
+  std::vector<uint32_t> remap(Prepared.m_VertexCount, UINT32_MAX);
+  retval.m_Indices.resize(LOD.m_IndexCount);
+  MTU::copyIndices(retval.m_Indices.data(), sizeof(uint32_t), Prepared.m_IndexBytes.data() + static_cast<size_t>(LOD.m_FirstIndex) * Prepared.m_IndexSize, Prepared.m_IndexSize, LOD.m_IndexCount);
+  for (uint32_t& x : retval.m_Indices)
+  {
+    if (remap[x] == UINT32_MAX)
+    {
+      remap[x] = static_cast<uint32_t>(retval.m_Positions.size());
+      retval.m_Positions.emplace_back(readPreparedPosition(Prepared, x));
+    }
+    x = remap[x];
+  }
+  return retval;
+}
+
+/// @brief hands the CPU side data of a prepared model to the model, the
+///        bounds wrap every vertex (all LODs share them)
+static void apply3DUVModel(vulkanModel& refModel, prepared3DUVModel const& Prepared, vulkanModel::loadSettings const& Settings)
+{
+  refModel.m_Dequant = Prepared.m_Dequant;
+  refModel.m_MeshletCuller.setMeshlets(Prepared.m_Meshlets);
+  refModel.m_LODs = Prepared.m_LODs;
+  refModel.m_CurrentLOD = 0;
+
+  MTU::bounds Bounds{};
+  if (Prepared.m_VertexStride == sizeof(VTX_3D_UV_NML_TAN))
+  {
+    Bounds = MTU::computeBounds(reinterpret_cast<const float*>(Prepared.m_VertexBytes.data()), Prepared.m_VertexStride, Prepared.m_VertexCount);
+  }
+  else if (Prepared.m_VertexStride == sizeof(VTX_3D_UV_NML_TAN_Q16))
+  {
+    // decoded the way the vertex shader does, only for the bounds
+    std::vector<glm::vec3> positions(Prepared.m_VertexCount);
+    for (uint32_t i{ 0 }; i < Prepared.m_VertexCount; ++i)positions[i] = readPreparedPosition(Prepared, i);
+    Bounds = MTU::computeBounds(&positions.data()->x, sizeof(glm::vec3), positions.size());
+  }
+  refModel.m_AABB = Bounds.m_Box;
+  refModel.m_BoundingSphere = Bounds.m_Sphere;
+  refModel.m_Occluder = Settings.m_bOccluder ? make3DUVOccluder(Prepared, Bounds.m_Sphere.w) : MTU::occluderMesh{};
+}
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+void vulkanModel::drawVerts(VkCommandBuffer FCB)
+{
+  bindMeshBuffers(FCB);
+  vkCmdDraw(FCB, m_VertexCount, 1, m_VertexOffset, 0);
+}
+
+void vulkanModel::drawIndexed(VkCommandBuffer FCB)
+{
+  bindMeshBuffers(FCB);
+  if (m_LODs.empty())vkCmdDrawIndexed(FCB, m_IndexCount, 1, m_FirstIndex, static_cast<int32_t>(m_VertexOffset), 0);
+  else vkCmdDrawIndexed(FCB, m_LODs[m_CurrentLOD].m_IndexCount, 1, m_FirstIndex + m_LODs[m_CurrentLOD].m_FirstIndex, static_cast<int32_t>(m_VertexOffset), 0);
+}
+
+void vulkanModel::drawInstanced(VkCommandBuffer FCB, uint32_t instanceCount, uint32_t firstInstance)
+{
+  if (instanceCount == 0)return;
+  bindMeshBuffers(FCB);
+  if (m_IndexCount == 0)vkCmdDraw(FCB, m_VertexCount, instanceCount, m_VertexOffset, firstInstance);
+  else if (m_LODs.empty())vkCmdDrawIndexed(FCB, m_IndexCount, instanceCount, m_FirstIndex, static_cast<int32_t>(m_VertexOffset), firstInstance);
+  else vkCmdDrawIndexed(FCB, m_LODs[m_CurrentLOD].m_IndexCount, instanceCount, m_FirstIndex + m_LODs[m_CurrentLOD].m_FirstIndex, static_cast<int32_t>(m_VertexOffset), firstInstance);
+}
+
+void vulkanModel::drawCulled(VkCommandBuffer FCB, glm::mat4 const& M2Clip, glm::vec3 const& localCamPos)
+{
+  if (m_MeshletCuller.empty() || m_LODs.empty() || m_IndexCount == 0)
+  {
+    m_LastDrawnIndexCount = m_LODs.empty() ? (m_IndexCount ? m_IndexCount : m_VertexCount) : m_LODs[m_CurrentLOD].m_IndexCount;
+    draw(FCB);
+    return;
+  }
+
+  MTU::meshLOD const& refLOD{ m_LODs[m_CurrentLOD] };
+  m_VisibleRanges.clear();
+  m_LastDrawnIndexCount = m_MeshletCuller.cull(MTU::extractFrustum(M2Clip), localCamPos, m_VisibleRanges, refLOD.m_FirstMeshlet, refLOD.m_MeshletCount);
+  if (m_VisibleRanges.empty())return;
+
+  bindMeshBuffers(FCB);
+  for (MTU::indexRange const& x : m_VisibleRanges)vkCmdDrawIndexed(FCB, x.m_IndexCount, 1, m_FirstIndex + x.m_FirstIndex, static_cast<int32_t>(m_VertexOffset), 0);
+}
+
+bool vulkanModel::appendCulled(vulkanIndirectBuffer& Indirect, glm::mat4 const& M2Clip, glm::vec3 const& localCamPos, uint32_t firstInstance)
+{
+  assert(m_IndexCount != 0);
+  MTU::meshLOD LOD{ m_LODs.empty() ? MTU::meshLOD{ .m_FirstIndex{ 0 }, .m_IndexCount{ m_IndexCount } } : m_LODs[m_CurrentLOD] };
+  m_VisibleRanges.clear();
+  if (m_MeshletCuller.empty() || m_LODs.empty())
+  {
+    m_VisibleRanges.emplace_back(MTU::indexRange{ .m_FirstIndex{ LOD.m_FirstIndex }, .m_IndexCount{ LOD.m_IndexCount } });
+    m_LastDrawnIndexCount = LOD.m_IndexCount;
+  }
+  else m_LastDrawnIndexCount = m_MeshletCuller.cull(MTU::extractFrustum(M2Clip), localCamPos, m_VisibleRanges, LOD.m_FirstMeshlet, LOD.m_MeshletCount);
+
+  for (MTU::indexRange const& x : m_VisibleRanges)
+  {
+    if (false == Indirect.append(VkDrawIndexedIndirectCommand{ x.m_IndexCount, 1, m_FirstIndex + x.m_FirstIndex, static_cast<int32_t>(m_VertexOffset), firstInstance }))return false;
+  }
+  return true;
+}
+
+uint32_t vulkanModel::getMaxCulledCommands() const noexcept
+{
+  // a run holds at least one meshlet
+  uint32_t maxCommands{ 1 };
+  if (false == m_MeshletCuller.empty())for (MTU::meshLOD const& x : m_LODs)maxCommands = std::max(maxCommands, x.m_MeshletCount);
+  return maxCommands;
+}
+
+bool vulkanModel::appendInstanced(vulkanIndirectBuffer& Indirect, uint32_t instanceCount, uint32_t firstInstance)
+{
+  assert(m_IndexCount != 0);
+  if (instanceCount == 0)return true;
+  MTU::meshLOD LOD{ m_LODs.empty() ? MTU::meshLOD{ .m_FirstIndex{ 0 }, .m_IndexCount{ m_IndexCount } } : m_LODs[m_CurrentLOD] };
+  return Indirect.append(VkDrawIndexedIndirectCommand{ LOD.m_IndexCount, instanceCount, m_FirstIndex + LOD.m_FirstIndex, static_cast<int32_t>(m_VertexOffset), firstInstance });
+}
+
+MTU::cullObject vulkanModel::getCullObject(glm::mat4 const& M2W, uint32_t LOD, uint32_t instanceID) const
+{
+  assert(m_IndexCount != 0);
+  MTU::meshLOD range{ m_LODs.empty() ? MTU::meshLOD{ .m_FirstIndex{ 0 }, .m_IndexCount{ m_IndexCount } } : m_LODs[std::min(LOD, static_cast<uint32_t>(m_LODs.size() - 1))] };
+  return MTU::cullObject
+  {
+    .m_M2W            { M2W },
+    .m_BoundingSphere { m_BoundingSphere },
+    .m_FirstIndex     { m_FirstIndex + range.m_FirstIndex },
+    .m_IndexCount     { range.m_IndexCount },
+    .m_VertexOffset   { static_cast<int32_t>(m_VertexOffset) },
+    .m_InstanceID     { instanceID }
+  };
+}
+
+uint32_t vulkanModel::selectLOD(glm::mat4 const& M2Clip, float viewportHeight, float pixelError)
+{
+  m_CurrentLOD = 0;
+  if (m_LODs.size() < 2)return m_CurrentLOD;
+
+  // clip y and w rows (glm is column major), w is the view depth
+  glm::vec3 rowY{ M2Clip[0][1], M2Clip[1][1], M2Clip[2][1] };
+  glm::vec3 rowW{ M2Clip[0][3], M2Clip[1][3], M2Clip[2][3] };
+  float nearestW{ glm::dot(rowW, glm::vec3{ m_BoundingSphere }) + M2Clip[3][3] - m_BoundingSphere.w * glm::length(rowW) };
+  if (nearestW <= 0.0f)return m_CurrentLOD;// camera inside the bounds
+
+  // pixels covered by one model unit at the nearest point, NDC y spans 2
+  float pixelsPerUnit{ glm::length(rowY) / nearestW * viewportHeight * 0.5f };
+  for (uint32_t i{ 1 }, t{ static_cast<uint32_t>(m_LODs.size()) }; i < t; ++i)
+  {
+    if (m_LODs[i].m_Error * pixelsPerUnit > pixelError)break;
+    m_CurrentLOD = i;
+  }
+  return m_CurrentLOD;
+}
+
+void vulkanModel::drawInit(VkCommandBuffer FCB)
+{
+  m_pFnDraw = ((m_IndexType == VK_INDEX_TYPE_NONE_KHR || m_IndexType == VK_INDEX_TYPE_MAX_ENUM || m_IndexCount == 0) ? &vulkanModel::drawVerts : &vulkanModel::drawIndexed);
+  if (FCB != nullptr)(this->*m_pFnDraw)(FCB);
+}
+
+void vulkanModel::draw(VkCommandBuffer FCB)
+{
+  (this->*m_pFnDraw)(FCB);
+}
+
+bool vulkanModel::load3DUVModel(std::string_view const& fPath, loadSettings const& Settings)
+{
+  assert(m_Buffer_Vertex.m_Buffer == VK_NULL_HANDLE && m_Buffer_Index.m_Buffer == VK_NULL_HANDLE);
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+
+  // arena uploads (index widening, offsets) only live in the batch path
+  if (Settings.m_pArena != nullptr)return loadModels(std::array{ loadRequest{ this, fPath, Settings } }, 1);
+
+  // my own parser can skip the copies assimp needs, unless there's more to do
+  // (the occluder is built from the prepared model)
+  bool bPostProcess{ Settings.m_bOptimizeMesh || Settings.m_bQuantize || Settings.m_bGenerateLODs || Settings.m_bOccluder };
+  if (false == bPostProcess && std::filesystem::path{ fPath }.extension() == ".obj")return loadStreamedOBJ(fPath);
 
-  // in case I ever want to change or copy it somewhere
-  if constexpr (std::is_same_v<decltype(indices)::value_type, uint8_t>)m_IndexType = VK_INDEX_TYPE_UINT8_EXT;
-  if constexpr (std::is_same_v<decltype(indices)::value_type, uint16_t>)m_IndexType = VK_INDEX_TYPE_UINT16;
-  if constexpr (std::is_same_v<decltype(indices)::value_type, uint32_t>)m_IndexType = VK_INDEX_TYPE_UINT32;
+  prepared3DUVModel Prepared;
+  if (false == prepare3DUVModel(fPath, Settings, pWH->isIndexTypeUint8Supported(), Prepared))return false;
+
+  apply3DUVModel(*this, Prepared, Settings);
+  return uploadMesh(Prepared.m_VertexBytes, Prepared.m_VertexCount, Prepared.m_IndexBytes, Prepared.m_IndexCount, Prepared.m_IndexSize);
+}
+
+bool vulkanModel::loadModels(std::span<const loadRequest> Requests, size_t numThreads)
+{
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (Requests.empty())return true;
+
+  // CPU side, each import/cook only waits on the slowest one
+  std::vector<prepared3DUVModel> Prepared(Requests.size());
+  {
+    bool bAllowUint8{ pWH->isIndexTypeUint8Supported() };
+    MTU::threadPool Pool{ std::min(numThreads ? numThreads : std::max(std::thread::hardware_concurrency(), 1u), Requests.size()) };
+    std::vector<std::future<bool>> Results;
+    Results.reserve(Requests.size());
+    for (size_t i{ 0 }, t{ Requests.size() }; i < t; ++i)
+    {
+      Results.emplace_back(Pool.submit([&Requests, &Prepared, bAllowUint8, i]() { return prepare3DUVModel(Requests[i].m_Path, Requests[i].m_Settings, bAllowUint8, Prepared[i]); }));
+    }
+
+    bool bAllPrepared{ true };
+    for (size_t i{ 0 }, t{ Results.size() }; i < t; ++i)
+    {
+      if (false == Results[i].get())
+      {
+        printWarning(std::string{ Requests[i].m_Path }.append(" | failed to import"sv), true);
+        bAllPrepared = false;
+      }
+    }
+    if (false == bAllPrepared)return false;
+  }
+
+  // GPU side, one staging buffer and one submit for every model
+  // arena models are staged with the arena's index size
+  auto getStagedIndexSize
+  {
+    [&Requests, &Prepared](size_t i)->uint32_t
+    {
+      return Requests[i].m_Settings.m_pArena ? Requests[i].m_Settings.m_pArena->getIndexSize() : Prepared[i].m_IndexSize;
+    }
+  };
+  VkDeviceSize stagingSize{ 0 };
+  for (size_t i{ 0 }, t{ Prepared.size() }; i < t; ++i)
+  {
+    stagingSize += Prepared[i].m_VertexBytes.size() + static_cast<VkDeviceSize>(Prepared[i].m_IndexCount) * getStagedIndexSize(i);
+  }
+
+  vulkanBuffer stagingBuffer;
+  if (false == pWH->createStagingBuffer(stagingBuffer, stagingSize))
+  {
+    printWarning("failed to create staging buffer"sv, true);
+    return false;
+  }
+  std::byte* pMapped{ static_cast<std::byte*>(pWH->mapBuffer(stagingBuffer)) };
+  if (pMapped == nullptr)
+  {
+    pWH->destroyBuffer(stagingBuffer);
+    return false;
+  }
+
+  std::vector<windowHandler::bufferCopy> Copies;
+  Copies.reserve(Requests.size() * 2);
+  VkDeviceSize stagingOffset{ 0 };
+  bool bAllCreated{ true };
+  for (size_t i{ 0 }, t{ Requests.size() }; i < t && bAllCreated; ++i)
+  {
+    vulkanModel& refModel{ *Requests[i].m_pModel };
+    prepared3DUVModel const& refPrepared{ Prepared[i] };
+    assert(refModel.m_Buffer_Vertex.m_Buffer == VK_NULL_HANDLE && refModel.m_Buffer_Index.m_Buffer == VK_NULL_HANDLE);
+
+    if (false == refModel.createMeshBuffers(refPrepared.m_VertexCount, refPrepared.m_VertexStride, refPrepared.m_IndexCount, refPrepared.m_IndexSize, Requests[i].m_Settings.m_pArena))
+    {
+      bAllCreated = false;
+      break;
+    }
+    apply3DUVModel(refModel, refPrepared, Requests[i].m_Settings);
+
+    vulkanGeometryArena* pArena{ refModel.m_pArena };
+    std::memcpy(pMapped + stagingOffset, refPrepared.m_VertexBytes.data(), refPrepared.m_VertexBytes.size());
+    Copies.emplace_back
+    (
+      windowHandler::bufferCopy
+      {
+        .m_pDstBuffer { pArena ? &pArena->m_Buffer_Vertex : &refModel.m_Buffer_Vertex },
+        .m_Size       { refPrepared.m_VertexBytes.size() },
+        .m_SrcOffset  { stagingOffset },
+        .m_DstOffset  { static_cast<VkDeviceSize>(refModel.m_VertexOffset) * refPrepared.m_VertexStride }
+      }
+    );
+    stagingOffset += refPrepared.m_VertexBytes.size();
+
+    uint32_t stagedIndexSize{ getStagedIndexSize(i) };
+    VkDeviceSize stagedIndexBytes{ static_cast<VkDeviceSize>(refPrepared.m_IndexCount) * stagedIndexSize };
+    if (refModel.m_IndexCount)
+    {
+      MTU::copyIndices(pMapped + stagingOffset, stagedIndexSize, refPrepared.m_IndexBytes.data(), refPrepared.m_IndexSize, refPrepared.m_IndexCount);
+      Copies.emplace_back
+      (
+        windowHandler::bufferCopy
+        {
+          .m_pDstBuffer { pArena ? &pArena->m_Buffer_Index : &refModel.m_Buffer_Index },
+          .m_Size       { stagedIndexBytes },
+          .m_SrcOffset  { stagingOffset },
+          .m_DstOffset  { static_cast<VkDeviceSize>(refModel.m_FirstIndex) * stagedIndexSize }
+        }
+      );
+    }
+    stagingOffset += stagedIndexBytes;
+  }
+  pWH->unmapBuffer(stagingBuffer);
+
+  if (false == bAllCreated || false == pWH->copyBuffers(stagingBuffer, Copies))
+  {
+    for (loadRequest const& x : Requests)x.m_pModel->destroyModel();
+    pWH->destroyBuffer(stagingBuffer);
+    return false;
+  }
+  pWH->destroyBuffer(stagingBuffer);
+  return true;
+}
+
+bool vulkanModel::uploadMesh(std::span<const std::byte> vertexBytes, uint32_t vertexCount, std::span<const std::byte> indexBytes, uint32_t indexCount, uint32_t indexSize)
+{
+  assert(m_Buffer_Vertex.m_Buffer == VK_NULL_HANDLE && m_Buffer_Index.m_Buffer == VK_NULL_HANDLE);
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (vertexCount == 0 || vertexBytes.empty())return false;
+
+  // one staging buffer for both, vertices first then indices
+  vulkanBuffer stagingBuffer;
+  if (false == pWH->createStagingBuffer(stagingBuffer, vertexBytes.size() + indexBytes.size()))
+  {
+    printWarning("failed to create staging buffer"sv, true);
+    return false;
+  }
+  if (void* pMapped{ pWH->mapBuffer(stagingBuffer) }; pMapped != nullptr)
+  {
+    std::memcpy(pMapped, vertexBytes.data(), vertexBytes.size());
+    if (false == indexBytes.empty())std::memcpy(static_cast<std::byte*>(pMapped) + vertexBytes.size(), indexBytes.data(), indexBytes.size());
+    pWH->unmapBuffer(stagingBuffer);
+  }
+  else
+  {
+    pWH->destroyBuffer(stagingBuffer);
+    return false;
+  }
+
+  if (false == createMeshBuffers(vertexCount, static_cast<uint32_t>(vertexBytes.size() / vertexCount), indexCount, indexSize))
+  {
+    pWH->destroyBuffer(stagingBuffer);
+    return false;
+  }
+
+  bool bCopied{ pWH->copyBuffer(m_Buffer_Vertex, stagingBuffer, vertexBytes.size()) };
+  if (bCopied && m_IndexCount)bCopied = pWH->copyBuffer(m_Buffer_Index, stagingBuffer, indexBytes.size(), vertexBytes.size());
+
+  pWH->destroyBuffer(stagingBuffer);
+  if (false == bCopied)
+  {
+    printWarning("failed to upload model buffers"sv, true);
+    destroyModel();
+  }
+  return bCopied;
+}
+
+bool vulkanModel::createMeshBuffers(uint32_t vertexCount, uint32_t vertexStride, uint32_t indexCount, uint32_t indexSize, vulkanGeometryArena* pArena)
+{
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+  if (vertexCount == 0)return false;
+
+  if (pArena != nullptr)
+  {
+    if (vertexStride != pArena->m_VertexStride)
+    {
+      printWarning("model vertex layout doesn't match the geometry arena"sv, true);
+      return false;
+    }
+    if (indexSize > pArena->getIndexSize())
+    {
+      printWarning("model has too many vertices for the geometry arena's index type"sv, true);
+      return false;
+    }
+    if (false == pArena->allocate(vertexCount, indexCount, m_VertexOffset, m_FirstIndex))
+    {
+      printWarning("geometry arena is full"sv, true);
+      return false;
+    }
+    m_pArena = pArena;
+    m_VertexCount = vertexCount;
+    m_IndexCount = indexCount;
+    m_IndexType = indexCount ? pArena->m_IndexType : VK_INDEX_TYPE_NONE_KHR;
+    return true;
+  }
+
+  m_VertexCount = vertexCount;
+  m_IndexCount = indexCount;
+  switch (indexSize)
+  {
+  case sizeof(uint8_t):  m_IndexType = VK_INDEX_TYPE_UINT8_EXT; break;
+  case sizeof(uint16_t): m_IndexType = VK_INDEX_TYPE_UINT16;    break;
+  case sizeof(uint32_t): m_IndexType = VK_INDEX_TYPE_UINT32;    break;
+  default:               m_IndexType = VK_INDEX_TYPE_NONE_KHR;  m_IndexCount = 0; break;
+  }
 
   // Set up vertex buffer
   if (false == pWH->createBuffer
@@ -165,7 +780,7 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
       .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Vertex },
       .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Vertex },
       .m_Count      { m_VertexCount },
-      .m_ElemSize   { sizeof(decltype(vertices)::value_type) }
+      .m_ElemSize   { vertexStride }
     }
   ))
   {
@@ -173,18 +788,6 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
     return false;
   }
 
-  // write vertex buffer
-  pWH->writeToBuffer
-  (
-    m_Buffer_Vertex,
-    {
-      vertices.data()
-    },
-    {
-      static_cast<VkDeviceSize>(vertices.size()) * sizeof(decltype(vertices)::value_type)
-    }
-  );
-
   // Set up index buffer
   if (m_IndexCount)
   {
@@ -195,46 +798,163 @@ bool vulkanModel::load3DUVModel(std::string_view const& fPath)
         .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Index },
         .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Index },
         .m_Count      { m_IndexCount },
-        .m_ElemSize   { sizeof(decltype(indices)::value_type) }
+        .m_ElemSize   { indexSize }
       }
     ))
     {
       printWarning("failed to create model index buffer"sv, true);
+      destroyModel();
       return false;
     }
+  }
+  else
+  {
+    m_Buffer_Index = vulkanBuffer{  };
+  }
+  return true;
+}
 
-    // write index buffer
-    pWH->writeToBuffer
-    (
-      m_Buffer_Index,
+bool vulkanModel::loadStreamedOBJ(std::string_view const& fPath)
+{
+  assert(m_Buffer_Vertex.m_Buffer == VK_NULL_HANDLE && m_Buffer_Index.m_Buffer == VK_NULL_HANDLE);
+  windowHandler* pWH{ windowHandler::getPInstance() };
+  assert(pWH != nullptr);// debug only, flow should be pretty standard.
+
+#define PATHWARNHELPER(x) printWarning(std::string{ fPath }.append(x), true)
+
+  vulkanBuffer stagingVertex, stagingIndex;
+  void* pMappedVertex{ nullptr };
+  void* pMappedIndex{ nullptr };
+  auto cleanupStaging
+  {
+    [&]()
+    {
+      if (pMappedVertex != nullptr)pWH->unmapBuffer(stagingVertex);
+      if (pMappedIndex != nullptr)pWH->unmapBuffer(stagingIndex);
+      pWH->destroyBuffer(stagingVertex);
+      pWH->destroyBuffer(stagingIndex);
+    }
+  };
+
+  // staging sized from the counting pass, the parser writes straight into it
+  MTU::OBJStreamTarget Target
+  {
+    .m_fnGetIndexMemory
+    {
+      [&](size_t maxIndices)->uint32_t*
       {
-        indices.data()
-      },
+        if (maxIndices == 0 || false == pWH->createStagingBuffer(stagingIndex, maxIndices * sizeof(uint32_t)))return nullptr;
+        return static_cast<uint32_t*>(pMappedIndex = pWH->mapBuffer(stagingIndex));
+      }
+    },
+    .m_fnGetVertexMemory
+    {
+      [&](size_t vertexCount)->VTX_3D_UV_NML_TAN*
       {
-        static_cast<VkDeviceSize>(indices.size()) * sizeof(decltype(indices)::value_type)
+        if (vertexCount == 0 || false == pWH->createStagingBuffer(stagingVertex, vertexCount * sizeof(VTX_3D_UV_NML_TAN)))return nullptr;
+        return static_cast<VTX_3D_UV_NML_TAN*>(pMappedVertex = pWH->mapBuffer(stagingVertex));
       }
-    );
+    }
+  };
+
+  MTU::OBJStreamCounts Counts;
+  if (false == MTU::streamOBJ(fPath, Target, Counts, { .m_bLoadNormals{ true }, .m_NumThreads{ 0 } }) || Counts.m_IndexCount == 0)
+  {
+    PATHWARNHELPER(" | failed to stream OBJ"sv);
+    cleanupStaging();
+    return false;
   }
-  else
+
+  m_VertexCount = static_cast<uint32_t>(Counts.m_VertexCount);
+  m_IndexCount = static_cast<uint32_t>(Counts.m_IndexCount);
+
+  // narrow inside the staging memory instead of making another copy
+  size_t indexTypeIdx{ MTU::narrowIndicesInPlace(pMappedIndex, Counts.m_IndexCount, Counts.m_VertexCount, pWH->isIndexTypeUint8Supported()) };
+  uint32_t indexSize{ 1u << indexTypeIdx };
+  m_IndexType = s_IndexTypes[indexTypeIdx];
+
+  // bounds read the staging vertices before they go to the device
+  MTU::bounds Bounds{ MTU::computeBounds(static_cast<const float*>(pMappedVertex), sizeof(VTX_3D_UV_NML_TAN), Counts.m_VertexCount) };
+  m_AABB = Bounds.m_Box;
+  m_BoundingSphere = Bounds.m_Sphere;
+  m_Occluder = MTU::occluderMesh{};
+
+  pWH->unmapBuffer(stagingVertex);
+  pWH->unmapBuffer(stagingIndex);
+  pMappedVertex = pMappedIndex = nullptr;
+
+  if (false == pWH->createBuffer
+  (
+    m_Buffer_Vertex,
+    {
+      .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Vertex },
+      .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Vertex },
+      .m_Count      { m_VertexCount },
+      .m_ElemSize   { sizeof(VTX_3D_UV_NML_TAN) }
+    }
+  ) || false == pWH->createBuffer
+  (
+    m_Buffer_Index,
+    {
+      .m_BufferUsage{ vulkanBuffer::s_BufferUsage_Index },
+      .m_MemPropFlag{ vulkanBuffer::s_MemPropFlag_Index },
+      .m_Count      { m_IndexCount },
+      .m_ElemSize   { indexSize }
+    }
+  ))
   {
-    m_Buffer_Index = vulkanBuffer{  };
+    printWarning("failed to create model buffers"sv, true);
+    cleanupStaging();
+    destroyModel();
+    return false;
+  }
+
+  bool bCopied
+  {
+    pWH->copyBuffer(m_Buffer_Vertex, stagingVertex, static_cast<VkDeviceSize>(m_VertexCount) * sizeof(VTX_3D_UV_NML_TAN)) &&
+    pWH->copyBuffer(m_Buffer_Index, stagingIndex, static_cast<VkDeviceSize>(m_IndexCount) * indexSize)
+  };
+  cleanupStaging();
+  if (false == bCopied)
+  {
+    PATHWARNHELPER(" | failed to upload model buffers"sv);
+    destroyModel();
   }
 #undef PATHWARNHELPER
-  return true;
+  return bCopied;
 }
 
 void vulkanModel::destroyModel()
 {
-  if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)
+  if (m_pArena != nullptr)
+  {
+    m_pArena->free(m_VertexOffset, m_VertexCount, m_FirstIndex, m_IndexCount);
+    m_pArena = nullptr;
+    m_VertexOffset = m_FirstIndex = 0;
+  }
+  else if (windowHandler* pWH{ windowHandler::getPInstance() }; pWH != nullptr)
   {
     pWH->destroyBuffer(m_Buffer_Vertex);
     pWH->destroyBuffer(m_Buffer_Index);
   }
+  m_MeshletCuller.setMeshlets({});
+  m_VisibleRanges.clear();
+  m_LODs.clear();
+  m_CurrentLOD = 0;
+  m_Occluder = MTU::occluderMesh{};
 }
 
 // *****************************************************************************
 // ****************************************************** Private functions ****
 
+void vulkanModel::bindMeshBuffers(VkCommandBuffer FCB)
+{
+  if (m_pArena != nullptr)return;
+
+  // skipped while the command buffer still has them bound
+  vulkanCommandState::bindVertexBuffer(FCB, 0, m_Buffer_Vertex.m_Buffer);
+  if (m_IndexCount)vulkanCommandState::bindIndexBuffer(FCB, m_Buffer_Index.m_Buffer, 0, m_IndexType);
+}
 
 
 // *****************************************************************************
@@ -0,0 +1,349 @@
+/*!*****************************************************************************
+ * @file    vulkanRenderQueue.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanRenderQueue struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <bit>        // for depth bits
+#include <future>     // for chunk jobs
+#include <algorithm>
+#include <cassert>
+#include <cstring>    // for push constant copies
+#include <functional> // for hash
+#include <utility>    // for swap
+#include <vulkanHelpers/vulkanRenderQueue.h>
+#include <vulkanHelpers/vulkanWindow.h>
+#include <vulkanHelpers/printWarnings.h>
+
+namespace MTU
+{
+  namespace Helper
+  {
+    // positive floats order the same as their bits, negatives/NaN go to 0
+    static uint32_t getDepthBits(float depth) noexcept
+    {
+      return depth > 0.0f ? std::bit_cast<uint32_t>(depth) : 0u;
+    }
+
+    // raw bytes, only for types without padding
+    template <typename T>
+    static void appendSignature(std::vector<std::byte>& outSignature, T const& value)
+    {
+      const std::byte* pBytes{ reinterpret_cast<const std::byte*>(&value) };
+      outSignature.insert(outSignature.end(), pBytes, pBytes + sizeof(T));
+    }
+  }
+}
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+size_t vulkanRenderQueue::materialHash::operator()(descriptorSets const& Sets) const noexcept
+{
+  std::hash<VkDescriptorSet> hasher{};
+  return hasher(Sets[0]) ^ (hasher(Sets[1]) * 0x9E3779B97F4A7C15ull);
+}
+
+void vulkanRenderQueue::clear() noexcept
+{
+  m_Items.clear();
+  m_ItemPushes.clear();
+  m_Pushes.clear();
+  m_PushOffsets.clear();
+  m_PushData.clear();
+}
+
+void vulkanRenderQueue::submit(drawItem const& Item)
+{
+  assert(Item.m_pPipeline != nullptr);
+  m_Items.emplace_back(Item);
+  m_ItemPushes.emplace_back(static_cast<uint32_t>(m_Pushes.size()));
+}
+
+void vulkanRenderQueue::pushConstant(VkShaderStageFlags stageFlags, uint32_t offsetInto, uint32_t srcSize, const void* srcData)
+{
+  assert(false == m_Items.empty());
+  assert(srcSize && srcData);
+  m_Pushes.emplace_back(VkPushConstantRange{ .stageFlags{ stageFlags }, .offset{ offsetInto }, .size{ srcSize } });
+  m_PushOffsets.emplace_back(static_cast<uint32_t>(m_PushData.size()));
+  m_PushData.resize(m_PushData.size() + srcSize);
+  std::memcpy(m_PushData.data() + m_PushOffsets.back(), srcData, srcSize);
+}
+
+uint32_t vulkanRenderQueue::record(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena)
+{
+  assert(FCB != VK_NULL_HANDLE && false == Window.m_bfRenderPassSecondary);
+  sortItems(Window);
+  return recordItems(FCB, Window, Commands, Arena, 0, static_cast<uint32_t>(m_Keys.size()));
+}
+
+bool vulkanRenderQueue::createReplay(vulkanWindow& Window)
+{
+  assert(m_Replays.empty());
+  m_Replays.resize(Window.m_FramesInFlight);
+  return true;
+}
+
+void vulkanRenderQueue::destroyReplay()
+{
+  for (std::unordered_map<uint64_t, replayGroup>& frameGroups : m_Replays)
+  {
+    for (auto& x : frameGroups)x.second.m_Commands.destroySecondaryCommands();
+  }
+  m_Replays.clear();
+}
+
+bool vulkanRenderQueue::replay(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena)
+{
+  assert(FCB != VK_NULL_HANDLE && Window.m_bfRenderPassSecondary);
+  if (Window.m_FrameIndex >= m_Replays.size())
+  {
+    printWarning("render queue replay has no command buffers for this frame"sv);
+    return false;
+  }
+  sortItems(Window);
+
+  // one secondary per run of a pipeline, a change only re-records its run.
+  // The GPU is done with this frame's last recordings once FrameBegin returns.
+  std::unordered_map<uint64_t, replayGroup>& frameGroups{ m_Replays[Window.m_FrameIndex] };
+  m_ReplayRuns.assign(m_PipelineIDs.size(), 0);
+  m_ExecuteBuffers.clear();
+  bool bReused{ true };
+  for (uint32_t first{ 0 }, last{ 0 }, t{ static_cast<uint32_t>(m_Keys.size()) }; first < t; first = last)
+  {
+    vulkanPipeline* pPipeline{ m_Items[m_Keys[first].m_Index].m_pPipeline };
+    last = first + 1;
+    while (last < t && m_Items[m_Keys[last].m_Index].m_pPipeline == pPipeline)++last;
+
+    uint32_t pipelineID{ m_PipelineIDs[pPipeline] };
+    auto [it, bNew]{ frameGroups.try_emplace((static_cast<uint64_t>(pipelineID) << 32) | m_ReplayRuns[pipelineID]++) };
+    replayGroup& group{ it->second };
+    if (bNew && false == group.m_Commands.createSecondaryCommands(Window))
+    {
+      frameGroups.erase(it);
+      printWarning("render queue replay has no command buffer for a pipeline, its draws are left out"sv);
+      bReused = false;
+      continue;
+    }
+
+    buildSignature(Window, Commands, Arena, first, last);
+    if (group.m_Signature != m_SignatureScratch)
+    {
+      bReused = false;
+      group.m_Signature.clear();
+      VkCommandBuffer SCB{ group.m_Commands.begin(Window) };
+      if (SCB == VK_NULL_HANDLE)continue;
+      recordItems(SCB, Window, Commands, Arena, first, last);
+      if (false == group.m_Commands.end())continue;
+      std::swap(group.m_Signature, m_SignatureScratch);
+      ++m_ReplaysRecorded;
+    }
+    else ++m_ReplaysReused;
+    m_ExecuteBuffers.emplace_back(group.m_Commands.m_VKCommandBuffer);
+  }
+  if (m_ExecuteBuffers.size())vulkanCommandState::executeCommands(FCB, static_cast<uint32_t>(m_ExecuteBuffers.size()), m_ExecuteBuffers.data());
+  return bReused;
+}
+
+bool vulkanRenderQueue::createParallel(vulkanWindow& Window, uint32_t threadCount)
+{
+  assert(m_Workers.empty() && threadCount);
+  m_WorkerCount = threadCount;
+  m_Workers.resize(static_cast<size_t>(Window.m_FramesInFlight) * threadCount);
+  for (vulkanSecondaryCommands& x : m_Workers)
+  {
+    if (false == x.createSecondaryCommands(Window))
+    {
+      destroyParallel();
+      return false;
+    }
+  }
+  return true;
+}
+
+void vulkanRenderQueue::destroyParallel()
+{
+  for (vulkanSecondaryCommands& x : m_Workers)x.destroySecondaryCommands();
+  m_Workers.clear();
+  m_WorkerCount = 0;
+}
+
+uint32_t vulkanRenderQueue::recordParallel(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena, MTU::threadPool& Pool)
+{
+  assert(FCB != VK_NULL_HANDLE && Window.m_bfRenderPassSecondary);
+  if (static_cast<size_t>(Window.m_FrameIndex + 1) * m_WorkerCount > m_Workers.size())
+  {
+    printWarning("render queue has no worker command buffers for this frame"sv);
+    return 0;
+  }
+  sortItems(Window);
+
+  // contiguous runs of the sorted items, executed in the same order so the
+  // result matches record. Small runs aren't worth a secondary each.
+  uint32_t itemCount{ static_cast<uint32_t>(m_Keys.size()) };
+  uint32_t chunkCount{ std::min(m_WorkerCount, (itemCount + s_MinChunkItems - 1) / s_MinChunkItems) };
+  m_ParallelItems = itemCount;
+  m_ParallelChunks = chunkCount;
+  if (chunkCount == 0)return 0;
+  uint32_t chunkItems{ (itemCount + chunkCount - 1) / chunkCount };
+
+  vulkanSecondaryCommands* pFrameWorkers{ m_Workers.data() + static_cast<size_t>(Window.m_FrameIndex) * m_WorkerCount };
+  auto recordChunk
+  {
+    [&, pFrameWorkers, chunkItems, itemCount](uint32_t chunk) -> uint32_t
+    {
+      vulkanSecondaryCommands& worker{ pFrameWorkers[chunk] };
+      VkCommandBuffer SCB{ worker.begin(Window) };
+      if (SCB == VK_NULL_HANDLE)return UINT32_MAX;
+      uint32_t first{ chunk * chunkItems };
+      uint32_t drawn{ recordItems(SCB, Window, Commands, Arena, first, std::min(first + chunkItems, itemCount)) };
+      return worker.end() ? drawn : UINT32_MAX;
+    }
+  };
+
+  // the calling thread takes the last chunk instead of idling
+  std::vector<std::future<uint32_t>> Jobs;
+  Jobs.reserve(chunkCount - 1);
+  for (uint32_t i{ 0 }; i + 1 < chunkCount; ++i)Jobs.emplace_back(Pool.submit([&recordChunk, i]() { return recordChunk(i); }));
+  uint32_t lastDrawn{ recordChunk(chunkCount - 1) };
+
+  // a chunk that failed to record is left out, the rest still draw
+  uint32_t drawn{ 0 };
+  m_ExecuteBuffers.clear();
+  for (uint32_t i{ 0 }; i < chunkCount; ++i)
+  {
+    uint32_t chunkDrawn{ i + 1 < chunkCount ? Jobs[i].get() : lastDrawn };
+    if (chunkDrawn == UINT32_MAX)continue;
+    drawn += chunkDrawn;
+    m_ExecuteBuffers.emplace_back(pFrameWorkers[i].m_VKCommandBuffer);
+  }
+  if (m_ExecuteBuffers.size())vulkanCommandState::executeCommands(FCB, static_cast<uint32_t>(m_ExecuteBuffers.size()), m_ExecuteBuffers.data());
+  return drawn;
+}
+
+// *****************************************************************************
+// ****************************************************** Private functions ****
+
+void vulkanRenderQueue::sortItems(vulkanWindow& Window)
+{
+  // an item's null material is its pipeline's sets for this frame, resolved
+  // here so the key sees the sets actually bound
+  m_Keys.clear();
+  m_Keys.reserve(m_Items.size());
+  for (uint32_t i{ 0 }, t{ static_cast<uint32_t>(m_Items.size()) }; i < t; ++i)
+  {
+    drawItem& item{ m_Items[i] };
+    if (item.m_Batch == UINT32_MAX)continue;// the indirect buffer was full
+    if (item.m_Material[0] == VK_NULL_HANDLE && item.m_Material[1] == VK_NULL_HANDLE)
+    {
+      item.m_Material = item.m_pPipeline->m_DescriptorSets[Window.m_FrameIndex];
+    }
+
+    auto pipelineID{ m_PipelineIDs.try_emplace(item.m_pPipeline, static_cast<uint32_t>(m_PipelineIDs.size())).first->second };
+    auto materialID{ m_MaterialIDs.try_emplace(item.m_Material, static_cast<uint32_t>(m_MaterialIDs.size())).first->second };
+    if (pipelineID >= s_MaxPipelines || materialID >= s_MaxMaterials)
+    {
+      printWarning("render queue out of pipeline/material ids, item dropped"sv);
+      continue;
+    }
+
+    uint64_t depth{ MTU::Helper::getDepthBits(item.m_Depth) };
+    uint64_t state{ (static_cast<uint64_t>(pipelineID) << 16) | materialID };
+    m_Keys.emplace_back(MTU::sortKey
+    {
+      .m_Key
+      {
+        item.m_bTranslucent ?
+        (1ull << 63) | ((~depth & 0xFFFFFFFFull) << 31) | state :
+        (state << 32) | depth
+      },
+      .m_Index{ i }
+    });
+  }
+  MTU::radixSort(m_Keys, m_SortScratch);
+
+  // getPipeline may create one, done here so recording can be threaded
+  vulkanPipeline* pLastPipeline{ nullptr };
+  VkPipeline      pipeline{ VK_NULL_HANDLE };
+  m_KeyPipelines.clear();
+  m_KeyPipelines.reserve(m_Keys.size());
+  for (MTU::sortKey const& key : m_Keys)
+  {
+    vulkanPipeline* pPipeline{ m_Items[key.m_Index].m_pPipeline };
+    if (pPipeline != pLastPipeline)
+    {
+      pipeline = Window.getPipeline(*pPipeline);
+      pLastPipeline = pPipeline;
+    }
+    m_KeyPipelines.emplace_back(pipeline);
+  }
+}
+
+uint32_t vulkanRenderQueue::recordItems(VkCommandBuffer FCB, vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena, uint32_t firstKey, uint32_t lastKey) const
+{
+  // sorted items share state with their neighbours, the command buffer's
+  // vulkanCommandState drops the binds that repeat. Only reads the queue,
+  // several threads may record different ranges.
+  uint32_t drawn{ 0 };
+  for (uint32_t k{ firstKey }; k < lastKey; ++k)
+  {
+    MTU::sortKey const& key{ m_Keys[k] };
+    drawItem const& item{ m_Items[key.m_Index] };
+    if (m_KeyPipelines[k] == VK_NULL_HANDLE)continue;
+    vulkanCommandState::bindPipeline(FCB, VK_PIPELINE_BIND_POINT_GRAPHICS, m_KeyPipelines[k]);
+    vulkanCommandState::bindDescriptorSets(FCB, VK_PIPELINE_BIND_POINT_GRAPHICS, item.m_pPipeline->m_PipelineLayout, 0, static_cast<uint32_t>(item.m_Material.size()), item.m_Material.data());
+    if (item.m_pInstances != nullptr)item.m_pInstances->bind(FCB, Window.m_FrameIndex);
+    (item.m_pArena ? *item.m_pArena : Arena).bind(FCB);
+
+    for (uint32_t i{ m_ItemPushes[key.m_Index] }, t{ getPushEnd(key.m_Index) }; i < t; ++i)
+    {
+      item.m_pPipeline->pushConstant(FCB, m_Pushes[i].stageFlags, m_Pushes[i].offset, m_Pushes[i].size, m_PushData.data() + m_PushOffsets[i]);
+    }
+    Commands.draw(FCB, item.m_Batch);
+    ++drawn;
+  }
+  return drawn;
+}
+
+void vulkanRenderQueue::buildSignature(vulkanWindow& Window, vulkanIndirectBuffer const& Commands, vulkanGeometryArena const& Arena, uint32_t firstKey, uint32_t lastKey)
+{
+  // everything the recording depends on, the data it reads at execution
+  // (indirect commands, instances, uniforms) can change freely
+  m_SignatureScratch.clear();
+  MTU::Helper::appendSignature(m_SignatureScratch, Window.m_VKRenderPass);
+  MTU::Helper::appendSignature(m_SignatureScratch, Window.m_DefaultViewport);
+  MTU::Helper::appendSignature(m_SignatureScratch, Window.m_DefaultScissor);
+  MTU::Helper::appendSignature(m_SignatureScratch, Commands.m_Buffers[Commands.m_FrameIndex].m_Buffer);
+  for (uint32_t k{ firstKey }; k < lastKey; ++k)
+  {
+    MTU::sortKey const& key{ m_Keys[k] };
+    drawItem const& item{ m_Items[key.m_Index] };
+    vulkanGeometryArena const& itemArena{ item.m_pArena ? *item.m_pArena : Arena };
+    MTU::Helper::appendSignature(m_SignatureScratch, m_KeyPipelines[k]);
+    MTU::Helper::appendSignature(m_SignatureScratch, item.m_Material);
+    MTU::Helper::appendSignature(m_SignatureScratch, itemArena.m_Buffer_Vertex.m_Buffer);
+    MTU::Helper::appendSignature(m_SignatureScratch, itemArena.m_Buffer_Index.m_Buffer);
+    MTU::Helper::appendSignature(m_SignatureScratch, item.m_pInstances ? item.m_pInstances->m_Buffers[Window.m_FrameIndex].m_Buffer : VK_NULL_HANDLE);
+    for (uint32_t i{ m_ItemPushes[key.m_Index] }, e{ getPushEnd(key.m_Index) }; i < e; ++i)
+    {
+      MTU::Helper::appendSignature(m_SignatureScratch, m_Pushes[i]);
+      m_SignatureScratch.insert(m_SignatureScratch.end(), m_PushData.begin() + m_PushOffsets[i], m_PushData.begin() + m_PushOffsets[i] + m_Pushes[i].size);
+    }
+
+    // draw records the batch's slots, a CPU count within the reserved ones
+    // is only read at execution
+    vulkanIndirectBuffer::batch itemBatch{ item.m_Batch < Commands.m_Batches.size() ? Commands.m_Batches[item.m_Batch] : vulkanIndirectBuffer::batch{} };
+    MTU::Helper::appendSignature(m_SignatureScratch, itemBatch.m_FirstCommand);
+    MTU::Helper::appendSignature(m_SignatureScratch, std::max(itemBatch.m_CommandCount, itemBatch.m_MaxCommands));
+  }
+}
+
+uint32_t vulkanRenderQueue::getPushEnd(uint32_t itemIndex) const noexcept
+{
+  return itemIndex + 1 < m_ItemPushes.size() ? m_ItemPushes[itemIndex + 1] : static_cast<uint32_t>(m_Pushes.size());
+}
+
+// *****************************************************************************
@@ -0,0 +1,113 @@
+/*!*****************************************************************************
+ * @file    vulkanSecondaryCommands.cpp
+ * @author  Owen Huang Wensong  (w.huang@digipen.edu)
+ * @date    16 OCT 2026
+ * @brief   This is the implementation for the vulkanSecondaryCommands struct
+ *
+ * @par Copyright (C) 2022 DigiPen Institute of Technology. All rights reserved.
+*******************************************************************************/
+
+#include <cassert>
+#include <vulkanHelpers/vulkanSecondaryCommands.h>
+#include <vulkanHelpers/vulkanWindow.h>
+#include <vulkanHelpers/printWarnings.h>
+
+// *****************************************************************************
+// ******************************************************* Public functions ****
+
+bool vulkanSecondaryCommands::createSecondaryCommands(vulkanWindow& Window)
+{
+  assert(m_VKCommandPool == VK_NULL_HANDLE);
+  m_Device = Window.m_Device;
+
+  VkCommandPoolCreateInfo PoolInfo
+  {
+    .sType{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO },
+    .flags{ 0 },// reset as a whole in begin
+    .queueFamilyIndex{ m_Device->m_MainQueueIndex }
+  };
+  if (VkResult tmpRes{ vkCreateCommandPool(m_Device->m_VKDevice, &PoolInfo, m_Device->m_pVKInst->m_pVKAllocator, &m_VKCommandPool) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Unable to create a secondary command pool"sv, true);
+    destroySecondaryCommands();
+    return false;
+  }
+
+  VkCommandBufferAllocateInfo AllocInfo
+  {
+    .sType      { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO },
+    .commandPool{ m_VKCommandPool },
+    .level      { VK_COMMAND_BUFFER_LEVEL_SECONDARY },
+    .commandBufferCount{ 1 }
+  };
+  if (VkResult tmpRes{ vkAllocateCommandBuffers(m_Device->m_VKDevice, &AllocInfo, &m_VKCommandBuffer) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "Unable to create a secondary command buffer"sv, true);
+    destroySecondaryCommands();
+    return false;
+  }
+  vulkanCommandState::registerState(m_VKCommandBuffer, m_CommandState);
+  return true;
+}
+
+void vulkanSecondaryCommands::destroySecondaryCommands()
+{
+  if (m_Device.get() == nullptr)return;
+  m_Device->waitForDeviceIdle();// a primary may still execute it
+  if (m_VKCommandBuffer != VK_NULL_HANDLE)
+  {
+    vulkanCommandState::unregisterState(m_VKCommandBuffer);
+    vkFreeCommandBuffers(m_Device->m_VKDevice, m_VKCommandPool, 1, &m_VKCommandBuffer);
+  }
+  vkDestroyCommandPool(m_Device->m_VKDevice, m_VKCommandPool, m_Device->m_pVKInst->m_pVKAllocator);
+  m_VKCommandBuffer = VK_NULL_HANDLE;
+  m_VKCommandPool = VK_NULL_HANDLE;
+  m_Device.reset();
+}
+
+VkCommandBuffer vulkanSecondaryCommands::begin(vulkanWindow& Window)
+{
+  assert(m_VKCommandBuffer != VK_NULL_HANDLE);
+  if (VkResult tmpRes{ vkResetCommandPool(m_Device->m_VKDevice, m_VKCommandPool, 0) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "vkResetCommandPool failed?"sv, true);
+    return VK_NULL_HANDLE;
+  }
+
+  VkCommandBufferInheritanceInfo InheritanceInfo
+  {
+    .sType      { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO },
+    .renderPass { Window.m_VKRenderPass },
+    .subpass    { 0 },
+    .framebuffer{ VK_NULL_HANDLE }// any swapchain image, frames in flight don't follow them
+  };
+  VkCommandBufferBeginInfo BeginInfo
+  {
+    .sType            { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO },
+    .flags            { VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT },
+    .pInheritanceInfo { &InheritanceInfo }
+  };
+  if (VkResult tmpRes{ vkBeginCommandBuffer(m_VKCommandBuffer, &BeginInfo) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "vkBeginCommandBuffer failed?"sv, true);
+    return VK_NULL_HANDLE;
+  }
+  m_CommandState.reset();
+  m_CommandState.m_Stats = vulkanCommandState::stats{};
+
+  vulkanCommandState::setScissor(m_VKCommandBuffer, Window.m_DefaultScissor);
+  vulkanCommandState::setViewport(m_VKCommandBuffer, Window.m_DefaultViewport);
+  return m_VKCommandBuffer;
+}
+
+bool vulkanSecondaryCommands::end()
+{
+  if (VkResult tmpRes{ vkEndCommandBuffer(m_VKCommandBuffer) }; tmpRes != VK_SUCCESS)
+  {
+    printVKWarning(tmpRes, "vkEndCommandBuffer failed?"sv, true);
+    return false;
+  }
+  return true;
+}
+
+// *****************************************************************************
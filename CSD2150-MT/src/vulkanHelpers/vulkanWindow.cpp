@@ -12,6 +12,8 @@
 #include <vulkan/vulkan_win32.h>
 #include <iostream> // for wcout
 #include <variant>  // descriptor variants
+#include <algorithm>
+#include <chrono>   // for wait times
 #include <vector>
 #include <span>
 
@@ -111,24 +113,31 @@ VkPresentModeKHR SelectPresentMode(VkPhysicalDevice VKDevice,
 void MinimalDestroyFrame(VkDevice VKDevice, vulkanFrame& Frame, VkAllocationCallbacks const* pAllocator) noexcept
 {
   vkDestroyFence(VKDevice, Frame.m_VKFence, pAllocator);
+  vulkanCommandState::unregisterState(Frame.m_VKCommandBuffer);
   vkFreeCommandBuffers(VKDevice, Frame.m_VKCommandPool, 1, &Frame.m_VKCommandBuffer);
   vkDestroyCommandPool(VKDevice, Frame.m_VKCommandPool, pAllocator);
 
   Frame.m_VKFence = VK_NULL_HANDLE;
   Frame.m_VKCommandBuffer = VK_NULL_HANDLE;
   Frame.m_VKCommandPool = VK_NULL_HANDLE;
+}
+
+void MinimalDestroyBackBuffer(VkDevice VKDevice, vulkanBackBuffer& BackBuffer, VkAllocationCallbacks const* pAllocator) noexcept
+{
+  vkDestroyImageView(VKDevice, BackBuffer.m_VKBackBufferView, pAllocator);
+  vkDestroyFramebuffer(VKDevice, BackBuffer.m_VKFramebuffer, pAllocator);
+  vkDestroySemaphore(VKDevice, BackBuffer.m_VKRenderCompleteSemaphore, pAllocator);
 
-  vkDestroyImageView(VKDevice, Frame.m_VKBackBufferView, pAllocator);
-  vkDestroyFramebuffer(VKDevice, Frame.m_VKFramebuffer, pAllocator);
+  BackBuffer.m_VKBackBufferView = VK_NULL_HANDLE;
+  BackBuffer.m_VKFramebuffer = VK_NULL_HANDLE;
+  BackBuffer.m_VKRenderCompleteSemaphore = VK_NULL_HANDLE;
 }
 
 void MinimalDestroyFrameSemaphores(VkDevice VKDevice, vulkanFrameSem& FrameSemaphores, VkAllocationCallbacks const* pAllocator) noexcept
 {
   vkDestroySemaphore(VKDevice, FrameSemaphores.m_VKImageAcquiredSemaphore, pAllocator);
-  vkDestroySemaphore(VKDevice, FrameSemaphores.m_VKRenderCompleteSemaphore, pAllocator);
 
   FrameSemaphores.m_VKImageAcquiredSemaphore = VK_NULL_HANDLE;
-  FrameSemaphores.m_VKRenderCompleteSemaphore = VK_NULL_HANDLE;
 }
 
 // *****************************************************************************
@@ -152,13 +161,22 @@ vulkanWindow::~vulkanWindow()
 
   if (m_Frames.get())
   {
-    for (uint32_t i{ 0 }, t{ m_ImageCount }; i < t; ++i)
+    for (uint32_t i{ 0 }, t{ m_FramesInFlight }; i < t; ++i)
     {
       MinimalDestroyFrame(m_Device->m_VKDevice, m_Frames[i], pAllocator);
       MinimalDestroyFrameSemaphores(m_Device->m_VKDevice, m_FrameSemaphores[i], pAllocator);
     }
     m_Frames.reset();
     m_FrameSemaphores.reset();
+  }
+
+  if (m_BackBuffers.get())
+  {
+    for (uint32_t i{ 0 }, t{ m_ImageCount }; i < t; ++i)
+    {
+      MinimalDestroyBackBuffer(m_Device->m_VKDevice, m_BackBuffers[i], pAllocator);
+    }
+    m_BackBuffers.reset();
 
     // Release the depth buffer (will exist if Framebuffer exists right?)
     vkDestroyImageView(m_Device->m_VKDevice, m_VKDepthbufferView, pAllocator);
@@ -189,6 +207,10 @@ bool vulkanWindow::Initialize(std::shared_ptr<vulkanDevice>& Device,
 {
   m_Device = Device;
   m_bfClearOnRender = Setup.m_bClearOnRender ? 1 : 0;
+  m_bfDepthReadable = Setup.m_bDepthReadable ? 1 : 0;
+  m_FramesInFlight = std::clamp(Setup.m_FramesInFlight, 1u, s_MaxFramesInFlight);
+  setMaxQueuedFrames(Setup.m_MaxQueuedFrames ? Setup.m_MaxQueuedFrames : m_FramesInFlight);
+  m_FramePacer.setFrameRateCap(Setup.m_FrameRateCap);
   m_VKClearValue[0] = VkClearValue
   { .color{.float32{
       Setup.m_ClearColorR,
@@ -352,6 +374,11 @@ void vulkanWindow::toggleFullscreen() noexcept
   m_windowsWindow.setFullscreen(m_windowsWindow.m_bfFullscreen ? false : true);
 }
 
+void vulkanWindow::setMaxQueuedFrames(uint32_t maxQueuedFrames) noexcept
+{
+  m_MaxQueuedFrames = std::clamp(maxQueuedFrames, 1u, m_FramesInFlight);
+}
+
 void vulkanWindow::updateDefaultViewportAndScissor() noexcept
 {
   m_DefaultScissor.offset.x = 0;
@@ -381,16 +408,14 @@ bool vulkanWindow::CreateWindowSwapChain() noexcept
 
   m_Device->waitForDeviceIdle();
 
-  // Destroy old Framebuffer
-  if (m_Frames.get())
+  // Destroy old Framebuffer, frames in flight don't depend on the swapchain
+  if (m_BackBuffers.get())
   {
     for (uint32_t i{ 0 }, t{ m_ImageCount }; i < t; ++i)
     {
-      MinimalDestroyFrame(m_Device->m_VKDevice, m_Frames[i], pAllocator);
-      MinimalDestroyFrameSemaphores(m_Device->m_VKDevice, m_FrameSemaphores[i], pAllocator);
+      MinimalDestroyBackBuffer(m_Device->m_VKDevice, m_BackBuffers[i], pAllocator);
     }
-    m_Frames.reset();         // Destroyed in the step before (changed from release)
-    m_FrameSemaphores.reset();// Destroyed in the step before (changed from release)
+    m_BackBuffers.reset();// Destroyed in the step before (changed from release)
 
     // Release the depth buffer (will exist if Framebuffer exists right?)
     vkDestroyImageView(m_Device->m_VKDevice, m_VKDepthbufferView, pAllocator);
@@ -477,13 +502,12 @@ bool vulkanWindow::CreateWindowSwapChain() noexcept
       return false;
     }
 
-    assert(m_Frames.get() == nullptr);
-    m_Frames = std::make_unique<vulkanFrame[]>(m_ImageCount);
-    m_FrameSemaphores = std::make_unique<vulkanFrameSem[]>(m_ImageCount);
+    assert(m_BackBuffers.get() == nullptr);
+    m_BackBuffers = std::make_unique<vulkanBackBuffer[]>(m_ImageCount);
 
     for (uint32_t i{ 0 }; i < m_ImageCount; ++i)
     {
-      m_Frames[i].m_VKBackBuffer = BackBuffers[i];// ??? move? ???
+      m_BackBuffers[i].m_VKBackBuffer = BackBuffers[i];// ??? move? ???
     }
   }
 
@@ -519,10 +543,10 @@ bool vulkanWindow::CreateWindowSwapChain() noexcept
 
     for (uint32_t i{ 0 }; i < m_ImageCount; ++i)
     {
-      auto& Frame{ m_Frames[i] };
-      CreateInfo.image = Frame.m_VKBackBuffer;
+      auto& BackBuffer{ m_BackBuffers[i] };
+      CreateInfo.image = BackBuffer.m_VKBackBuffer;
 
-      if (VkResult tmpRes{ vkCreateImageView(m_Device->m_VKDevice, &CreateInfo, pAllocator, &Frame.m_VKBackBufferView) }; tmpRes != VK_SUCCESS)
+      if (VkResult tmpRes{ vkCreateImageView(m_Device->m_VKDevice, &CreateInfo, pAllocator, &BackBuffer.m_VKBackBufferView) }; tmpRes != VK_SUCCESS)
       {
         printVKWarning(tmpRes, "Unable to create an Image View for a back buffer"sv, true);
         return false;
@@ -547,10 +571,10 @@ bool vulkanWindow::CreateWindowSwapChain() noexcept
 
     for (uint32_t i{ 0 }; i < m_ImageCount; ++i)
     {
-      auto& Frame{ m_Frames[i] };
-      Attachment[0] = Frame.m_VKBackBufferView;
+      auto& BackBuffer{ m_BackBuffers[i] };
+      Attachment[0] = BackBuffer.m_VKBackBufferView;
       Attachment[1] = m_VKDepthbufferView;
-      if (VkResult tmpRes{ vkCreateFramebuffer(m_Device->m_VKDevice, &CreateInfo, pAllocator, &Frame.m_VKFramebuffer) }; tmpRes != VK_SUCCESS)
+      if (VkResult tmpRes{ vkCreateFramebuffer(m_Device->m_VKDevice, &CreateInfo, pAllocator, &BackBuffer.m_VKFramebuffer) }; tmpRes != VK_SUCCESS)
       {
         printVKWarning(tmpRes, "Unable to create a Frame Buffer"sv, true);
         return false;
@@ -558,6 +582,24 @@ bool vulkanWindow::CreateWindowSwapChain() noexcept
     }
   }
 
+  // Create the render complete semaphores, per image because the present
+  // holding one may outlive the frame in flight that signalled it
+  {
+    VkSemaphoreCreateInfo CreateInfo
+    {
+      .sType{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO }
+    };
+
+    for (uint32_t i{ 0 }; i < m_ImageCount; ++i)
+    {
+      if (VkResult tmpRes{ vkCreateSemaphore(m_Device->m_VKDevice, &CreateInfo, pAllocator, &m_BackBuffers[i].m_VKRenderCompleteSemaphore) }; tmpRes != VK_SUCCESS)
+      {
+        printVKWarning(tmpRes, "Unable to create a Render Complete Semaphore"sv, true);
+        return false;
+      }
+    }
+  }
+
   return true;
 }
 
@@ -579,7 +621,7 @@ bool vulkanWindow::CreateDepthResources(VkExtent2D Extents) noexcept
     .arrayLayers    { 1 },
     .samples        { VK_SAMPLE_COUNT_1_BIT },
     .tiling         { VK_IMAGE_TILING_OPTIMAL },
-    .usage          { VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT },
+    .usage          { VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | (m_bfDepthReadable ? VK_IMAGE_USAGE_SAMPLED_BIT : 0u) },
     .sharingMode    { VK_SHARING_MODE_EXCLUSIVE },
     .initialLayout  { VK_IMAGE_LAYOUT_UNDEFINED } // ???
   };
@@ -642,6 +684,8 @@ bool vulkanWindow::CreateDepthResources(VkExtent2D Extents) noexcept
     return false;
   }
 
+  m_DepthExtent = Extents;
+  ++m_DepthGeneration;
   return true;
 
 }
@@ -677,16 +721,28 @@ bool vulkanWindow::CreateRenderPass(VkSurfaceFormatKHR& VKColorSurfaceFormat, Vk
     }
   };
 
+  // a readable depth is read by compute after the pass, and the next
+  // pass must not clear it before that read is done
+  VkPipelineStageFlags DepthReaderStage{ m_bfDepthReadable ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : 0u };
   std::array SubpassDependancy
   {
     VkSubpassDependency
     {
       .srcSubpass     { VK_SUBPASS_EXTERNAL },
       .dstSubpass     { 0 },   // VK_SUBPASS_CONTENTS_INLINE???
-      .srcStageMask   { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT },
+      .srcStageMask   { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | DepthReaderStage },
       .dstStageMask   { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT },
       .srcAccessMask  { 0 },
       .dstAccessMask  { VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT }
+    },
+    VkSubpassDependency
+    {
+      .srcSubpass     { 0 },
+      .dstSubpass     { VK_SUBPASS_EXTERNAL },
+      .srcStageMask   { VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT },
+      .dstStageMask   { m_bfDepthReadable ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT },
+      .srcAccessMask  { VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT },
+      .dstAccessMask  { m_bfDepthReadable ? VK_ACCESS_SHADER_READ_BIT : 0u }
     }
   };
 
@@ -710,11 +766,11 @@ bool vulkanWindow::CreateRenderPass(VkSurfaceFormatKHR& VKColorSurfaceFormat, Vk
       .format         { VKDepthSurfaceFormat },
       .samples        { VK_SAMPLE_COUNT_1_BIT },
       .loadOp         { VK_ATTACHMENT_LOAD_OP_CLEAR },
-      .storeOp        { VK_ATTACHMENT_STORE_OP_DONT_CARE },
+      .storeOp        { m_bfDepthReadable ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE },
       .stencilLoadOp  { VK_ATTACHMENT_LOAD_OP_DONT_CARE },
       .stencilStoreOp { VK_ATTACHMENT_STORE_OP_DONT_CARE },
       .initialLayout  { VK_IMAGE_LAYOUT_UNDEFINED },    // ???
-      .finalLayout    { VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL }
+      .finalLayout    { m_bfDepthReadable ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL }
     }
   };
 
@@ -741,9 +797,13 @@ bool vulkanWindow::CreateRenderPass(VkSurfaceFormatKHR& VKColorSurfaceFormat, Vk
 
 bool vulkanWindow::CreateWindowCommandBuffers() noexcept
 {
+  // made once, a swapchain remake keeps them
+  if (m_Frames.get())return true;
   VkAllocationCallbacks* pAllocator{ m_Device->m_pVKInst->m_pVKAllocator };
 
-  for (uint32_t i{ 0 }; i < m_ImageCount; ++i)
+  m_Frames = std::make_unique<vulkanFrame[]>(m_FramesInFlight);
+  m_FrameSemaphores = std::make_unique<vulkanFrameSem[]>(m_FramesInFlight);
+  for (uint32_t i{ 0 }; i < m_FramesInFlight; ++i)
   {
     auto& Frame{ m_Frames[i] };
 
@@ -774,6 +834,7 @@ bool vulkanWindow::CreateWindowCommandBuffers() noexcept
         printVKWarning(tmpRes, "Unable to create a Frame Command Buffer"sv, true);
         return false;
       }
+      vulkanCommandState::registerState(Frame.m_VKCommandBuffer, Frame.m_CommandState);
     }
 
     {   // FENCES
@@ -800,11 +861,6 @@ bool vulkanWindow::CreateWindowCommandBuffers() noexcept
         printVKWarning(tmpRes, "Unable to create a Frame Image Semaphore"sv, true);
         return false;
       }
-      if (VkResult tmpRes{ vkCreateSemaphore(m_Device->m_VKDevice, &CreateInfo, pAllocator, &FrameSemaphores.m_VKRenderCompleteSemaphore) }; tmpRes != VK_SUCCESS)
-      {
-        printVKWarning(tmpRes, "Unable to create a Frame Render Semaphore"sv, true);
-        return false;
-      }
     }
 
   }
@@ -880,7 +936,7 @@ bool vulkanWindow::CreateUniformBuffers(vulkanPipeline& outPipeline, vulkanPipel
   for (size_t i{ 0 }, t{ refHelper.size() }; i < t; ++i)// for every shader
   {
     auto& DBufs{ outPipeline.m_DescriptorBuffers[i] };
-    DBufs.resize(static_cast<size_t>(m_ImageCount) * outPipeline.m_DescriptorCounts[i]);
+    DBufs.resize(static_cast<size_t>(m_FramesInFlight) * outPipeline.m_DescriptorCounts[i]);
     for (size_t j{ 0 }, k{ refHelper[i]->size() }; j < k; ++j)// for every uniform
     {
       if (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER == refHelper[i][0][j].m_DescriptorType)
@@ -894,7 +950,7 @@ bool vulkanWindow::CreateUniformBuffers(vulkanPipeline& outPipeline, vulkanPipel
         .m_Count      { 1 },
         .m_ElemSize   { refHelper[i][0][j].m_TypeSize }
       };
-      for (size_t l{ 0 }, m{ m_ImageCount }; l < m; ++l)// for every frame
+      for (size_t l{ 0 }, m{ m_FramesInFlight }; l < m; ++l)// for every frame
       {
         size_t idx{ outPipeline.m_DescriptorCounts[i] * l + j};
         if (false == pWH->createBuffer(DBufs[idx], BufferSetup))
@@ -923,7 +979,7 @@ bool vulkanWindow::CreateUniformDescriptorSets(vulkanPipeline& outPipeline, vulk
     &inSetup.m_pTexturesFrag
   };
 
-  outPipeline.m_DescriptorSets.resize(m_ImageCount);
+  outPipeline.m_DescriptorSets.resize(m_FramesInFlight);
   std::scoped_lock lock{ m_Device->m_LockedVKDescriptorPool };
   VkDescriptorSetAllocateInfo allocInfo
   {
@@ -932,7 +988,7 @@ bool vulkanWindow::CreateUniformDescriptorSets(vulkanPipeline& outPipeline, vulk
     .descriptorSetCount { static_cast<uint32_t>(outPipeline.m_DescriptorSetLayouts.size()) },
     .pSetLayouts        { outPipeline.m_DescriptorSetLayouts.data()}
   };
-  for (size_t l{ 0 }, m{ m_ImageCount }; l < m; ++l)
+  for (size_t l{ 0 }, m{ m_FramesInFlight }; l < m; ++l)
   {
     auto& DSets{ outPipeline.m_DescriptorSets[l] };
     if (VkResult tmpRes{ vkAllocateDescriptorSets(m_Device->m_VKDevice, &allocInfo, DSets.data()) }; tmpRes != VK_SUCCESS)
@@ -1065,7 +1121,7 @@ void vulkanWindow::DestroyUniformDescriptorSets(vulkanPipeline& outPipeline) noe
   outPipeline.m_DescriptorSets.clear();
 }
 
-VkCommandBuffer vulkanWindow::FrameBegin()
+VkCommandBuffer vulkanWindow::FrameBegin(bool bBeginRenderPass)
 {
   if (m_windowsWindow.isMinimized())return VK_NULL_HANDLE;
   // will fail if was not 0 before starting
@@ -1079,19 +1135,29 @@ VkCommandBuffer vulkanWindow::FrameBegin()
     m_windowsWindow.resetResized();
   }
 
-  // sync up with previous frame
+  // sync up with the last frame that used this frame's resources
   {
+    using msFloat = std::chrono::duration<float, std::milli>;
     auto& Frame{ m_Frames[m_FrameIndex] };
-    auto& FrameSem{ m_FrameSemaphores[m_SemaphoreIndex] };
+    auto& FrameSem{ m_FrameSemaphores[m_FrameIndex] };
+
+    // the cap first, the GPU may catch up meanwhile
+    m_FrameWaits.m_Pace = std::chrono::duration_cast<msFloat>(m_FramePacer.pace()).count();
 
-    // busy way for previous frame to finish rendering
+    // this slot's last frame, and the frame m_MaxQueuedFrames back if the
+    // queue is kept shorter than the ring. Blocks the thread, no spinning.
+    auto WaitStart{ MTU::framePacer::clock::now() };
+    std::array<VkFence, 2> Fences{ Frame.m_VKFence, m_Frames[(m_FrameIndex + m_FramesInFlight - m_MaxQueuedFrames) % m_FramesInFlight].m_VKFence };
+    uint32_t FenceCount{ Fences[0] == Fences[1] ? 1u : 2u };
     for (;;)
     {
-      VkResult tmpRes{ vkWaitForFences(m_Device->m_VKDevice, 1, &Frame.m_VKFence, VK_TRUE, 100) };
+      VkResult tmpRes{ vkWaitForFences(m_Device->m_VKDevice, FenceCount, Fences.data(), VK_TRUE, s_FenceTimeout) };
       switch (tmpRes)
       {
       case VK_SUCCESS: break;
-      case VK_TIMEOUT: continue;
+      case VK_TIMEOUT:
+        printWarning("GPU frame still running after a second, waiting on"sv);
+        continue;
       default:
         printVKWarning(tmpRes, "Failed to wait?"sv, true);
         assert(false);
@@ -1100,12 +1166,15 @@ VkCommandBuffer vulkanWindow::FrameBegin()
       break;
     }
 
-    if (VkResult tmpRes{ vkAcquireNextImageKHR(m_Device->m_VKDevice, m_VKSwapchain, UINT64_MAX, FrameSem.m_VKImageAcquiredSemaphore, VK_NULL_HANDLE, &m_FrameIndex) }; tmpRes != VK_SUCCESS)
+    auto AcquireStart{ MTU::framePacer::clock::now() };
+    if (VkResult tmpRes{ vkAcquireNextImageKHR(m_Device->m_VKDevice, m_VKSwapchain, UINT64_MAX, FrameSem.m_VKImageAcquiredSemaphore, VK_NULL_HANDLE, &m_ImageIndex) }; tmpRes != VK_SUCCESS)
     {
       printVKWarning(tmpRes, "vkAcquireNextImageKHR failed?"sv, true);
       assert(false);
     }
-
+    auto AcquireEnd{ MTU::framePacer::clock::now() };
+    m_FrameWaits.m_Fence = std::chrono::duration_cast<msFloat>(AcquireStart - WaitStart).count();
+    m_FrameWaits.m_Acquire = std::chrono::duration_cast<msFloat>(AcquireEnd - AcquireStart).count();
   }
 
   auto& Frame{ m_Frames[m_FrameIndex] };
@@ -1129,14 +1198,32 @@ VkCommandBuffer vulkanWindow::FrameBegin()
       printVKWarning(tmpRes, "vkBeginCommandBuffer failed?"sv, true);
       assert(false);
     }
+    Frame.m_CommandState.reset();
+    Frame.m_CommandState.m_Stats = vulkanCommandState::stats{};
   }
 
+  if (bBeginRenderPass)RenderPassBegin();
+
+  return Frame.m_VKCommandBuffer;
+}
+
+void vulkanWindow::RenderPassBegin(VkSubpassContents contents)
+{
+  auto& Frame{ m_Frames[m_FrameIndex] };
+
+  // set the default viewport, before the pass since a pass of secondaries
+  // can't record anything else
+  updateDefaultViewportAndScissor();
+
+  vulkanCommandState::setScissor(Frame.m_VKCommandBuffer, m_DefaultScissor);
+  vulkanCommandState::setViewport(Frame.m_VKCommandBuffer, m_DefaultViewport);
+
   // setup the renderpass
   VkRenderPassBeginInfo RenderPassBeginInfo
   {
     .sType          { VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO },
     .renderPass     { m_VKRenderPass },
-    .framebuffer    { Frame.m_VKFramebuffer },
+    .framebuffer    { m_BackBuffers[m_ImageIndex].m_VKFramebuffer },
     .renderArea
     {
       .extent
@@ -1148,16 +1235,17 @@ VkCommandBuffer vulkanWindow::FrameBegin()
     .clearValueCount{ m_bfClearOnRender ? static_cast<uint32_t>(m_VKClearValue.size()) : 0u},
     .pClearValues   { m_bfClearOnRender ? m_VKClearValue.data() : nullptr}
   };
-  vkCmdBeginRenderPass(Frame.m_VKCommandBuffer, &RenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-  // set the default viewport
-  updateDefaultViewportAndScissor();
-
-  vkCmdSetScissor(Frame.m_VKCommandBuffer, 0, 1, &m_DefaultScissor);
-  vkCmdSetViewport(Frame.m_VKCommandBuffer, 0, 1, &m_DefaultViewport);
-
+  vkCmdBeginRenderPass(Frame.m_VKCommandBuffer, &RenderPassBeginInfo, contents);
+  m_bfRenderPassOpen = 1;
+  m_bfRenderPassSecondary = contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+}
 
-  return Frame.m_VKCommandBuffer;
+void vulkanWindow::RenderPassEnd()
+{
+  assert(m_bfRenderPassOpen);
+  vkCmdEndRenderPass(m_Frames[m_FrameIndex].m_VKCommandBuffer);
+  m_bfRenderPassOpen = 0;
+  m_bfRenderPassSecondary = 0;
 }
 
 void vulkanWindow::FrameEnd()
@@ -1166,10 +1254,10 @@ void vulkanWindow::FrameEnd()
   assert(--m_bfFrameBeginState);
 
   auto& Frame{ m_Frames[m_FrameIndex] };
-  auto& FrameSem{ m_FrameSemaphores[m_SemaphoreIndex] };
+  auto& FrameSem{ m_FrameSemaphores[m_FrameIndex] };
 
-  // officially end the pass
-  vkCmdEndRenderPass(Frame.m_VKCommandBuffer);
+  // officially end the pass, unless the app already has
+  if (m_bfRenderPassOpen)RenderPassEnd();
 
   // officially end the commands
   if (VkResult tmpRes{ vkEndCommandBuffer(Frame.m_VKCommandBuffer) }; tmpRes != VK_SUCCESS)
@@ -1177,6 +1265,7 @@ void vulkanWindow::FrameEnd()
     printVKWarning(tmpRes, "vkEndCommandBuffer failed?"sv, true);
     assert(false);
   }
+  m_CommandStats = Frame.m_CommandState.m_Stats;
 
   // Reset the frame fence to know when we are finished with the frame
   if (VkResult tmpRes{ vkResetFences(m_Device->m_VKDevice, 1, &Frame.m_VKFence) }; tmpRes != VK_SUCCESS)
@@ -1196,7 +1285,7 @@ void vulkanWindow::FrameEnd()
     .commandBufferCount     { 1 },
     .pCommandBuffers        { &Frame.m_VKCommandBuffer },
     .signalSemaphoreCount   { 1 },
-    .pSignalSemaphores      { &FrameSem.m_VKRenderCompleteSemaphore }
+    .pSignalSemaphores      { &m_BackBuffers[m_ImageIndex].m_VKRenderCompleteSemaphore }
   };
 
   // supposedly as good, if not better than lock_guard
@@ -1213,15 +1302,12 @@ void vulkanWindow::PageFlip()
   // will fail if was not 1 before starting
   assert(!(--m_bfFrameBeginState));
 
-  auto& Frame{ m_Frames[m_FrameIndex] };
-  auto& FrameSem{ m_FrameSemaphores[m_SemaphoreIndex] };
-
-  uint32_t PresetIndex{ m_FrameIndex };
+  uint32_t PresetIndex{ m_ImageIndex };
   VkPresentInfoKHR Info
   {
     .sType              { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR },
     .waitSemaphoreCount { 1 },
-    .pWaitSemaphores    { &FrameSem.m_VKRenderCompleteSemaphore },
+    .pWaitSemaphores    { &m_BackBuffers[PresetIndex].m_VKRenderCompleteSemaphore },
     .swapchainCount     { 1 },
     .pSwapchains        { &m_VKSwapchain },
     .pImageIndices      { &PresetIndex }
@@ -1242,8 +1328,7 @@ void vulkanWindow::PageFlip()
     }
   }
 
-  m_FrameIndex = (++m_FrameIndex) % m_ImageCount;
-  m_SemaphoreIndex = (++m_SemaphoreIndex) % m_ImageCount;
+  m_FrameIndex = (++m_FrameIndex) % m_FramesInFlight;
 
 }
 
@@ -1490,12 +1575,18 @@ void vulkanWindow::destroyPipelineInfo(vulkanPipeline& inPipeline)
   pWH->destroyShaderModule(inPipeline.m_ShaderVert);
 }
 
-bool vulkanWindow::createAndSetPipeline(vulkanPipeline& pipelineCustomCreateInfo)
+VkPipeline vulkanWindow::getPipeline(vulkanPipeline& pipelineCustomCreateInfo)
 {
   if (pipelineCustomCreateInfo.m_PipelineLayout == VK_NULL_HANDLE)
   {
     printWarning("Cannot create pipeline with null pipelineLayout?"sv, true);
-    return false;
+    return VK_NULL_HANDLE;
+  }
+
+  // already made, skip building the create info
+  if (decltype(m_VKPipelines)::iterator found{ m_VKPipelines.find(&pipelineCustomCreateInfo) }; found != m_VKPipelines.end())
+  {
+    return found->second.m_Pipeline;
   }
 
   updateDefaultViewportAndScissor();
@@ -1531,43 +1622,41 @@ bool vulkanWindow::createAndSetPipeline(vulkanPipeline& pipelineCustomCreateInfo
 
   VkPipeline pipelineToSet{ VK_NULL_HANDLE };
 
-  if (decltype(m_VKPipelines)::iterator found{ m_VKPipelines.find(&pipelineCustomCreateInfo) }; found != m_VKPipelines.end())
+  if (VkResult tmpRes{ vkCreateGraphicsPipelines(m_Device->m_VKDevice, m_Device->m_VKPipelineCache, 1, &CreateInfo, m_Device->m_pVKInst->m_pVKAllocator, &pipelineToSet) }; tmpRes != VK_SUCCESS || pipelineToSet == VK_NULL_HANDLE)
   {
-    pipelineToSet = found->second.m_Pipeline;
+    printVKWarning(tmpRes, "Failed to create a pipeline!"sv, true);
+    return VK_NULL_HANDLE;
   }
-  else
-  {
-    if (VkResult tmpRes{ vkCreateGraphicsPipelines(m_Device->m_VKDevice, m_Device->m_VKPipelineCache, 1, &CreateInfo, m_Device->m_pVKInst->m_pVKAllocator, &pipelineToSet) }; tmpRes != VK_SUCCESS || pipelineToSet == VK_NULL_HANDLE)
-    {
-      printVKWarning(tmpRes, "Failed to create a pipeline!"sv, true);
-      return false;
-    }
 
-    auto emplaceResult{ m_VKPipelines.emplace(&pipelineCustomCreateInfo, vulkanPipelineData{ .m_Pipeline{ pipelineToSet } }) };
-    if (false == emplaceResult.second)
-    {
-      // I have no response, just pretend it never happened
-      printWarning("failed to emplace pipeline"sv, true);
-    }
-    
+  auto emplaceResult{ m_VKPipelines.emplace(&pipelineCustomCreateInfo, vulkanPipelineData{ .m_Pipeline{ pipelineToSet } }) };
+  if (false == emplaceResult.second)
+  {
+    // I have no response, just pretend it never happened
+    printWarning("failed to emplace pipeline"sv, true);
   }
 
+  return pipelineToSet;
+}
+
+bool vulkanWindow::createAndSetPipeline(vulkanPipeline& pipelineCustomCreateInfo)
+{
+  VkPipeline pipelineToSet{ getPipeline(pipelineCustomCreateInfo) };
+  if (pipelineToSet == VK_NULL_HANDLE)return false;
+
   auto& Frame{ m_Frames[m_FrameIndex] };
 
-  // Bind pipeline
-  vkCmdBindPipeline(Frame.m_VKCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineToSet);
+  // Bind pipeline, both skipped if already bound
+  vulkanCommandState::bindPipeline(Frame.m_VKCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineToSet);
 
   auto& frameDescriptorSets{ pipelineCustomCreateInfo.m_DescriptorSets[m_FrameIndex] };
-  vkCmdBindDescriptorSets
+  vulkanCommandState::bindDescriptorSets
   (
     Frame.m_VKCommandBuffer,
     VK_PIPELINE_BIND_POINT_GRAPHICS,
     pipelineCustomCreateInfo.m_PipelineLayout,
     0,// first set
     static_cast<uint32_t>(frameDescriptorSets.size()),
-    frameDescriptorSets.data(),
-    0,
-    nullptr
+    frameDescriptorSets.data()
   );
 
   return true;
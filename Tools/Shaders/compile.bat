@@ -1,3 +1,13 @@
 @echo off
-for /r %%i in (*.frag, *.vert) do %VULKAN_SDK%/Bin/glslangValidator.exe -V %%i
+rem glslangValidator names every output <stage>.spv, so each shader gets the
+rem name main.cpp loads it by
+set GLSL=%VULKAN_SDK%/Bin/glslangValidator.exe -V
+set OUT=%~dp0..\..\Assets\Shaders
+%GLSL% "%~dp0shader.vert" -o "%OUT%\Vert.spv"
+%GLSL% "%~dp0shaderInstanced.vert" -o "%OUT%\VertInstanced.spv"
+%GLSL% "%~dp0shaderQuantized.vert" -o "%OUT%\VertQuantized.spv"
+%GLSL% "%~dp0shader.frag" -o "%OUT%\fragTopDownNormalslR8G8B8A8.spv"
+%GLSL% "%~dp0shaderCull.comp" -o "%OUT%\Cull.spv"
+%GLSL% "%~dp0shaderHiZ.comp" -o "%OUT%\HiZ.spv"
+rem fragBottomUpNormalsBC5.spv is shader.frag built with the commented out BC5 getNormal
 pause
\ No newline at end of file
@@ -0,0 +1,38 @@
+#version 450
+
+layout(location = 0) in vec3 a_Pos;
+layout(location = 1) in vec2 a_UV;
+layout(location = 2) in vec3 a_Nml;
+layout(location = 3) in vec3 a_Tan;
+
+// VTX_INSTANCE at binding 1 (vulkanPipeline::s_InstanceLocation)
+layout(location = 8) in mat4 i_M2W;
+layout(location = 12) in uint i_MaterialID;
+
+layout(location = 0) out vec3 v_Pos;
+layout(location = 1) out vec2 v_UV;
+layout(location = 2) out mat3 v_TBN;
+layout(location = 5) flat out uint v_MaterialID;
+
+layout (set = 0, binding = 0) uniform u0cam
+{
+  mat4 u_W2V;// world to clip, the instance has the rest
+};
+
+void main()
+{
+  vec4 worldPos = i_M2W * vec4(a_Pos, 1.0);
+  gl_Position = u_W2V * worldPos;
+
+  // world space instead of local, every instance has its own local space so
+  // the frag uniforms (cam/light) are given in world space for this shader
+  v_Pos = worldPos.xyz;
+  v_UV = a_UV;
+
+  // instances only translate/rotate/uniformly scale, normalize takes the scale
+  mat3 M2W = mat3(i_M2W);
+  vec3 nml = normalize(M2W * a_Nml);
+  vec3 tan = normalize(M2W * a_Tan);
+  v_TBN = mat3(tan, cross(nml, tan), nml);
+  v_MaterialID = i_MaterialID;
+}
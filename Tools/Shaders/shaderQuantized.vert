@@ -0,0 +1,52 @@
+#version 450
+
+layout(location = 0) in vec4 a_Pos;// xyz snorm over mesh bounds, w bitangent sign
+layout(location = 1) in vec2 a_UV; // unorm over mesh UV bounds
+layout(location = 2) in vec2 a_Nml;// octahedral
+layout(location = 3) in vec2 a_Tan;// octahedral
+
+// VTX_INSTANCE at binding 1 (vulkanPipeline::s_InstanceLocation)
+layout(location = 8) in mat4 i_M2W;
+layout(location = 12) in uint i_MaterialID;
+
+layout (set = 0, binding = 0) uniform u0dq
+{
+  vec4 u_PosOffset;
+  vec4 u_PosScale;
+  vec4 u_UVOffsetScale;
+};
+
+layout (set = 0, binding = 1) uniform u1cam
+{
+  mat4 u_W2V;// world to clip, the instance has the rest
+};
+
+layout(location = 0) out vec3 v_Pos;
+layout(location = 1) out vec2 v_UV;
+layout(location = 2) out mat3 v_TBN;
+layout(location = 5) flat out uint v_MaterialID;
+
+vec3 octDecode(vec2 e)
+{
+  vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  float t = max(-v.z, 0.0);
+  v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+  return normalize(v);
+}
+
+void main()
+{
+  vec3 pos = u_PosOffset.xyz + a_Pos.xyz * u_PosScale.xyz;
+  vec4 worldPos = i_M2W * vec4(pos, 1.0);
+  gl_Position = u_W2V * worldPos;
+
+  v_Pos = worldPos.xyz;// world space, like shaderInstanced.vert
+  v_UV = u_UVOffsetScale.xy + a_UV * u_UVOffsetScale.zw;
+
+  // same as shader.vert, but the bitangent keeps the handedness from import
+  mat3 M2W = mat3(i_M2W);
+  vec3 nml = normalize(M2W * octDecode(a_Nml));
+  vec3 tan = normalize(M2W * octDecode(a_Tan));
+  v_TBN = mat3(tan, cross(nml, tan) * a_Pos.w, nml);
+  v_MaterialID = i_MaterialID;
+}